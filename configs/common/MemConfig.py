@@ -110,6 +110,7 @@ def config_mem(options, system):
     opt_mem_ranks = getattr(options, "mem_ranks", None)
     opt_dram_powerdown = getattr(options, "enable_dram_powerdown", None)
     opt_mem_channels_intlv = getattr(options, "mem_channels_intlv", 128)
+    opt_mem_shared_images = getattr(options, "mem_shared_images", None) or []
 
     if opt_mem_type == "HMC_2500_1x32":
         HMChost = HMC.config_hmc_host_ctrl(options, system)
@@ -160,7 +161,10 @@ def config_mem(options, system):
     # For every range (most systems will only have one), create an
     # array of controllers and set their parameters to match their
     # address mapping in the case of a DRAM
-    for r in system.mem_ranges:
+    if len(opt_mem_shared_images) > len(system.mem_ranges):
+        fatal("More shared memory images than memory ranges")
+
+    for ri, r in enumerate(system.mem_ranges):
         for i in range(nbr_mem_ctrls):
             mem_ctrl = create_mem_ctrl(cls, r, i, nbr_mem_ctrls, intlv_bits,
                                        intlv_size)
@@ -173,6 +177,10 @@ def config_mem(options, system):
             if issubclass(cls, m5.objects.DRAMCtrl):
                 mem_ctrl.enable_dram_powerdown = opt_dram_powerdown
 
+            # All the controllers of the range map the same image
+            if ri < len(opt_mem_shared_images):
+                mem_ctrl.shared_image = opt_mem_shared_images[ri]
+
             if opt_elastic_trace_en:
                 mem_ctrl.latency = '1ns'
                 print("For elastic trace, over-riding Simple Memory "
@@ -112,6 +112,10 @@ def addNoISAOptions(parser):
                        help="Enable low-power states in DRAMCtrl")
     parser.add_option("--mem-channels-intlv", type="int", default=0,
                       help="Memory channels interleave")
+    parser.add_option("--mem-shared-image", action="append", default=[],
+                      dest="mem_shared_images",
+                      help="Raw image mapped copy-on-write as the initial "
+                      "contents of a memory range, repeated for each range")
 
 
     parser.add_option("--memchecker", action="store_true")
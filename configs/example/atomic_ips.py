@@ -0,0 +1,103 @@
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+"""Measure how many instructions per host second the atomic CPU
+simulates, running a program in SE mode on a system without caches.
+
+This is meant to compare the options that speed up fast-forwarding,
+e.g.:
+
+    build/X86/gem5.opt configs/example/atomic_ips.py
+    build/X86/gem5.opt configs/example/atomic_ips.py --translation-cache
+"""
+
+from __future__ import print_function
+from __future__ import absolute_import
+
+import argparse
+import os
+import time
+
+import m5
+from m5.objects import *
+
+isa = str(m5.defines.buildEnv['TARGET_ISA']).lower()
+thispath = os.path.dirname(os.path.realpath(__file__))
+
+parser = argparse.ArgumentParser(description=__doc__)
+parser.add_argument("--cmd", default=os.path.join(thispath, '../../',
+                    'tests/test-progs/hello/bin/', isa, 'linux/hello'),
+                    help="Program to run")
+parser.add_argument("--options", default="",
+                    help="Arguments of the program, in quotes")
+parser.add_argument("--maxinsts", type=int, default=0,
+                    help="Stop after this many instructions")
+parser.add_argument("--translation-cache", action="store_true",
+                    help="Execute decoded instructions from the "
+                    "translation cache")
+parser.add_argument("--use-backdoors", action="store_true",
+                    help="Access memory through back doors")
+args = parser.parse_args()
+
+system = System()
+system.clk_domain = SrcClockDomain(clock='1GHz',
+                                   voltage_domain=VoltageDomain())
+system.mem_mode = 'atomic'
+system.mem_ranges = [AddrRange('512MB')]
+
+system.cpu = AtomicSimpleCPU(translation_cache=args.translation_cache,
+                             use_backdoors=args.use_backdoors)
+if args.maxinsts:
+    system.cpu.max_insts_any_thread = args.maxinsts
+
+system.membus = SystemXBar()
+system.cpu.icache_port = system.membus.slave
+system.cpu.dcache_port = system.membus.slave
+system.cpu.createInterruptController()
+if isa == "x86":
+    system.cpu.interrupts[0].pio = system.membus.master
+    system.cpu.interrupts[0].int_master = system.membus.slave
+    system.cpu.interrupts[0].int_slave = system.membus.master
+
+system.mem_ctrl = SimpleMemory(range=system.mem_ranges[0])
+system.mem_ctrl.port = system.membus.master
+system.system_port = system.membus.slave
+
+process = Process(cmd=[args.cmd] + args.options.split())
+system.cpu.workload = process
+system.cpu.createThreads()
+
+root = Root(full_system=False, system=system)
+m5.instantiate()
+
+start = time.time()
+exit_event = m5.simulate()
+host_seconds = time.time() - start
+
+insts = system.cpu.totalInsts()
+print("Exiting @ tick %i because %s" % (m5.curTick(), exit_event.getCause()))
+print("%i instructions in %.3f host seconds: %.0f instructions/s" %
+      (insts, host_seconds, insts / host_seconds))
@@ -267,6 +267,9 @@ if options.ruby:
             system.cpu[i].interrupts[0].int_slave = ruby_port.master
             system.cpu[i].itb.walker.port = ruby_port.slave
             system.cpu[i].dtb.walker.port = ruby_port.slave
+
+    if options.ruby_event_queues > 1:
+        sim_quantum = Ruby.partition_event_queues(options, system)
 else:
     MemClass = Simulation.setMemClass(options)
     system.membus = SystemXBar()
@@ -280,4 +283,6 @@ if options.wait_gdb:
         cpu.wait_for_remote_gdb = True
 
 root = Root(full_system = False, system = system)
+if options.ruby and options.ruby_event_queues > 1:
+    root.sim_quantum = sim_quantum
 Simulation.run(options, root, system, FutureClass)
@@ -80,6 +80,11 @@ def define_options(parser):
     parser.add_option("--recycle-latency", type="int", default=10,
                       help="Recycle latency for ruby controller input buffers")
 
+    parser.add_option("--ruby-event-queues", type="int", default=1,
+                      help="Number of event queues, simulated in parallel, "
+                           "to split the ruby system across (simple "
+                           "network and SE mode only)")
+
     protocol = buildEnv['PROTOCOL']
     exec("from . import %s" % protocol)
     eval("%s.define_options(parser)" % protocol)
@@ -129,6 +134,7 @@ def setup_memory_controllers(system, ruby, dir_cntrls, options):
                 mem_ctrl.port = crossbar.master
             else:
                 mem_ctrl.port = dir_cntrl.memory
+            mem_ctrl._dir_cntrl = dir_cntrl
 
             # Enable low-power DRAM states if option is set
             if issubclass(mem_type, DRAMCtrl):
@@ -226,6 +232,46 @@ def create_system(options, full_system, system, piobus = None, dma_ports = [],
         ruby.phys_mem = SimpleMemory(range=system.mem_ranges[0],
                                      in_addr_map=False)
 
+def partition_event_queues(options, system):
+    """ Splits the ruby system across options.ruby_event_queues event
+        queues, simulated in parallel. The routers are split in groups of
+        consecutive routers, and every controller, along with its
+        sequencer, the cpu using it and the memories behind it, is
+        simulated by the event queue of the router it is attached to.
+        The internal links of the network are then the only connections
+        between event queues, so their latency bounds the simulation
+        quantum, which is returned in ticks.
+    """
+    num_queues = options.ruby_event_queues
+    network = system.ruby.network
+
+    if options.network != "simple":
+        fatal("Only the simple network can be split across event queues")
+
+    routers = network.routers
+    for i, router in enumerate(routers):
+        router.eventq_index = i * num_queues // len(routers)
+
+    for link in network.ext_links:
+        link.ext_node.eventq_index = link.int_node.eventq_index
+
+    for i, seq in enumerate(system.ruby._cpu_ports):
+        system.cpu[i].eventq_index = seq.get_parent().eventq_index
+
+    for mem_ctrl in system.mem_ctrls:
+        mem_ctrl.eventq_index = mem_ctrl._dir_cntrl.eventq_index
+
+    crossing_latencies = [ int(link.latency) for link in network.int_links
+        if link.src_node.eventq_index != link.dst_node.eventq_index ]
+    if not crossing_latencies:
+        return 0
+
+    # The throttles deliver the messages of the internal links at the
+    # clock of the source router, which is the ruby clock.
+    m5.ticks.fixGlobalFrequency()
+    period = 1.0 / m5.util.convert.toFrequency(options.ruby_clock)
+    return m5.ticks.fromSeconds(min(crossing_latencies) * period)
+
 def create_directories(options, bootmem, ruby_system, system):
     dir_cntrl_nodes = []
     for i in range(options.num_dirs):
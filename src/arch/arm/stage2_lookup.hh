@@ -79,7 +79,7 @@ class Stage2LookUp : public BaseTLB::Translation
         functional(_functional), tranType(_tranType), stage2Te(nullptr),
         fault(NoFault), complete(false), selfDelete(false)
     {
-        req = std::make_shared<Request>();
+        req = new Request();
         req->setVirt(s1Te.pAddr(s1Req->getVaddr()), s1Req->getSize(),
                      s1Req->getFlags(), s1Req->masterId(), 0);
     }
@@ -65,7 +65,7 @@ Stage2MMU::readDataUntimed(ThreadContext *tc, Addr oVAddr, Addr descAddr,
     Fault fault;
 
     // translate to physical address using the second stage MMU
-    auto req = std::make_shared<Request>();
+    RequestPtr req = new Request();
     req->setVirt(descAddr, numBytes, flags | Request::PT_WALK, masterId, 0);
     if (isFunctional) {
         fault = stage2Tlb()->translateFunctional(req, tc, BaseTLB::Read);
@@ -111,7 +111,7 @@ Stage2MMU::Stage2Translation::Stage2Translation(Stage2MMU &_parent,
     : data(_data), numBytes(0), event(_event), parent(_parent), oVAddr(_oVAddr),
     fault(NoFault)
 {
-    req = std::make_shared<Request>();
+    req = new Request();
 }
 
 void
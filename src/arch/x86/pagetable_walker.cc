@@ -518,7 +518,7 @@ Walker::WalkerState::stepWalk(PacketPtr &write)
         //If we didn't return, we're setting up another read.
         Request::Flags flags = oldRead->req->getFlags();
         flags.set(Request::UNCACHEABLE, uncacheable);
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = new Request(
             nextRead, oldRead->getSize(), flags, walker->masterId);
         read = new Packet(request, MemCmd::ReadReq);
         read->allocate();
@@ -587,7 +587,7 @@ Walker::WalkerState::setupWalk(Addr vaddr)
     if (cr3.pcd)
         flags.set(Request::UNCACHEABLE);
 
-    RequestPtr request = std::make_shared<Request>(
+    RequestPtr request = new Request(
         topAddr, dataSize, flags, walker->masterId);
 
     read = new Packet(request, MemCmd::ReadReq);
@@ -0,0 +1,451 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/binary_trace.hh"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "base/intmath.hh"
+
+namespace Trace {
+
+const char BinaryTraceWriter::magic[8] = {
+    'g', 'e', 'm', '5', 't', 'r', 'c', 'b' };
+
+BinaryTraceWriter::Format::Format(uint32_t _id, const char *_text)
+    : id(_id), text(_text)
+{
+    // Split the conversion specifications the way cp::Print does.
+    // Widths and precisions taken from the arguments get an empty
+    // specification, as they are never formatted.
+    for (const char *p = _text; *p; ++p) {
+        if (*p != '%')
+            continue;
+        if (p[1] == '%') {
+            ++p;
+            continue;
+        }
+
+        std::string spec("%");
+        while (*++p) {
+            if (*p == '*') {
+                specs.emplace_back();
+                continue;
+            }
+            spec += *p;
+            if (!strchr("#-+ .0123456789l", *p))
+                break;
+        }
+        specs.push_back(spec);
+        if (!*p)
+            break;
+    }
+}
+
+struct BinaryTraceWriter::Thread
+{
+    const uint32_t id;
+
+    /** Ring buffer, whose size is a power of two */
+    std::vector<uint8_t> ring;
+    /** Number of bytes written to the ring buffer by the thread */
+    std::atomic<uint64_t> head;
+    /** Number of bytes moved from the ring buffer to the file */
+    std::atomic<uint64_t> tail;
+
+    Record record;
+    Record names;
+
+    /** Formats by address, checked against their text when used */
+    std::unordered_map<const char *, Format> formats;
+    std::unordered_map<std::string, uint32_t> strings;
+    uint32_t nextId = 0;
+
+    Thread(uint32_t _id, std::size_t size)
+        : id(_id), ring(size), head(0), tail(0)
+    {}
+};
+
+struct BinaryTraceWriter::Shared
+{
+    /** Protects the list of threads */
+    std::mutex threadsMutex;
+    std::vector<std::unique_ptr<Thread>> threads;
+
+    /** Serializes the draining of the ring buffers */
+    std::mutex drainMutex;
+
+    std::mutex flusherMutex;
+    std::condition_variable flusherCond;
+    std::atomic<bool> wake;
+    bool stopping = false;
+    std::thread flusher;
+
+    Shared() : wake(false) {}
+};
+
+static std::atomic<uint64_t> nextWriterSerial(1);
+
+void
+BinaryTraceWriter::Record::put(double value)
+{
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    put(bits);
+}
+
+void
+BinaryTraceWriter::Record::putBytes(const void *data, std::size_t size)
+{
+    const uint8_t *p = static_cast<const uint8_t *>(data);
+    bytes.insert(bytes.end(), p, p + size);
+}
+
+void
+BinaryTraceWriter::Record::putString(const char *s, std::size_t size)
+{
+    put((uint32_t)size);
+    putBytes(s, size);
+}
+
+void
+BinaryTraceWriter::Record::putArg(const char *s)
+{
+    put((uint8_t)ArgType::String);
+    // a null string would break the text output, don't let it break
+    // the trace
+    if (!s)
+        s = "(null)";
+    putString(s, strlen(s));
+}
+
+void
+BinaryTraceWriter::Record::putArg(const std::string &s)
+{
+    put((uint8_t)ArgType::String);
+    putString(s);
+}
+
+BinaryTraceWriter::BinaryTraceWriter(std::ostream &_stream,
+                                     std::size_t buffer_size)
+    : stream(_stream), bufferSize((std::size_t)1 << ceilLog2(
+          std::max<std::size_t>(buffer_size, 64))),
+      serial(nextWriterSerial++), shared(new Shared)
+{
+    writeHeader();
+    startFlusher();
+}
+
+BinaryTraceWriter::~BinaryTraceWriter()
+{
+    stopFlusher();
+    flush();
+}
+
+void
+BinaryTraceWriter::writeHeader()
+{
+    stream.write(magic, sizeof(magic));
+    const uint32_t file_version = htole(version);
+    stream.write((const char *)&file_version, sizeof(file_version));
+}
+
+void
+BinaryTraceWriter::startFlusher()
+{
+    shared->stopping = false;
+    shared->flusher = std::thread(&BinaryTraceWriter::flusherMain, this);
+}
+
+void
+BinaryTraceWriter::stopFlusher()
+{
+    if (!shared->flusher.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(shared->flusherMutex);
+        shared->stopping = true;
+    }
+    shared->flusherCond.notify_one();
+    shared->flusher.join();
+}
+
+BinaryTraceWriter::Thread &
+BinaryTraceWriter::thread()
+{
+    static thread_local uint64_t cached_serial = 0;
+    static thread_local Thread *cached_thread = nullptr;
+
+    if (cached_serial != serial) {
+        std::lock_guard<std::mutex> lock(shared->threadsMutex);
+        auto &threads = shared->threads;
+        threads.emplace_back(new Thread(threads.size(), bufferSize));
+        cached_thread = threads.back().get();
+        cached_serial = serial;
+    }
+    return *cached_thread;
+}
+
+void
+BinaryTraceWriter::putName(Thread &t, uint32_t id, const std::string &s)
+{
+    t.names.clear();
+    t.names.put((uint8_t)'N');
+    t.names.put(id);
+    t.names.putString(s);
+    commit(t, t.names);
+}
+
+uint32_t
+BinaryTraceWriter::stringId(Thread &t, const std::string &s)
+{
+    auto it = t.strings.find(s);
+    if (it != t.strings.end())
+        return it->second;
+
+    const uint32_t id = t.nextId++;
+    t.strings.emplace(s, id);
+    putName(t, id, s);
+    return id;
+}
+
+const BinaryTraceWriter::Format &
+BinaryTraceWriter::format(Thread &t, const char *fmt)
+{
+    auto it = t.formats.find(fmt);
+    // Format strings are nearly always literals, but one built at run
+    // time may reuse the address of another.
+    if (it != t.formats.end() && it->second.text == fmt)
+        return it->second;
+
+    if (it != t.formats.end())
+        t.formats.erase(it);
+    it = t.formats.emplace(fmt, Format(t.nextId++, fmt)).first;
+    putName(t, it->second.id, it->second.text);
+    return it->second;
+}
+
+BinaryTraceWriter::Record &
+BinaryTraceWriter::beginMessage(Thread &t, Tick when,
+                                const std::string &name,
+                                const std::string &flag, const char *fmt)
+{
+    const uint32_t flag_id = stringId(t, flag);
+    const uint32_t name_id = stringId(t, name);
+    const Format &f = format(t, fmt);
+
+    Record &record = t.record;
+    record.clear(&f);
+    record.put((uint8_t)'M');
+    record.put((uint64_t)when);
+    record.put(flag_id);
+    record.put(name_id);
+    record.put(f.id);
+    return record;
+}
+
+void
+BinaryTraceWriter::commit(Thread &t, const Record &record)
+{
+    const uint8_t *data = record.data();
+    std::size_t size = record.size();
+    const uint64_t capacity = t.ring.size();
+    uint64_t head = t.head.load(std::memory_order_relaxed);
+
+    while (size > 0) {
+        const uint64_t space =
+            capacity - (head - t.tail.load(std::memory_order_acquire));
+        if (space == 0) {
+            // the flusher is behind, wait for it
+            wakeFlusher();
+            std::this_thread::yield();
+            continue;
+        }
+
+        const uint64_t offset = head & (capacity - 1);
+        const std::size_t n = std::min<uint64_t>(
+            std::min<uint64_t>(size, space), capacity - offset);
+        memcpy(&t.ring[offset], data, n);
+        data += n;
+        size -= n;
+        head += n;
+        t.head.store(head, std::memory_order_release);
+    }
+
+    if (head - t.tail.load(std::memory_order_relaxed) > capacity / 2)
+        wakeFlusher();
+}
+
+void
+BinaryTraceWriter::wakeFlusher()
+{
+    if (!shared->wake.exchange(true))
+        shared->flusherCond.notify_one();
+}
+
+void
+BinaryTraceWriter::drain()
+{
+    std::vector<Thread *> threads;
+    {
+        std::lock_guard<std::mutex> lock(shared->threadsMutex);
+        for (auto &t : shared->threads)
+            threads.push_back(t.get());
+    }
+
+    for (Thread *t : threads) {
+        const uint64_t capacity = t->ring.size();
+        const uint64_t head = t->head.load(std::memory_order_acquire);
+        uint64_t tail = t->tail.load(std::memory_order_relaxed);
+
+        while (tail != head) {
+            const uint64_t offset = tail & (capacity - 1);
+            const uint32_t n = std::min(head - tail, capacity - offset);
+            const uint32_t header[2] = { htole(t->id), htole(n) };
+            stream.write((const char *)header, sizeof(header));
+            stream.write((const char *)&t->ring[offset], n);
+            tail += n;
+            t->tail.store(tail, std::memory_order_release);
+        }
+    }
+}
+
+void
+BinaryTraceWriter::flusherMain()
+{
+    std::unique_lock<std::mutex> lock(shared->flusherMutex);
+    while (!shared->stopping) {
+        shared->flusherCond.wait_for(lock, std::chrono::milliseconds(100),
+            [this] { return shared->stopping || shared->wake.load(); });
+        shared->wake = false;
+
+        lock.unlock();
+        {
+            std::lock_guard<std::mutex> drain_lock(shared->drainMutex);
+            drain();
+        }
+        lock.lock();
+    }
+}
+
+void
+BinaryTraceWriter::dump(Tick when, const std::string &name,
+                        const std::string &flag, const void *data, int size)
+{
+    Thread &t = thread();
+    const uint32_t flag_id = stringId(t, flag);
+    const uint32_t name_id = stringId(t, name);
+
+    Record &record = t.record;
+    record.clear();
+    record.put((uint8_t)'D');
+    record.put((uint64_t)when);
+    record.put(flag_id);
+    record.put(name_id);
+    record.put((uint32_t)size);
+    record.putBytes(data, size);
+    commit(t, record);
+}
+
+void
+BinaryTraceWriter::text(const std::string &text)
+{
+    Thread &t = thread();
+    Record &record = t.record;
+    record.clear();
+    record.put((uint8_t)'T');
+    record.putString(text);
+    commit(t, record);
+}
+
+void
+BinaryTraceWriter::flush()
+{
+    std::lock_guard<std::mutex> lock(shared->drainMutex);
+    drain();
+    stream.flush();
+}
+
+void
+BinaryTraceWriter::writeStrings()
+{
+    for (auto &t : shared->threads) {
+        std::vector<std::pair<uint32_t, const std::string *>> strings;
+        for (auto &s : t->strings)
+            strings.emplace_back(s.second, &s.first);
+        for (auto &f : t->formats)
+            strings.emplace_back(f.second.id, &f.second.text);
+        if (strings.empty())
+            continue;
+        std::sort(strings.begin(), strings.end());
+
+        Record &record = t->names;
+        record.clear();
+        for (auto &s : strings) {
+            record.put((uint8_t)'N');
+            record.put(s.first);
+            record.putString(*s.second);
+        }
+
+        const uint32_t header[2] = {
+            htole(t->id), htole((uint32_t)record.size()) };
+        stream.write((const char *)header, sizeof(header));
+        stream.write((const char *)record.data(), record.size());
+    }
+}
+
+void
+BinaryTraceWriter::prepareFork()
+{
+    stopFlusher();
+    flush();
+}
+
+void
+BinaryTraceWriter::afterFork(bool child)
+{
+    // A child whose trace file was moved to its own output directory
+    // starts it over. Its messages refer to the flags, names and
+    // formats written by the parent, so these are written again.
+    if (child && stream.tellp() == 0) {
+        std::lock_guard<std::mutex> lock(shared->drainMutex);
+        writeHeader();
+        writeStrings();
+    }
+
+    startFlusher();
+}
+
+} // namespace Trace
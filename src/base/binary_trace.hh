@@ -0,0 +1,372 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Binary trace output
+ *
+ * Rather than formatting each debug message, the binary trace writer
+ * records its tick, flag, object name and format string, and the
+ * arguments in their native form. Messages are appended to a lock
+ * free ring buffer of the thread logging them, and a background
+ * thread moves the contents of the buffers to the trace file. The
+ * text of the messages is only produced when the trace is decoded by
+ * util/tracedecode, which formats them with the same cprintf code.
+ *
+ * The file starts with an 8-byte magic string and a u32 version,
+ * followed by chunks of the byte stream of a thread: u32 thread id,
+ * u32 size, and that many bytes. The stream of each thread is a
+ * sequence of records, all integers being little endian:
+ *  - a string: 'N', u32 id, u32 length, bytes. Flags, names and
+ *    format strings are given an id the first time they are used.
+ *  - a message: 'M', u64 tick, u32 flag id, u32 name id, u32 format
+ *    id, u8 argument count, and the arguments as an ArgType byte
+ *    followed by a u64 value (a double for floating point types) or
+ *    by a u32 length and the bytes of a string or formatted argument.
+ *  - a data dump: 'D', u64 tick, u32 flag id, u32 name id, u32 size,
+ *    and the bytes of the data.
+ *  - raw text written to the trace stream: 'T', u32 length, bytes.
+ * Records may be split across chunks.
+ */
+
+#ifndef __BASE_BINARY_TRACE_HH__
+#define __BASE_BINARY_TRACE_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/types.hh"
+#include "sim/byteswap.hh"
+
+namespace Trace {
+
+class BinaryTraceWriter
+{
+  public:
+    /** Magic string at the start of binary trace files */
+    static const char magic[8];
+    static const uint32_t version = 1;
+
+    /** Type of an argument of a message */
+    enum class ArgType : uint8_t
+    {
+        Bool = 0,
+        Char = 1,
+        SignedChar = 2,
+        UnsignedChar = 3,
+        Short = 4,
+        UnsignedShort = 5,
+        Int = 6,
+        UnsignedInt = 7,
+        Long = 8,
+        UnsignedLong = 9,
+        LongLong = 10,
+        UnsignedLongLong = 11,
+        Float = 12,
+        Double = 13,
+        String = 14,
+        Pointer = 15,
+        /**
+         * Argument of another type, formatted with its conversion
+         * specification when logged.
+         */
+        Text = 16,
+    };
+
+    /** Format string, and the conversion specification of each argument */
+    struct Format
+    {
+        uint32_t id;
+        std::string text;
+        std::vector<std::string> specs;
+
+        Format(uint32_t id, const char *text);
+    };
+
+  private:
+    /** Ring buffer and string ids of a thread */
+    struct Thread;
+
+    /** Record being built by a thread */
+    class Record
+    {
+      private:
+        std::vector<uint8_t> bytes;
+
+        /** Conversion specifications of the message being recorded */
+        const Format *format = nullptr;
+        /** Index of the next argument */
+        std::size_t index = 0;
+
+        template <class T>
+        void
+        putValue(ArgType type, T value)
+        {
+            put((uint8_t)type);
+            put(value);
+        }
+
+        void putString(const char *s, std::size_t size);
+
+        /** Arguments of types that are not known to the decoder */
+        template <class T>
+        void
+        putObject(const T &arg, std::false_type is_enum)
+        {
+            // Format the argument with its own conversion
+            // specification, so that the decoder outputs it as is.
+            std::ostringstream os;
+            if (index < format->specs.size()) {
+                cp::Print print(os, format->specs[index]);
+                print.add_arg(arg);
+                print.end_args();
+            } else {
+                os << arg;
+            }
+            put((uint8_t)ArgType::Text);
+            putString(os.str());
+        }
+
+        template <class T>
+        void
+        putObject(const T &arg, std::true_type is_enum)
+        {
+            putArg(static_cast<typename std::underlying_type<T>::type>(arg));
+        }
+
+      public:
+        std::size_t size() const { return bytes.size(); }
+        const uint8_t *data() const { return bytes.data(); }
+
+        void
+        clear(const Format *fmt = nullptr)
+        {
+            bytes.clear();
+            format = fmt;
+            index = 0;
+        }
+
+        template <class T>
+        void
+        put(T value)
+        {
+            static_assert(std::is_arithmetic<T>::value, "Not a number");
+            value = htole(value);
+            const uint8_t *p = reinterpret_cast<const uint8_t *>(&value);
+            bytes.insert(bytes.end(), p, p + sizeof(value));
+        }
+
+        void put(double value);
+
+        void putBytes(const void *data, std::size_t size);
+        void putString(const std::string &s) { putString(s.data(), s.size()); }
+
+        void putArg(bool v) { putValue(ArgType::Bool, (uint64_t)v); }
+        void putArg(char v) { putValue(ArgType::Char, (uint64_t)v); }
+        void
+        putArg(signed char v)
+        {
+            putValue(ArgType::SignedChar, (uint64_t)v);
+        }
+        void
+        putArg(unsigned char v)
+        {
+            putValue(ArgType::UnsignedChar, (uint64_t)v);
+        }
+        void putArg(short v) { putValue(ArgType::Short, (uint64_t)v); }
+        void
+        putArg(unsigned short v)
+        {
+            putValue(ArgType::UnsignedShort, (uint64_t)v);
+        }
+        void putArg(int v) { putValue(ArgType::Int, (uint64_t)v); }
+        void
+        putArg(unsigned int v)
+        {
+            putValue(ArgType::UnsignedInt, (uint64_t)v);
+        }
+        void putArg(long v) { putValue(ArgType::Long, (uint64_t)v); }
+        void
+        putArg(unsigned long v)
+        {
+            putValue(ArgType::UnsignedLong, (uint64_t)v);
+        }
+        void
+        putArg(long long v)
+        {
+            putValue(ArgType::LongLong, (uint64_t)v);
+        }
+        void
+        putArg(unsigned long long v)
+        {
+            putValue(ArgType::UnsignedLongLong, (uint64_t)v);
+        }
+        void putArg(float v) { putValue(ArgType::Float, (double)v); }
+        void putArg(double v) { putValue(ArgType::Double, v); }
+        void putArg(long double v) { putValue(ArgType::Double, (double)v); }
+
+        void putArg(const char *s);
+        void putArg(char *s) { putArg((const char *)s); }
+        void putArg(const std::string &s);
+
+        template <class T>
+        void
+        putArg(T *p)
+        {
+            putValue(ArgType::Pointer, (uint64_t)(uintptr_t)p);
+        }
+
+        template <class T>
+        void
+        putArg(const T &arg)
+        {
+            putObject(arg, std::integral_constant<bool,
+                std::is_enum<T>::value &&
+                std::is_convertible<T, long long>::value>());
+        }
+
+        /** Add the next argument of a message */
+        template <class T>
+        void
+        add(const T &arg)
+        {
+            putArg(arg);
+            ++index;
+        }
+    };
+
+    std::ostream &stream;
+
+    /** Size of the ring buffer of each thread */
+    const std::size_t bufferSize;
+
+    /** Number identifying this writer in the cache of threads */
+    const uint64_t serial;
+
+    /** Threads, and the state of the background flusher */
+    struct Shared;
+    std::unique_ptr<Shared> shared;
+
+    /** Get the state of the calling thread */
+    Thread &thread();
+
+    /** Get the id of a string, writing it out if it is new */
+    uint32_t stringId(Thread &t, const std::string &s);
+
+    /** Get the format of a message, writing it out if it is new */
+    const Format &format(Thread &t, const char *fmt);
+
+    /** Start a message record */
+    Record &beginMessage(Thread &t, Tick when, const std::string &name,
+                         const std::string &flag, const char *fmt);
+
+    /** Copy the record of a thread to its ring buffer */
+    void commit(Thread &t, const Record &record);
+
+    /** Write out a string record */
+    void putName(Thread &t, uint32_t id, const std::string &s);
+
+    /** Wake up the flusher, if it is not already */
+    void wakeFlusher();
+
+    /** Move the contents of all ring buffers to the file */
+    void drain();
+
+    void flusherMain();
+
+    void startFlusher();
+    void stopFlusher();
+
+    /** Write the magic string and version at the start of the file */
+    void writeHeader();
+
+    /** Write out the strings of all threads that have been given an id */
+    void writeStrings();
+
+  public:
+    /**
+     * @param stream Stream to write the trace to, which must be
+     * opened in binary mode.
+     * @param buffer_size Size of the ring buffer of each thread, which
+     * is rounded up to a power of two.
+     */
+    BinaryTraceWriter(std::ostream &stream,
+                      std::size_t buffer_size = 1 << 20);
+    ~BinaryTraceWriter();
+
+    /** Record a message */
+    template <typename ...Args>
+    void
+    message(Tick when, const std::string &name, const std::string &flag,
+            const char *fmt, const Args &...args)
+    {
+        Thread &t = thread();
+        Record &record = beginMessage(t, when, name, flag, fmt);
+        record.put((uint8_t)sizeof...(Args));
+        // expand the arguments in order
+        int expand[] = { 0, (record.add(args), 0)... };
+        (void)expand;
+        commit(t, record);
+    }
+
+    /** Record a block of data */
+    void dump(Tick when, const std::string &name, const std::string &flag,
+              const void *data, int size);
+
+    /** Record raw text */
+    void text(const std::string &text);
+
+    /** Write out everything that has been recorded so far */
+    void flush();
+
+    /**
+     * Write out everything recorded so far and stop the background
+     * thread, which would not exist in a forked copy of the simulator.
+     * Nothing may be recorded until afterFork() is called.
+     */
+    void prepareFork();
+
+    /**
+     * Start the background thread again after forking. In the child,
+     * if the trace file has been moved to a new output directory, the
+     * file starts over with its header and the strings recorded so far.
+     *
+     * @param child Whether this is the child process.
+     */
+    void afterFork(bool child);
+};
+
+} // namespace Trace
+
+#endif // __BASE_BINARY_TRACE_HH__
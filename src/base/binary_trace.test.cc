@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+
+#include "base/binary_trace.hh"
+
+using Trace::BinaryTraceWriter;
+
+TEST(BinaryTraceTest, FormatSpecs)
+{
+    BinaryTraceWriter::Format fmt(3, "%d%% %#010x %-5s|%*d %.*f %lld\n");
+    EXPECT_EQ(3, fmt.id);
+    std::vector<std::string> specs = {
+        "%d", "%#010x", "%-5s", "", "%d", "", "%.f", "%lld" };
+    EXPECT_EQ(specs, fmt.specs);
+
+    BinaryTraceWriter::Format none(0, "no conversions %%\n");
+    EXPECT_TRUE(none.specs.empty());
+}
+
+struct Point
+{
+    int x, y;
+};
+
+std::ostream &
+operator<<(std::ostream &os, const Point &p)
+{
+    return os << p.x << "," << p.y;
+}
+
+TEST(BinaryTraceTest, Message)
+{
+    std::stringstream stream;
+    {
+        BinaryTraceWriter writer(stream);
+        writer.message(10, "system.cpu", "Exec", "%d %8s\n", -2, Point{1, 2});
+    }
+    const std::string file = stream.str();
+
+    ASSERT_GT(file.size(), sizeof(BinaryTraceWriter::magic) + 4);
+    EXPECT_EQ(0, memcmp(file.data(), BinaryTraceWriter::magic,
+                        sizeof(BinaryTraceWriter::magic)));
+    EXPECT_NE(std::string::npos, file.find("system.cpu"));
+    EXPECT_NE(std::string::npos, file.find("%d %8s\n"));
+
+    // Arguments of other types than numbers and strings are formatted
+    // with their conversion when logged.
+    const char text[] = { (char)BinaryTraceWriter::ArgType::Text,
+                          8, 0, 0, 0 };
+    const std::string::size_type pos =
+        file.find(std::string(text, sizeof(text)) + "     1,2");
+    EXPECT_NE(std::string::npos, pos);
+
+    // -2 is stored as an int, as a 64-bit value
+    const char value[] = { (char)BinaryTraceWriter::ArgType::Int,
+                           (char)0xfe, (char)0xff, (char)0xff, (char)0xff,
+                           (char)0xff, (char)0xff, (char)0xff, (char)0xff };
+    EXPECT_NE(std::string::npos,
+              file.find(std::string(value, sizeof(value))));
+}
+
+TEST(BinaryTraceTest, Fork)
+{
+    std::stringstream stream;
+    BinaryTraceWriter writer(stream, 64);
+    writer.message(10, "system.cpu", "Exec", "%d\n", 1);
+    writer.prepareFork();
+    EXPECT_NE(std::string::npos, stream.str().find("system.cpu"));
+
+    // The trace file of the child is moved to its output directory
+    stream.str("");
+    writer.afterFork(true);
+
+    // Much more than the ring buffer holds, so the flusher must run
+    for (int i = 0; i < 1000; i++)
+        writer.message(20 + i, "system.cpu", "Exec", "%d\n", i);
+    writer.flush();
+    const std::string file = stream.str();
+
+    // The file starts over, with the strings recorded by the parent
+    ASSERT_GT(file.size(), sizeof(BinaryTraceWriter::magic) + 4);
+    EXPECT_EQ(0, memcmp(file.data(), BinaryTraceWriter::magic,
+                        sizeof(BinaryTraceWriter::magic)));
+    EXPECT_NE(std::string::npos, file.find("system.cpu"));
+    EXPECT_NE(std::string::npos, file.find("Exec"));
+    EXPECT_NE(std::string::npos, file.find("%d\n"));
+}
@@ -0,0 +1,237 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_FLAT_HASH_MAP_HH__
+#define __BASE_FLAT_HASH_MAP_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
+#include <vector>
+
+/**
+ * Hash map storing its entries in a single array, using open
+ * addressing with linear probing.
+ *
+ * Looking up a key touches a few adjacent entries of the array
+ * rather than following the chain of nodes of a bucket, and
+ * inserting or erasing an entry never allocates memory unless the
+ * map grows. Erased entries are filled by shifting back the entries
+ * that follow them, so that lookups never have to skip deleted
+ * entries.
+ *
+ * Unlike std::unordered_map, inserting or erasing an entry may move
+ * the other entries, so pointers to values are only valid until the
+ * map is next modified. Users needing stable pointers should store
+ * the values elsewhere and map the keys to their location.
+ */
+template <class Key, class Value, class Hash = std::hash<Key>>
+class FlatHashMap
+{
+  private:
+    struct Slot
+    {
+        Key key;
+        Value value;
+        bool used = false;
+    };
+
+    std::vector<Slot> slots;
+
+    /** Number of entries in the map */
+    std::size_t _size = 0;
+
+    /** Number of bits of the index of a slot */
+    unsigned indexBits = 0;
+
+    Hash hasher;
+
+    /**
+     * Slot an entry ideally goes into. The hash is scrambled
+     * (Fibonacci hashing) since std::hash is the identity for
+     * integers, and addresses would otherwise all fall into the
+     * slots of aligned indices.
+     */
+    std::size_t
+    home(const Key &key) const
+    {
+        const uint64_t hash = hasher(key) * 0x9e3779b97f4a7c15ULL;
+        return indexBits ? hash >> (64 - indexBits) : 0;
+    }
+
+    std::size_t mask() const { return slots.size() - 1; }
+
+    /** Find the slot holding a key, or the empty slot it would go into */
+    std::size_t
+    probe(const Key &key) const
+    {
+        std::size_t i = home(key);
+        while (slots[i].used && !(slots[i].key == key))
+            i = (i + 1) & mask();
+        return i;
+    }
+
+    void
+    grow()
+    {
+        std::vector<Slot> old(slots.size() ? slots.size() * 2 : 8);
+        old.swap(slots);
+        indexBits = 0;
+        while ((std::size_t(1) << indexBits) < slots.size())
+            ++indexBits;
+
+        for (auto &slot : old) {
+            if (slot.used) {
+                Slot &dest = slots[probe(slot.key)];
+                dest.key = std::move(slot.key);
+                dest.value = std::move(slot.value);
+                dest.used = true;
+            }
+        }
+    }
+
+  public:
+    FlatHashMap() { grow(); }
+
+    /**
+     * Make room for a number of entries, so that the map does not
+     * have to grow until it holds more of them.
+     */
+    void
+    reserve(std::size_t count)
+    {
+        // the map is kept at most half full
+        while (slots.size() < count * 2)
+            grow();
+    }
+
+    std::size_t size() const { return _size; }
+    bool empty() const { return _size == 0; }
+
+    /**
+     * Find the value of a key.
+     *
+     * @return Pointer to the value, or nullptr if the key is not in
+     * the map.
+     */
+    Value *
+    find(const Key &key)
+    {
+        Slot &slot = slots[probe(key)];
+        return slot.used ? &slot.value : nullptr;
+    }
+
+    const Value *
+    find(const Key &key) const
+    {
+        const Slot &slot = slots[probe(key)];
+        return slot.used ? &slot.value : nullptr;
+    }
+
+    std::size_t count(const Key &key) const { return find(key) ? 1 : 0; }
+
+    /**
+     * Get the value of a key, inserting a default constructed value
+     * if the key is not in the map.
+     */
+    Value &
+    operator[](const Key &key)
+    {
+        std::size_t i = probe(key);
+        if (slots[i].used)
+            return slots[i].value;
+
+        if ((_size + 1) * 2 > slots.size()) {
+            grow();
+            i = probe(key);
+        }
+        slots[i].key = key;
+        slots[i].value = Value();
+        slots[i].used = true;
+        ++_size;
+        return slots[i].value;
+    }
+
+    /**
+     * Remove a key from the map.
+     *
+     * @return Number of entries removed.
+     */
+    std::size_t
+    erase(const Key &key)
+    {
+        std::size_t i = probe(key);
+        if (!slots[i].used)
+            return 0;
+
+        // Move back the entries following the erased one, as long as
+        // this does not take them before their home slot.
+        for (std::size_t j = (i + 1) & mask(); slots[j].used;
+             j = (j + 1) & mask()) {
+            const std::size_t h = home(slots[j].key);
+            if (((j - h) & mask()) >= ((j - i) & mask())) {
+                slots[i].key = std::move(slots[j].key);
+                slots[i].value = std::move(slots[j].value);
+                i = j;
+            }
+        }
+
+        // release whatever the value holds
+        slots[i].value = Value();
+        slots[i].used = false;
+        --_size;
+        return 1;
+    }
+
+    void
+    clear()
+    {
+        for (auto &slot : slots) {
+            if (slot.used) {
+                slot.value = Value();
+                slot.used = false;
+            }
+        }
+        _size = 0;
+    }
+
+    /** Call a function on all the keys and values, in no given order */
+    template <class F>
+    void
+    forEach(F func) const
+    {
+        for (const auto &slot : slots) {
+            if (slot.used)
+                func(slot.key, slot.value);
+        }
+    }
+};
+
+#endif // __BASE_FLAT_HASH_MAP_HH__
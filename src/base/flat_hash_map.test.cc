@@ -0,0 +1,125 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "base/flat_hash_map.hh"
+
+TEST(FlatHashMapTest, InsertFindErase)
+{
+    FlatHashMap<uint64_t, int> map;
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(nullptr, map.find(0x40));
+
+    map[0x40] = 1;
+    map[0x80] = 2;
+    EXPECT_EQ(2, map.size());
+    ASSERT_NE(nullptr, map.find(0x40));
+    EXPECT_EQ(1, *map.find(0x40));
+    EXPECT_EQ(2, map[0x80]);
+    EXPECT_EQ(1, map.count(0x80));
+
+    EXPECT_EQ(1, map.erase(0x40));
+    EXPECT_EQ(0, map.erase(0x40));
+    EXPECT_EQ(nullptr, map.find(0x40));
+    EXPECT_EQ(2, *map.find(0x80));
+    EXPECT_EQ(1, map.size());
+
+    // operator[] inserts default constructed values
+    EXPECT_EQ(0, map[0xc0]);
+    EXPECT_EQ(2, map.size());
+
+    map.clear();
+    EXPECT_TRUE(map.empty());
+    EXPECT_EQ(nullptr, map.find(0x80));
+}
+
+/** Keys that all want the same slot, which exercises the probing */
+struct CollidingHash
+{
+    std::size_t operator()(uint64_t key) const { return 0; }
+};
+
+TEST(FlatHashMapTest, Collisions)
+{
+    FlatHashMap<uint64_t, uint64_t, CollidingHash> map;
+    for (uint64_t i = 0; i < 6; ++i)
+        map[i] = i * 10;
+
+    // erasing from the middle of the run must keep the rest reachable
+    map.erase(2);
+    map.erase(0);
+    for (uint64_t i = 0; i < 6; ++i) {
+        if (i == 0 || i == 2) {
+            EXPECT_EQ(nullptr, map.find(i));
+        } else {
+            ASSERT_NE(nullptr, map.find(i));
+            EXPECT_EQ(i * 10, *map.find(i));
+        }
+    }
+}
+
+TEST(FlatHashMapTest, MatchesUnorderedMap)
+{
+    FlatHashMap<uint64_t, uint64_t> map;
+    std::unordered_map<uint64_t, uint64_t> ref;
+    std::mt19937_64 rng(0);
+
+    for (int i = 0; i < 200000; ++i) {
+        // a small key space so that keys are often present
+        const uint64_t key = (rng() % 4096) << 6;
+        switch (rng() % 3) {
+          case 0:
+            map[key] = ref[key] = rng();
+            break;
+          case 1:
+            EXPECT_EQ(ref.erase(key), map.erase(key));
+            break;
+          default:
+            auto it = ref.find(key);
+            const uint64_t *value = map.find(key);
+            ASSERT_EQ(it != ref.end(), value != nullptr);
+            if (value) {
+                EXPECT_EQ(it->second, *value);
+            }
+            break;
+        }
+        ASSERT_EQ(ref.size(), map.size());
+    }
+
+    std::size_t count = 0;
+    map.forEach([&](uint64_t key, uint64_t value) {
+        EXPECT_EQ(ref.at(key), value);
+        ++count;
+    });
+    EXPECT_EQ(ref.size(), count);
+}
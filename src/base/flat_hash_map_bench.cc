@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * FlatHashMap microbenchmark, comparing the lookup throughput with
+ * std::unordered_map for cache line addresses, as used by the Ruby
+ * caches and TBE tables. Half of the lookups miss. Both maps must find
+ * the same keys.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "base/flat_hash_map.hh"
+
+using namespace std;
+
+template <class Map, class Find>
+double
+lookupsPerSecond(Map &map, const vector<uint64_t> &keys, Find find,
+                 uint64_t &found)
+{
+    const int rounds = 16;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; ++r) {
+        for (auto key : keys)
+            found += find(map, key);
+    }
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+    return rounds * keys.size() / elapsed.count();
+}
+
+int
+main()
+{
+    bool match = true;
+
+    for (size_t entries : { 256, 16384, 262144 }) {
+        FlatHashMap<uint64_t, int> flat;
+        unordered_map<uint64_t, int> ref;
+        flat.reserve(entries);
+        ref.reserve(entries);
+
+        mt19937_64 rng(entries);
+        vector<uint64_t> keys;
+        for (size_t i = 0; i < entries; ++i) {
+            const uint64_t line = (rng() % (1ULL << 34)) << 6;
+            flat[line] = ref[line] = i;
+            keys.push_back(line);
+            keys.push_back(line ^ (1ULL << 40));
+        }
+        shuffle(keys.begin(), keys.end(), rng);
+
+        uint64_t flat_found = 0, ref_found = 0;
+        const double flat_rate = lookupsPerSecond(flat, keys,
+            [](const FlatHashMap<uint64_t, int> &m, uint64_t k) {
+                return m.find(k) != nullptr;
+            }, flat_found);
+        const double ref_rate = lookupsPerSecond(ref, keys,
+            [](const unordered_map<uint64_t, int> &m, uint64_t k) {
+                return m.find(k) != m.end();
+            }, ref_found);
+
+        cprintf("%6d entries: flat %.0f lookups/s, "
+                "unordered_map %.0f lookups/s (%.2fx)%s\n",
+                entries, flat_rate, ref_rate, flat_rate / ref_rate,
+                flat_found == ref_found ? "" : ", LOOKUP MISMATCH");
+        match = match && flat_found == ref_found;
+    }
+
+    return match ? 0 : 1;
+}
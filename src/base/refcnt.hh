@@ -41,6 +41,8 @@
 #ifndef __BASE_REFCNT_HH__
 #define __BASE_REFCNT_HH__
 
+#include <cstddef>
+#include <functional>
 #include <type_traits>
 
 /**
@@ -284,4 +286,39 @@ template<class T>
 inline bool operator!=(const T *l, const RefCountingPtr<T> &r)
 { return l != r.get(); }
 
+/// Check if a reference counting pointer is empty
+template<class T>
+inline bool operator==(const RefCountingPtr<T> &l, std::nullptr_t)
+{ return !l; }
+
+/// Check if a reference counting pointer is empty
+template<class T>
+inline bool operator==(std::nullptr_t, const RefCountingPtr<T> &r)
+{ return !r; }
+
+/// Check if a reference counting pointer is non-empty
+template<class T>
+inline bool operator!=(const RefCountingPtr<T> &l, std::nullptr_t)
+{ return (bool)l; }
+
+/// Check if a reference counting pointer is non-empty
+template<class T>
+inline bool operator!=(std::nullptr_t, const RefCountingPtr<T> &r)
+{ return (bool)r; }
+
+namespace std
+{
+    /// Hash reference counting pointers on the object they point to,
+    /// so that they can be used as keys of unordered containers.
+    template<class T>
+    struct hash<RefCountingPtr<T>>
+    {
+        size_t
+        operator()(const RefCountingPtr<T> &ptr) const
+        {
+            return hash<T *>()(ptr.get());
+        }
+    };
+}
+
 #endif // __BASE_REFCNT_HH__
@@ -171,3 +171,27 @@ TEST(RefcntTest, EqualityOperators)
     EXPECT_TRUE(equalTestAPtr != equalTestB);
     EXPECT_TRUE(equalTestAPtr != equalTestBPtr);
 }
+
+TEST(RefcntTest, NullptrComparison)
+{
+    // Test comparing to nullptr in both orders.
+    Ptr nullPtr;
+    Ptr nonNullPtr = new TestRC();
+    EXPECT_TRUE(nullPtr == nullptr);
+    EXPECT_TRUE(nullptr == nullPtr);
+    EXPECT_FALSE(nonNullPtr == nullptr);
+    EXPECT_TRUE(nonNullPtr != nullptr);
+    EXPECT_TRUE(nullptr != nonNullPtr);
+    EXPECT_FALSE(nullPtr != nullptr);
+}
+
+TEST(RefcntTest, Hash)
+{
+    // Test that pointers hash on the object they point to.
+    TestRC *hashTest = new TestRC();
+    Ptr hashTestPtr = hashTest;
+    Ptr hashTestPtr2 = hashTest;
+    std::hash<Ptr> hasher;
+    EXPECT_EQ(hasher(hashTestPtr), hasher(hashTestPtr2));
+    EXPECT_EQ(hasher(hashTestPtr), std::hash<TestRC *>()(hashTest));
+}
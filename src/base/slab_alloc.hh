@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_SLAB_ALLOC_HH__
+#define __BASE_SLAB_ALLOC_HH__
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "base/logging.hh"
+
+/**
+ * @file base/slab_alloc.hh
+ *
+ * Allocator of fixed-size memory blocks for objects that are created
+ * and destroyed at a high rate.
+ */
+
+/**
+ * Per-thread allocator of fixed-size blocks.
+ *
+ * Blocks are carved out of larger slabs obtained from the system
+ * allocator and recycled through an intrusive free list, so
+ * allocating and releasing a block only takes a couple of loads and
+ * stores, without any lock or atomic operation. Every thread has its
+ * own free list: a block released by a thread other than the one
+ * that allocated it simply joins the free list of the releasing
+ * thread. Slabs are never returned to the system.
+ *
+ * In debug builds, free blocks are filled with a poison pattern which
+ * is checked when they are handed out again, so that writes through
+ * dangling pointers are caught, and reads of uninitialized memory
+ * return an easily recognizable value.
+ *
+ * The Tag parameter is only used to give every user of the
+ * allocator its own free lists and counters, e.g.:
+ * @code
+ * typedef SlabAllocator<Foo, sizeof(Foo)> FooAllocator;
+ * void *Foo::operator new(size_t size) { return FooAllocator::allocate(); }
+ * @endcode
+ */
+template <class Tag, std::size_t BlockSize>
+class SlabAllocator
+{
+  private:
+    union Block
+    {
+        Block *next;
+        typename std::aligned_storage<
+            BlockSize, alignof(std::max_align_t)>::type data;
+    };
+
+    /** Number of blocks requested from the system at once */
+    static constexpr std::size_t blocksPerSlab =
+        sizeof(Block) < 64 * 1024 ? 64 * 1024 / sizeof(Block) : 1;
+
+#ifdef DEBUG
+    /** Byte pattern filling free blocks */
+    static constexpr uint8_t poison = 0xa5;
+
+    static void
+    poisonBlock(Block *block)
+    {
+        std::memset(block, poison, sizeof(Block));
+    }
+
+    static void
+    checkPoison(const Block *block)
+    {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t *>(block);
+        for (std::size_t i = sizeof(Block *); i < sizeof(Block); ++i) {
+            panic_if(bytes[i] != poison,
+                     "Block %p written to after having been released.",
+                     block);
+        }
+    }
+#endif
+
+    /** Free list and counters of a thread */
+    struct ThreadCache
+    {
+        Block *freeList = nullptr;
+        uint64_t allocated = 0;
+        uint64_t released = 0;
+        uint64_t slabs = 0;
+    };
+
+    static std::mutex &
+    registryLock()
+    {
+        static std::mutex lock;
+        return lock;
+    }
+
+    /** Caches of all the threads that ever used the allocator */
+    static std::vector<ThreadCache *> &
+    registry()
+    {
+        static std::vector<ThreadCache *> caches;
+        return caches;
+    }
+
+    static ThreadCache &
+    threadCache()
+    {
+        // The caches are deliberately never freed, so that blocks and
+        // counters outlive the threads that used them.
+        static thread_local ThreadCache *cache = nullptr;
+        if (!cache) {
+            cache = new ThreadCache;
+            std::lock_guard<std::mutex> lock(registryLock());
+            registry().push_back(cache);
+        }
+        return *cache;
+    }
+
+    static void
+    refill(ThreadCache &cache, std::size_t blocks = blocksPerSlab)
+    {
+        Block *slab = static_cast<Block *>(
+            ::operator new(blocks * sizeof(Block)));
+
+        // Link the blocks backwards so that they are handed out in
+        // address order.
+        for (std::size_t i = blocks; i > 0; --i) {
+#ifdef DEBUG
+            poisonBlock(&slab[i - 1]);
+#endif
+            slab[i - 1].next = cache.freeList;
+            cache.freeList = &slab[i - 1];
+        }
+        ++cache.slabs;
+    }
+
+    template <class F>
+    static uint64_t
+    sum(F field)
+    {
+        std::lock_guard<std::mutex> lock(registryLock());
+        uint64_t total = 0;
+        for (auto cache : registry())
+            total += cache->*field;
+        return total;
+    }
+
+  public:
+    /** Size of the blocks handed out by the allocator */
+    static constexpr std::size_t blockSize = sizeof(Block);
+
+    /** Get a block of memory from the current thread's free list */
+    static void *
+    allocate()
+    {
+        ThreadCache &cache = threadCache();
+        if (!cache.freeList)
+            refill(cache);
+
+        Block *block = cache.freeList;
+        cache.freeList = block->next;
+        ++cache.allocated;
+#ifdef DEBUG
+        checkPoison(block);
+        std::memset(&block->next, poison, sizeof(block->next));
+#endif
+        return block;
+    }
+
+    /** Return a block of memory to the current thread's free list */
+    static void
+    release(void *ptr)
+    {
+        if (!ptr)
+            return;
+
+        ThreadCache &cache = threadCache();
+        Block *block = static_cast<Block *>(ptr);
+#ifdef DEBUG
+        poisonBlock(block);
+#endif
+        block->next = cache.freeList;
+        cache.freeList = block;
+        ++cache.released;
+    }
+
+    /**
+     * Add a number of blocks to the current thread's free list, getting
+     * them from the system in a single slab. This lets users which know
+     * how many objects they keep alive at once get them all up front,
+     * from contiguous memory. Reservations add up, so that several
+     * users sharing a thread each get their own blocks.
+     */
+    static void
+    reserve(std::size_t count)
+    {
+        if (count)
+            refill(threadCache(), count);
+    }
+
+    /**
+     * Statistics summed over all threads. They are meant to be read
+     * when the threads are synchronized, e.g. when dumping stats.
+     * @{
+     */
+    /** Number of blocks handed out since the start of the simulation */
+    static uint64_t allocated() { return sum(&ThreadCache::allocated); }
+    /** Number of blocks in use */
+    static uint64_t
+    outstanding()
+    {
+        return allocated() - sum(&ThreadCache::released);
+    }
+    /** Number of allocations made from the system allocator */
+    static uint64_t slabs() { return sum(&ThreadCache::slabs); }
+    /** @} */
+};
+
+template <class Tag, std::size_t BlockSize>
+constexpr std::size_t SlabAllocator<Tag, BlockSize>::blocksPerSlab;
+
+template <class Tag, std::size_t BlockSize>
+constexpr std::size_t SlabAllocator<Tag, BlockSize>::blockSize;
+
+#ifdef DEBUG
+template <class Tag, std::size_t BlockSize>
+constexpr uint8_t SlabAllocator<Tag, BlockSize>::poison;
+#endif
+
+#endif // __BASE_SLAB_ALLOC_HH__
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "base/slab_alloc.hh"
+
+namespace {
+
+struct SmallTag {};
+typedef SlabAllocator<SmallTag, 24> SmallAllocator;
+
+struct ThreadTag {};
+typedef SlabAllocator<ThreadTag, 64> ThreadAllocator;
+
+} // anonymous namespace
+
+TEST(SlabAllocTest, BlockSize)
+{
+    // Blocks hold at least the requested size and keep the alignment
+    // of the system allocator.
+    EXPECT_GE(SmallAllocator::blockSize, 24);
+    EXPECT_EQ(0, SmallAllocator::blockSize % alignof(std::max_align_t));
+}
+
+TEST(SlabAllocTest, AllocateRelease)
+{
+    const uint64_t allocated = SmallAllocator::allocated();
+    const uint64_t outstanding = SmallAllocator::outstanding();
+
+    std::set<void *> blocks;
+    for (int i = 0; i < 100; ++i) {
+        void *block = SmallAllocator::allocate();
+        EXPECT_EQ(0, (uintptr_t)block % alignof(std::max_align_t));
+        EXPECT_TRUE(blocks.insert(block).second);
+    }
+    EXPECT_EQ(allocated + 100, SmallAllocator::allocated());
+    EXPECT_EQ(outstanding + 100, SmallAllocator::outstanding());
+
+    for (auto block : blocks)
+        SmallAllocator::release(block);
+    EXPECT_EQ(allocated + 100, SmallAllocator::allocated());
+    EXPECT_EQ(outstanding, SmallAllocator::outstanding());
+}
+
+TEST(SlabAllocTest, Reuse)
+{
+    // The last released block is the first to be handed out again,
+    // without going back to the system allocator.
+    void *first = SmallAllocator::allocate();
+    SmallAllocator::release(first);
+    const uint64_t slabs = SmallAllocator::slabs();
+    void *second = SmallAllocator::allocate();
+    EXPECT_EQ(first, second);
+    EXPECT_EQ(slabs, SmallAllocator::slabs());
+    SmallAllocator::release(second);
+}
+
+TEST(SlabAllocTest, Reserve)
+{
+    // Reserving blocks takes a single slab, after which the reserved
+    // blocks are handed out without touching the system allocator.
+    const uint64_t slabs = SmallAllocator::slabs();
+    SmallAllocator::reserve(100000);
+    EXPECT_EQ(slabs + 1, SmallAllocator::slabs());
+
+    std::vector<void *> blocks;
+    for (int i = 0; i < 100000; ++i)
+        blocks.push_back(SmallAllocator::allocate());
+    EXPECT_EQ(slabs + 1, SmallAllocator::slabs());
+    for (auto block : blocks)
+        SmallAllocator::release(block);
+
+    // Reservations add up, even if there are enough free blocks.
+    SmallAllocator::reserve(100);
+    EXPECT_EQ(slabs + 2, SmallAllocator::slabs());
+    SmallAllocator::reserve(0);
+    EXPECT_EQ(slabs + 2, SmallAllocator::slabs());
+}
+
+TEST(SlabAllocTest, ReleaseNull)
+{
+    const uint64_t outstanding = SmallAllocator::outstanding();
+    SmallAllocator::release(nullptr);
+    EXPECT_EQ(outstanding, SmallAllocator::outstanding());
+}
+
+TEST(SlabAllocTest, Threads)
+{
+    // Every thread has its own free list, and the counters are summed
+    // over all the threads.
+    std::vector<void *> blocks[2];
+    std::thread threads[2];
+    for (int t = 0; t < 2; ++t) {
+        threads[t] = std::thread([&blocks, t]() {
+            for (int i = 0; i < 1000; ++i)
+                blocks[t].push_back(ThreadAllocator::allocate());
+        });
+    }
+    for (auto &thread : threads)
+        thread.join();
+
+    EXPECT_EQ(2000, ThreadAllocator::allocated());
+    EXPECT_EQ(2000, ThreadAllocator::outstanding());
+    EXPECT_LE(2, ThreadAllocator::slabs());
+
+    std::set<void *> unique(blocks[0].begin(), blocks[0].end());
+    unique.insert(blocks[1].begin(), blocks[1].end());
+    EXPECT_EQ(2000, unique.size());
+
+    // Blocks can be released by another thread than the one that
+    // allocated them.
+    for (auto &b : blocks) {
+        for (auto block : b)
+            ThreadAllocator::release(block);
+    }
+    EXPECT_EQ(0, ThreadAllocator::outstanding());
+}
@@ -0,0 +1,608 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/async.hh"
+
+#include <pthread.h>
+
+#include <set>
+#include <unordered_map>
+
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/core.hh"
+#include "sim/eventq.hh"
+
+namespace Stats {
+
+/**
+ * Values of a stat taken by a dump. The values are read once, which
+ * also evaluates formulas, so that the output visiting the dump in the
+ * background never touches the simulated objects.
+ */
+struct SnapshotValues
+{
+    bool isZero;
+    /** Whether the prerequisite of the stat, if any, is zero */
+    bool prereqZero;
+
+    virtual ~SnapshotValues() {}
+};
+
+/** Copy of a prerequisite, of which only zero() is of interest */
+class PrereqSnapshot : public Info
+{
+  public:
+    bool isZero = false;
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return isZero; }
+    void visit(Output &visitor) override {}
+};
+
+/**
+ * Copy of a stat, which the output visits in the background. The name,
+ * description and other attributes of the stat are copied the first
+ * time it is dumped, and the values taken by every dump are loaded into
+ * the copy just before it is visited.
+ */
+class StatSnapshot
+{
+  public:
+    virtual ~StatSnapshot() {}
+
+    /** Get the copy as a stat */
+    virtual Info &info() = 0;
+
+    /** Make the values taken by a dump those of the copy */
+    virtual void load(SnapshotValues &values) = 0;
+};
+
+namespace {
+
+template <class Base, class V>
+class SnapshotBase : public Base, public StatSnapshot
+{
+  protected:
+    bool isZero = false;
+    /** Copy of the prerequisite of the stat, if any */
+    PrereqSnapshot *prereqSnapshot = nullptr;
+
+    virtual void loadValues(V &values) = 0;
+
+  public:
+    typedef V ValuesType;
+
+    void
+    setPrereq(PrereqSnapshot *prereq)
+    {
+        this->prereq = prereq;
+        prereqSnapshot = prereq;
+    }
+
+    Info &info() override { return *this; }
+
+    void
+    load(SnapshotValues &values) override
+    {
+        isZero = values.isZero;
+        if (prereqSnapshot)
+            prereqSnapshot->isZero = values.prereqZero;
+        loadValues(static_cast<V &>(values));
+    }
+
+    bool check() const override { return true; }
+    void prepare() override {}
+    void reset() override {}
+    bool zero() const override { return isZero; }
+    void visit(Output &visitor) override { visitor.visit(*this); }
+};
+
+struct ScalarValues : public SnapshotValues
+{
+    Counter value;
+    Result result;
+    Result total;
+};
+
+class ScalarSnapshot : public SnapshotBase<ScalarInfo, ScalarValues>
+{
+  protected:
+    ScalarValues values;
+
+    void loadValues(ScalarValues &v) override { values = std::move(v); }
+
+  public:
+    ScalarSnapshot(const ScalarInfo &info) {}
+
+    static void
+    take(const ScalarInfo &info, ScalarValues &v)
+    {
+        v.value = info.value();
+        v.result = info.result();
+        v.total = info.total();
+    }
+
+    Counter value() const override { return values.value; }
+    Result result() const override { return values.result; }
+    Result total() const override { return values.total; }
+};
+
+struct VectorValues : public SnapshotValues
+{
+    size_type size;
+    VCounter value;
+    VResult result;
+    Result total;
+    /** Text of a formula */
+    std::string str;
+};
+
+template <class Base>
+class VectorSnapshotBase : public SnapshotBase<Base, VectorValues>
+{
+  protected:
+    VectorValues values;
+
+    void loadValues(VectorValues &v) override { values = std::move(v); }
+
+  public:
+    VectorSnapshotBase(const Base &info)
+    {
+        this->subnames = info.subnames;
+        this->subdescs = info.subdescs;
+    }
+
+    static void
+    take(const Base &info, VectorValues &v)
+    {
+        v.size = info.size();
+        v.value = info.value();
+        v.result = info.result();
+        v.total = info.total();
+    }
+
+    size_type size() const override { return values.size; }
+    const VCounter &value() const override { return values.value; }
+    const VResult &result() const override { return values.result; }
+    Result total() const override { return values.total; }
+};
+
+typedef VectorSnapshotBase<VectorInfo> VectorSnapshot;
+
+class FormulaSnapshot : public VectorSnapshotBase<FormulaInfo>
+{
+  public:
+    FormulaSnapshot(const FormulaInfo &info)
+        : VectorSnapshotBase<FormulaInfo>(info)
+    {}
+
+    static void
+    take(const FormulaInfo &info, VectorValues &v)
+    {
+        VectorSnapshotBase<FormulaInfo>::take(info, v);
+        v.str = info.str();
+    }
+
+    std::string str() const override { return values.str; }
+};
+
+struct DistValues : public SnapshotValues
+{
+    DistData data;
+};
+
+class DistSnapshot : public SnapshotBase<DistInfo, DistValues>
+{
+  protected:
+    void loadValues(DistValues &v) override { data = std::move(v.data); }
+
+  public:
+    DistSnapshot(const DistInfo &info) {}
+
+    static void
+    take(const DistInfo &info, DistValues &v)
+    {
+        v.data = info.data;
+    }
+};
+
+struct VectorDistValues : public SnapshotValues
+{
+    size_type size;
+    std::vector<DistData> data;
+};
+
+class VectorDistSnapshot
+    : public SnapshotBase<VectorDistInfo, VectorDistValues>
+{
+  protected:
+    size_type _size = 0;
+
+    void
+    loadValues(VectorDistValues &v) override
+    {
+        _size = v.size;
+        data = std::move(v.data);
+    }
+
+  public:
+    VectorDistSnapshot(const VectorDistInfo &info)
+    {
+        subnames = info.subnames;
+        subdescs = info.subdescs;
+    }
+
+    static void
+    take(const VectorDistInfo &info, VectorDistValues &v)
+    {
+        v.size = info.size();
+        v.data = info.data;
+    }
+
+    size_type size() const override { return _size; }
+};
+
+struct Vector2dValues : public SnapshotValues
+{
+    VCounter cvec;
+    Result total;
+};
+
+class Vector2dSnapshot : public SnapshotBase<Vector2dInfo, Vector2dValues>
+{
+  protected:
+    Result _total = 0;
+
+    void
+    loadValues(Vector2dValues &v) override
+    {
+        cvec = std::move(v.cvec);
+        _total = v.total;
+    }
+
+  public:
+    Vector2dSnapshot(const Vector2dInfo &info)
+    {
+        subnames = info.subnames;
+        subdescs = info.subdescs;
+        y_subnames = info.y_subnames;
+        x = info.x;
+        y = info.y;
+    }
+
+    static void
+    take(const Vector2dInfo &info, Vector2dValues &v)
+    {
+        v.cvec = info.cvec;
+        v.total = info.total();
+    }
+
+    Result total() const override { return _total; }
+};
+
+struct SparseHistValues : public SnapshotValues
+{
+    SparseHistData data;
+};
+
+class SparseHistSnapshot
+    : public SnapshotBase<SparseHistInfo, SparseHistValues>
+{
+  protected:
+    void
+    loadValues(SparseHistValues &v) override
+    {
+        data = std::move(v.data);
+    }
+
+  public:
+    SparseHistSnapshot(const SparseHistInfo &info) {}
+
+    static void
+    take(const SparseHistInfo &info, SparseHistValues &v)
+    {
+        v.data = info.data;
+    }
+};
+
+void
+copyInfo(Info &to, const Info &from)
+{
+    to.name = from.name;
+    to.desc = from.desc;
+    to.flags = from.flags;
+    to.precision = from.precision;
+    to.id = from.id;
+    to.storageParams = from.storageParams;
+}
+
+} // anonymous namespace
+
+struct AsyncOutput::Dump
+{
+    /** Simulated time of the dump */
+    Tick when;
+
+    /** Stats and groups in the order they were visited */
+    struct Item
+    {
+        enum Kind { Stat, BeginGroup, EndGroup } kind;
+        /** Copy of the stat, shared by all the dumps */
+        StatSnapshot *stat;
+        /** Values of the stat taken by this dump */
+        std::unique_ptr<SnapshotValues> values;
+        /** Name of the group begun */
+        std::string group;
+    };
+    std::vector<Item> items;
+};
+
+namespace {
+
+/** Outputs whose writer must be stopped when the simulator forks */
+std::mutex outputsMutex;
+std::set<AsyncOutput *> outputs;
+
+void
+stopAllWriters()
+{
+    std::lock_guard<std::mutex> lock(outputsMutex);
+    for (auto *output : outputs)
+        output->stop();
+}
+
+} // anonymous namespace
+
+AsyncOutput::AsyncOutput(Output &_output, std::size_t max_pending)
+    : output(_output), maxPending(max_pending),
+      outputValid(_output.valid()), writing(false), stopping(false)
+{
+    // The writer thread would not exist in a forked child, whichever
+    // way the fork is made. Stopping it in the parent also makes sure
+    // that the child doesn't write the pending dumps again.
+    static const int atfork =
+        pthread_atfork(stopAllWriters, nullptr, nullptr);
+    fatal_if(atfork != 0, "Unable to stop the stats writers on fork.\n");
+
+    std::lock_guard<std::mutex> lock(outputsMutex);
+    outputs.insert(this);
+}
+
+AsyncOutput::~AsyncOutput()
+{
+    {
+        std::lock_guard<std::mutex> lock(outputsMutex);
+        outputs.erase(this);
+    }
+    stop();
+}
+
+void
+AsyncOutput::stop()
+{
+    if (!writer.joinable())
+        return;
+
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    cond.notify_all();
+    writer.join();
+    stopping = false;
+}
+
+void
+AsyncOutput::writerMain()
+{
+    // Outputs may read the current tick, which is set to the time of
+    // the dump being written on a queue private to this thread.
+    EventQueue queue("stats writer");
+    curEventQueue(&queue);
+
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+        cond.wait(lock, [this] { return stopping || !pending.empty(); });
+        if (pending.empty())
+            break;
+
+        std::unique_ptr<Dump> dump = std::move(pending.front());
+        pending.pop_front();
+        writing = true;
+        lock.unlock();
+        // let a blocked dump go on
+        cond.notify_all();
+
+        queue.setCurTick(dump->when);
+        output.begin();
+        for (const auto &item : dump->items) {
+            switch (item.kind) {
+              case Dump::Item::Stat:
+                item.stat->load(*item.values);
+                item.stat->info().visit(output);
+                break;
+              case Dump::Item::BeginGroup:
+                output.beginGroup(item.group.c_str());
+                break;
+              case Dump::Item::EndGroup:
+                output.endGroup();
+                break;
+            }
+        }
+        output.end();
+        const bool valid = output.valid();
+        dump.reset();
+
+        lock.lock();
+        outputValid = valid;
+        writing = false;
+        cond.notify_all();
+    }
+
+    curEventQueue(nullptr);
+}
+
+void
+AsyncOutput::flush()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    cond.wait(lock, [this] { return pending.empty() && !writing; });
+}
+
+void
+AsyncOutput::begin()
+{
+    current.reset(new Dump);
+    current->when = curTick();
+}
+
+void
+AsyncOutput::end()
+{
+    std::unique_lock<std::mutex> lock(mutex);
+    // Don't let dumps pile up if they are taken faster than they can
+    // be written.
+    cond.wait(lock, [this] { return pending.size() < maxPending; });
+    pending.push_back(std::move(current));
+    lock.unlock();
+    cond.notify_all();
+
+    if (!writer.joinable())
+        writer = std::thread(&AsyncOutput::writerMain, this);
+}
+
+bool
+AsyncOutput::valid() const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return outputValid;
+}
+
+void
+AsyncOutput::beginGroup(const char *name)
+{
+    current->items.push_back(
+        { Dump::Item::BeginGroup, nullptr, nullptr, name });
+}
+
+void
+AsyncOutput::endGroup()
+{
+    current->items.push_back({ Dump::Item::EndGroup, nullptr, nullptr, "" });
+}
+
+PrereqSnapshot *
+AsyncOutput::prereqSnapshot(const Info &info)
+{
+    auto &snapshot = prereqs[info.id];
+    if (!snapshot) {
+        snapshot.reset(new PrereqSnapshot);
+        copyInfo(*snapshot, info);
+    }
+    return snapshot.get();
+}
+
+template <class SnapshotType, class InfoType>
+void
+AsyncOutput::add(const InfoType &info)
+{
+    auto &snapshot = snapshots[info.id];
+    if (!snapshot) {
+        // Copies keep the id of the stat they copy, and must not use
+        // up ids of their own.
+        const int next_id = Info::id_count;
+        SnapshotType *copy = new SnapshotType(info);
+        copyInfo(*copy, info);
+        if (info.prereq)
+            copy->setPrereq(prereqSnapshot(*info.prereq));
+        Info::id_count = next_id;
+        snapshot.reset(copy);
+    }
+
+    typedef typename SnapshotType::ValuesType ValuesType;
+    ValuesType *values = new ValuesType;
+    SnapshotType::take(info, *values);
+    values->isZero = info.zero();
+    values->prereqZero = info.prereq && info.prereq->zero();
+
+    current->items.push_back({ Dump::Item::Stat, snapshot.get(),
+                               std::unique_ptr<SnapshotValues>(values), "" });
+}
+
+void
+AsyncOutput::visit(const ScalarInfo &info)
+{
+    add<ScalarSnapshot>(info);
+}
+
+void
+AsyncOutput::visit(const VectorInfo &info)
+{
+    add<VectorSnapshot>(info);
+}
+
+void
+AsyncOutput::visit(const DistInfo &info)
+{
+    add<DistSnapshot>(info);
+}
+
+void
+AsyncOutput::visit(const VectorDistInfo &info)
+{
+    add<VectorDistSnapshot>(info);
+}
+
+void
+AsyncOutput::visit(const Vector2dInfo &info)
+{
+    add<Vector2dSnapshot>(info);
+}
+
+void
+AsyncOutput::visit(const FormulaInfo &info)
+{
+    add<FormulaSnapshot>(info);
+}
+
+void
+AsyncOutput::visit(const SparseHistInfo &info)
+{
+    add<SparseHistSnapshot>(info);
+}
+
+std::unique_ptr<AsyncOutput>
+initAsync(Output *output)
+{
+    return std::unique_ptr<AsyncOutput>(new AsyncOutput(*output));
+}
+
+} // namespace Stats
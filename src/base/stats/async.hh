@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Stats output formatting and writing dumps in the background
+ *
+ * The values of the stats visited during a dump are copied, and
+ * another output visits them in a background thread, so that the
+ * simulation resumes as soon as the values have been taken.
+ */
+
+#ifndef __BASE_STATS_ASYNC_HH__
+#define __BASE_STATS_ASYNC_HH__
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+#include "base/stats/output.hh"
+
+namespace Stats {
+
+class PrereqSnapshot;
+class StatSnapshot;
+
+class AsyncOutput : public Output
+{
+  protected:
+    /** Output the dumps are handed over to */
+    Output &output;
+
+    /** Stats and groups visited during a dump */
+    struct Dump;
+
+    /** Dump being taken */
+    std::unique_ptr<Dump> current;
+
+    /** Maximum number of dumps waiting to be written */
+    const std::size_t maxPending;
+
+    mutable std::mutex mutex;
+    /** Signals new dumps to the writer, and written ones to flush() */
+    std::condition_variable cond;
+    std::deque<std::unique_ptr<Dump>> pending;
+    /** Validity of the output, as of the last dump written */
+    bool outputValid;
+    /** Whether the writer is busy with a dump */
+    bool writing;
+    bool stopping;
+    /** Writer thread, started on the first dump */
+    std::thread writer;
+
+    void writerMain();
+
+    /** Copies of the stats dumped so far, by id */
+    std::unordered_map<int, std::unique_ptr<StatSnapshot>> snapshots;
+    /** Copies of the prerequisites of the stats, by id */
+    std::unordered_map<int, std::unique_ptr<PrereqSnapshot>> prereqs;
+
+    /** Get the copy of a prerequisite, making it if needed */
+    PrereqSnapshot *prereqSnapshot(const Info &info);
+
+    /** Take the values of a stat for the current dump */
+    template <class Snapshot, class InfoType>
+    void add(const InfoType &info);
+
+  public:
+    /**
+     * @param output Output to write the dumps with
+     * @param max_pending Maximum number of dumps waiting to be
+     * written, beyond which dumping blocks.
+     */
+    AsyncOutput(Output &output, std::size_t max_pending = 4);
+    ~AsyncOutput();
+
+    /** Wait for all the dumps to be written */
+    void flush();
+
+    /**
+     * Write all the dumps and stop the writer thread, which is started
+     * again by the next dump. This is done for all outputs before the
+     * simulator forks, since the writer would not exist in the child.
+     */
+    void stop();
+
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+};
+
+std::unique_ptr<AsyncOutput> initAsync(Output *output);
+
+} // namespace Stats
+
+#endif // __BASE_STATS_ASYNC_HH__
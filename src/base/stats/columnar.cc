@@ -0,0 +1,387 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/stats/columnar.hh"
+
+#include <zlib.h>
+
+#include <cstring>
+
+#include "base/logging.hh"
+#include "base/stats/info.hh"
+#include "sim/byteswap.hh"
+#include "sim/core.hh"
+
+namespace Stats {
+
+const char Columnar::magic[8] = { 'g', 'e', 'm', '5', 's', 't', 'c', 'b' };
+
+namespace {
+
+const uint32_t version = 1;
+const uint32_t compressedFlag = 0x1;
+
+/** Number of columns of a distribution, not counting its buckets */
+const size_type distColumns = 10;
+
+template <class T>
+void
+append(std::vector<uint8_t> &buf, T value)
+{
+    value = htole(value);
+    const uint8_t *bytes = (const uint8_t *)&value;
+    buf.insert(buf.end(), bytes, bytes + sizeof(value));
+}
+
+void
+appendName(std::vector<uint8_t> &buf, const std::string &name)
+{
+    append<uint32_t>(buf, name.size());
+    buf.insert(buf.end(), name.begin(), name.end());
+}
+
+} // anonymous namespace
+
+Columnar::Columnar(const std::string &file, bool _compress,
+                   unsigned _chunking)
+    : stream(simout.create(file, true, true)), compress(_compress),
+      chunking(_chunking ? _chunking : 1), pendingRows(0)
+{
+    if (!valid())
+        fatal("Unable to open statistics file %s for writing\n", file);
+
+    writeHeader();
+}
+
+Columnar::~Columnar()
+{
+    flush();
+    simout.close(stream);
+}
+
+bool
+Columnar::valid() const
+{
+    return stream->stream()->good();
+}
+
+void
+Columnar::begin()
+{
+    groups.clear();
+    columns.clear();
+    row.clear();
+}
+
+void
+Columnar::end()
+{
+    assert(path.empty());
+
+    // The file starts over when it is moved to the output directory
+    // of a forked simulator.
+    if (stream->stream()->tellp() == 0) {
+        writeHeader();
+        schema.clear();
+    }
+
+    if (columns != schema) {
+        // Rows which are still buffered belong to the previous schema
+        flush();
+        writeSchema();
+        schema.swap(columns);
+    }
+
+    if (compress) {
+        writeRow(pending);
+        if (++pendingRows >= chunking)
+            flush();
+    } else {
+        std::vector<uint8_t> buf(1, 'R');
+        writeRow(buf);
+        stream->stream()->write((const char *)buf.data(), buf.size());
+        stream->stream()->flush();
+    }
+}
+
+void
+Columnar::flush()
+{
+    if (!pendingRows)
+        return;
+
+    uLongf size = compressBound(pending.size());
+    std::vector<uint8_t> buf(1, 'Z');
+    append<uint32_t>(buf, pendingRows);
+    append<uint64_t>(buf, 0);
+    append<uint64_t>(buf, pending.size());
+    const size_t header_size = buf.size();
+    buf.resize(header_size + size);
+    if (compress2(buf.data() + header_size, &size, pending.data(),
+                  pending.size(), Z_BEST_SPEED) != Z_OK) {
+        panic("Failed to compress statistics\n");
+    }
+    buf.resize(header_size + size);
+    const uint64_t compressed_size = htole((uint64_t)size);
+    memcpy(buf.data() + header_size - 2 * sizeof(uint64_t),
+           &compressed_size, sizeof(compressed_size));
+
+    stream->stream()->write((const char *)buf.data(), buf.size());
+    stream->stream()->flush();
+
+    pending.clear();
+    pendingRows = 0;
+}
+
+void
+Columnar::writeRow(std::vector<uint8_t> &buf) const
+{
+    append<uint64_t>(buf, curTick());
+    const size_t offset = buf.size();
+    buf.resize(offset + row.size() * sizeof(uint64_t));
+    uint8_t *values = buf.data() + offset;
+    for (double value : row) {
+        uint64_t bits;
+        memcpy(&bits, &value, sizeof(bits));
+        bits = htole(bits);
+        memcpy(values, &bits, sizeof(bits));
+        values += sizeof(bits);
+    }
+}
+
+void
+Columnar::writeHeader()
+{
+    std::vector<uint8_t> header(magic, magic + sizeof(magic));
+    append<uint32_t>(header, version);
+    append<uint32_t>(header, compress ? compressedFlag : 0);
+    stream->stream()->write((const char *)header.data(), header.size());
+}
+
+void
+Columnar::writeSchema()
+{
+    std::vector<std::string> names;
+    for (const auto &column : columns)
+        columnNames(column, names);
+    assert(names.size() == row.size());
+
+    std::vector<uint8_t> buf(1, 'S');
+    append<uint32_t>(buf, names.size());
+    for (const auto &name : names)
+        appendName(buf, name);
+    stream->stream()->write((const char *)buf.data(), buf.size());
+}
+
+void
+Columnar::beginGroup(const char *name)
+{
+    if (path.empty()) {
+        groups.push_back(name);
+    } else {
+        groups.push_back(groups[path.top()] + "." + name);
+    }
+    path.push(groups.size() - 1);
+}
+
+void
+Columnar::endGroup()
+{
+    assert(!path.empty());
+    path.pop();
+}
+
+void
+Columnar::addColumns(const Info &info, Kind kind, size_type count)
+{
+    columns.push_back({ &info, info.id, kind,
+                        path.empty() ? 0 : path.top() + 1, count });
+}
+
+void
+Columnar::addDist(const DistData &data)
+{
+    row.push_back(data.samples);
+    row.push_back(data.sum);
+    row.push_back(data.squares);
+    row.push_back(data.min_val);
+    row.push_back(data.max_val);
+    row.push_back(data.underflow);
+    row.push_back(data.overflow);
+    row.push_back(data.min);
+    row.push_back(data.max);
+    row.push_back(data.bucket_size);
+    row.insert(row.end(), data.cvec.begin(), data.cvec.end());
+}
+
+void
+Columnar::columnNames(const Column &column,
+                      std::vector<std::string> &names) const
+{
+    const Info &info = *column.info;
+    const std::string name = column.group ?
+        groups[column.group - 1] + "." + info.name : info.name;
+    const std::string &sep = info.separatorString;
+
+    switch (column.kind) {
+      case Kind::Scalar:
+        names.push_back(name);
+        break;
+
+      case Kind::Vector: {
+        const auto &vector = static_cast<const VectorInfo &>(info);
+        for (off_type i = 0; i < column.count; ++i) {
+            names.push_back(name + sep +
+                (i < vector.subnames.size() && !vector.subnames[i].empty() ?
+                 vector.subnames[i] : std::to_string(i)));
+        }
+        break;
+      }
+
+      case Kind::Vector2d: {
+        const auto &vector = static_cast<const Vector2dInfo &>(info);
+        for (off_type i = 0; i < vector.x; ++i) {
+            const std::string x_name = name + "_" +
+                (i < vector.subnames.size() && !vector.subnames[i].empty() ?
+                 vector.subnames[i] : std::to_string(i));
+            for (off_type j = 0; j < vector.y; ++j) {
+                names.push_back(x_name + sep +
+                    (j < vector.y_subnames.size() &&
+                     !vector.y_subnames[j].empty() ?
+                     vector.y_subnames[j] : std::to_string(j)));
+            }
+        }
+        break;
+      }
+
+      case Kind::Dist:
+      case Kind::VectorDist: {
+        static const char *fields[distColumns] = {
+            "samples", "sum", "squares", "min_value", "max_value",
+            "underflows", "overflows", "min", "max", "bucket_size" };
+
+        std::vector<std::string> prefixes;
+        if (column.kind == Kind::Dist) {
+            prefixes.push_back(name + sep);
+        } else {
+            const auto &dist = static_cast<const VectorDistInfo &>(info);
+            for (off_type i = 0; i < dist.data.size(); ++i) {
+                prefixes.push_back(name + sep +
+                    (i < dist.subnames.size() && !dist.subnames[i].empty() ?
+                     dist.subnames[i] : std::to_string(i)) + sep);
+            }
+        }
+
+        const size_type buckets =
+            column.count / prefixes.size() - distColumns;
+        for (const auto &prefix : prefixes) {
+            for (const char *field : fields)
+                names.push_back(prefix + field);
+            for (size_type i = 0; i < buckets; ++i)
+                names.push_back(prefix + "bucket" + std::to_string(i));
+        }
+        break;
+      }
+    }
+}
+
+void
+Columnar::visit(const ScalarInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    addColumns(info, Kind::Scalar, 1);
+    row.push_back(info.result());
+}
+
+void
+Columnar::visit(const VectorInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    const VResult &result = info.result();
+    addColumns(info, Kind::Vector, result.size());
+    row.insert(row.end(), result.begin(), result.end());
+}
+
+void
+Columnar::visit(const DistInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    addColumns(info, Kind::Dist, distColumns + info.data.cvec.size());
+    addDist(info.data);
+}
+
+void
+Columnar::visit(const VectorDistInfo &info)
+{
+    if (!info.flags.isSet(display) || info.data.empty())
+        return;
+
+    // All the distributions of a vector have the same buckets
+    addColumns(info, Kind::VectorDist,
+               info.data.size() * (distColumns + info.data[0].cvec.size()));
+    for (const auto &data : info.data)
+        addDist(data);
+}
+
+void
+Columnar::visit(const Vector2dInfo &info)
+{
+    if (!info.flags.isSet(display))
+        return;
+
+    addColumns(info, Kind::Vector2d, info.x * info.y);
+    row.insert(row.end(), info.cvec.begin(), info.cvec.begin() +
+               info.x * info.y);
+}
+
+void
+Columnar::visit(const FormulaInfo &info)
+{
+    visit((const VectorInfo &)info);
+}
+
+void
+Columnar::visit(const SparseHistInfo &info)
+{
+    warn_once("Columnar stat files don't support sparse histograms.\n");
+}
+
+std::unique_ptr<Columnar>
+initColumnar(const std::string &filename, bool compress, unsigned chunking)
+{
+    return std::unique_ptr<Columnar>(
+        new Columnar(filename, compress, chunking));
+}
+
+} // namespace Stats
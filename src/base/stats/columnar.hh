@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Binary, columnar stats output
+ *
+ * The values of all the stats are written as a row of fixed-width
+ * numbers at every dump, the names of the columns being written once
+ * beforehand, so a dump costs little more than copying the values.
+ *
+ * The file starts with an 8-byte magic string, a u32 version and a
+ * u32 holding flags (bit 0: rows are compressed), followed by a
+ * sequence of records, all numbers being little endian:
+ *  - a schema: 'S', u32 number of columns, followed by the name of
+ *    each column as a u32 length and the characters of the name.
+ *  - a row: 'R', u64 tick, one f64 per column of the last schema.
+ *  - compressed rows: 'Z', u32 number of rows, u64 compressed size,
+ *    u64 uncompressed size, followed by the zlib-compressed rows
+ *    (each being a u64 tick and one f64 per column).
+ * A new schema is only written if the set of stats dumped changes.
+ *
+ * util/columnar_stats.py reads these files.
+ */
+
+#ifndef __BASE_STATS_COLUMNAR_HH__
+#define __BASE_STATS_COLUMNAR_HH__
+
+#include <cstdint>
+#include <memory>
+#include <stack>
+#include <string>
+#include <vector>
+
+#include "base/output.hh"
+#include "base/stats/output.hh"
+#include "base/stats/types.hh"
+
+namespace Stats {
+
+struct DistData;
+
+class Columnar : public Output
+{
+  public:
+    /** Magic string at the start of columnar stats files */
+    static const char magic[8];
+
+    Columnar(const std::string &file, bool compress, unsigned chunking);
+
+    ~Columnar();
+
+    Columnar() = delete;
+    Columnar(const Columnar &other) = delete;
+
+    /** Write the rows buffered for compression to the file. */
+    void flush();
+
+  public: // Output interface
+    void begin() override;
+    void end() override;
+    bool valid() const override;
+
+    void beginGroup(const char *name) override;
+    void endGroup() override;
+
+    void visit(const ScalarInfo &info) override;
+    void visit(const VectorInfo &info) override;
+    void visit(const DistInfo &info) override;
+    void visit(const VectorDistInfo &info) override;
+    void visit(const Vector2dInfo &info) override;
+    void visit(const FormulaInfo &info) override;
+    void visit(const SparseHistInfo &info) override;
+
+  protected:
+    enum class Kind { Scalar, Vector, Vector2d, Dist, VectorDist };
+
+    /** A stat visited during a dump, and the columns it took. */
+    struct Column
+    {
+        /** The stat, only valid during the dump */
+        const Info *info;
+        /**
+         * Id of the stat, which identifies it across dumps even when
+         * they visit copies of it, as when written in the background
+         */
+        int id;
+        Kind kind;
+        /**
+         * Index in groups of the group holding the stat plus one, 0
+         * standing for stats outside of any group
+         */
+        size_type group;
+        size_type count;
+
+        bool
+        operator==(const Column &other) const
+        {
+            return id == other.id && count == other.count;
+        }
+    };
+
+    /**
+     * Add the columns of a stat to the current row.
+     */
+    void addColumns(const Info &info, Kind kind, size_type count);
+
+    /** Add the columns of a distribution to the current row. */
+    void addDist(const DistData &data);
+
+    /** Get the names of the columns of a stat. */
+    void columnNames(const Column &column,
+                     std::vector<std::string> &names) const;
+
+    /** Write the header of the file. */
+    void writeHeader();
+
+    /** Write the names of the columns of the current dump. */
+    void writeSchema();
+
+    void writeRow(std::vector<uint8_t> &buf) const;
+
+    OutputStream *const stream;
+    const bool compress;
+    const unsigned chunking;
+
+    /** Full names of the groups visited during the current dump */
+    std::vector<std::string> groups;
+    /** Indices in groups of the groups being visited */
+    std::stack<size_type> path;
+
+    /** Stats visited during the current dump */
+    std::vector<Column> columns;
+    /** Stats described by the last schema written */
+    std::vector<Column> schema;
+
+    /** Values of the current dump */
+    std::vector<double> row;
+
+    /** Rows waiting to be compressed */
+    std::vector<uint8_t> pending;
+    unsigned pendingRows;
+};
+
+std::unique_ptr<Columnar> initColumnar(
+    const std::string &filename, bool compress = true,
+    unsigned chunking = 64);
+
+} // namespace Stats
+
+#endif // __BASE_STATS_COLUMNAR_HH__
@@ -38,6 +38,7 @@
 #include <string>
 
 #include "base/atomicio.hh"
+#include "base/callback.hh"
 #include "base/debug.hh"
 #include "base/logging.hh"
 #include "base/output.hh"
@@ -107,9 +108,16 @@ void
 Logger::dump(Tick when, const std::string &name,
          const void *d, int len, const std::string &flag)
 {
+    if (filtered(name))
+        return;
     if (!name.empty() && ignore.match(name))
         return;
 
+    if (binaryWriter) {
+        binaryWriter->dump(when, name, flag, d, len);
+        return;
+    }
+
     const char *data = static_cast<const char *>(d);
     int c, i, j;
 
@@ -168,4 +176,61 @@ OstreamLogger::logMessage(Tick when, const std::string &name,
     }
 }
 
+BinaryLogger::BinaryLogger(std::ostream &stream)
+    : writer(stream), textBuffer(writer), textStream(&textBuffer)
+{
+    binaryWriter = &writer;
+    registerExitCallback(
+        new MakeCallback<BinaryLogger, &BinaryLogger::flush>(this, true));
+}
+
+void
+BinaryLogger::logMessage(Tick when, const std::string &name,
+        const std::string &flag, const std::string &message)
+{
+    writer.message(when, name, flag, "%s", message);
+}
+
+void
+BinaryLogger::flush()
+{
+    textStream.flush();
+    writer.flush();
+}
+
+void
+BinaryLogger::prepareFork()
+{
+    textStream.flush();
+    writer.prepareFork();
+}
+
+void
+BinaryLogger::afterFork(bool child)
+{
+    writer.afterFork(child);
+}
+
+int
+BinaryLogger::TextBuffer::overflow(int c)
+{
+    if (c == traits_type::eof())
+        return traits_type::not_eof(c);
+
+    line += (char)c;
+    if (c == '\n')
+        sync();
+    return c;
+}
+
+int
+BinaryLogger::TextBuffer::sync()
+{
+    if (!line.empty()) {
+        writer.text(line);
+        line.clear();
+    }
+    return 0;
+}
+
 } // namespace Trace
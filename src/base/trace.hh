@@ -32,11 +32,14 @@
 #ifndef __BASE_TRACE_HH__
 #define __BASE_TRACE_HH__
 
+#include <streambuf>
 #include <string>
 
+#include "base/binary_trace.hh"
 #include "base/cprintf.hh"
 #include "base/debug.hh"
 #include "base/match.hh"
+#include "base/trace_filter.hh"
 #include "base/types.hh"
 #include "sim/core.hh"
 
@@ -50,6 +53,17 @@ class Logger
     /** Name match for objects to ignore */
     ObjectMatch ignore;
 
+    /** Writer recording the messages in binary form, if any */
+    BinaryTraceWriter *binaryWriter = nullptr;
+
+    /** Check if a message is rejected by the run time filters */
+    bool
+    filtered(const std::string &name) const
+    {
+        // only read the tick when there are filters to check
+        return debugFilter.active() && !debugFilter.accept(curTick(), name);
+    }
+
   public:
     /** Log a single message */
     template <typename ...Args>
@@ -65,8 +79,14 @@ class Logger
             const std::string &flag,
             const char *fmt, const Args &...args)
     {
+        if (filtered(name))
+            return;
         if (!name.empty() && ignore.match(name))
             return;
+        if (binaryWriter) {
+            binaryWriter->message(when, name, flag, fmt, args...);
+            return;
+        }
         std::ostringstream line;
         ccprintf(line, fmt, args...);
         logMessage(when, name, flag, line.str());
@@ -93,6 +113,13 @@ class Logger
     /** Add objects to ignore */
     void addIgnore(const ObjectMatch &ignore_) { ignore.add(ignore_); }
 
+    /** Write out everything logged so far, before the simulator is
+     *  forked, so that the child doesn't write it again */
+    virtual void prepareFork() { getOstream().flush(); }
+
+    /** Resume logging after the simulator has been forked */
+    virtual void afterFork(bool child) { }
+
     virtual ~Logger() { }
 };
 
@@ -113,6 +140,45 @@ class OstreamLogger : public Logger
     std::ostream &getOstream() override { return stream; }
 };
 
+/** Logger recording messages in the binary trace format, which is
+ *  turned into text by util/tracedecode */
+class BinaryLogger : public Logger
+{
+  protected:
+    BinaryTraceWriter writer;
+
+    /** Stream buffer recording the lines written to getOstream() */
+    class TextBuffer : public std::streambuf
+    {
+      protected:
+        BinaryTraceWriter &writer;
+        std::string line;
+
+        int overflow(int c) override;
+        int sync() override;
+
+      public:
+        TextBuffer(BinaryTraceWriter &writer_) : writer(writer_) { }
+    };
+
+    TextBuffer textBuffer;
+    std::ostream textStream;
+
+  public:
+    BinaryLogger(std::ostream &stream);
+
+    void logMessage(Tick when, const std::string &name,
+            const std::string &flag, const std::string &message) override;
+
+    std::ostream &getOstream() override { return textStream; }
+
+    /** Write out all the messages logged so far */
+    void flush();
+
+    void prepareFork() override;
+    void afterFork(bool child) override;
+};
+
 /** Get the current global debug logger.  This takes ownership of the given
  *  logger which should be allocated using 'new' */
 Logger *getDebugLogger();
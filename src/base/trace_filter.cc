@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "base/trace_filter.hh"
+
+#include <fnmatch.h>
+
+#include <algorithm>
+
+namespace Trace {
+
+Filter debugFilter;
+
+#if TRACING_ON
+thread_local Addr AddrScope::current = MaxAddr;
+#endif
+
+/** Source of the generations of all filters, so that they never clash */
+static uint64_t lastGeneration = 0;
+
+void
+Filter::update()
+{
+    _active = !windows.empty() || !patterns.empty() || !ranges.empty();
+    generation = ++lastGeneration;
+}
+
+bool
+Filter::acceptTick(Tick when) const
+{
+    // find the last window starting at or before the tick
+    auto it = std::upper_bound(windows.begin(), windows.end(), when,
+        [](Tick t, const std::pair<Tick, Tick> &w) { return t < w.first; });
+    return it != windows.begin() && when < std::prev(it)->second;
+}
+
+bool
+Filter::acceptName(const std::string &name) const
+{
+    // Names are nearly always those of SimObjects, which don't move,
+    // so the matches are cached by address. The text is checked too
+    // as temporary names may reuse an address.
+    struct CachedMatch
+    {
+        const std::string *name = nullptr;
+        uint64_t generation = 0;
+        std::string text;
+        bool match = false;
+    };
+    static thread_local CachedMatch cache[256];
+
+    CachedMatch &entry =
+        cache[(reinterpret_cast<uintptr_t>(&name) >> 3) % 256];
+    if (entry.name == &name && entry.generation == generation &&
+        entry.text == name) {
+        return entry.match;
+    }
+
+    entry.name = &name;
+    entry.generation = generation;
+    entry.text = name;
+    entry.match = std::any_of(patterns.begin(), patterns.end(),
+        [&name](const std::string &pattern) {
+            return fnmatch(pattern.c_str(), name.c_str(), 0) == 0;
+        });
+    return entry.match;
+}
+
+bool
+Filter::acceptAddr(Addr addr) const
+{
+    return std::any_of(ranges.begin(), ranges.end(),
+        [addr](const std::pair<Addr, Addr> &r) {
+            return addr >= r.first && addr < r.second;
+        });
+}
+
+bool
+Filter::acceptSlow(Tick when, const std::string &name) const
+{
+    if (!windows.empty() && !acceptTick(when))
+        return false;
+    if (!patterns.empty() && !name.empty() && !acceptName(name))
+        return false;
+    const Addr addr = AddrScope::get();
+    if (!ranges.empty() && addr != MaxAddr && !acceptAddr(addr))
+        return false;
+    return true;
+}
+
+void
+Filter::addWindow(Tick start, Tick end)
+{
+    if (start >= end)
+        return;
+
+    windows.emplace_back(start, end);
+    std::sort(windows.begin(), windows.end());
+
+    // merge the windows that overlap
+    std::vector<std::pair<Tick, Tick>> merged;
+    for (const auto &w : windows) {
+        if (!merged.empty() && w.first <= merged.back().second)
+            merged.back().second = std::max(merged.back().second, w.second);
+        else
+            merged.push_back(w);
+    }
+    windows.swap(merged);
+    update();
+}
+
+void
+Filter::addName(const std::string &pattern)
+{
+    patterns.push_back(pattern);
+    update();
+}
+
+void
+Filter::addAddrRange(Addr start, Addr end)
+{
+    if (start >= end)
+        return;
+
+    ranges.emplace_back(start, end);
+    update();
+}
+
+void
+Filter::clearWindows()
+{
+    windows.clear();
+    update();
+}
+
+void
+Filter::clearNames()
+{
+    patterns.clear();
+    update();
+}
+
+void
+Filter::clearAddrRanges()
+{
+    ranges.clear();
+    update();
+}
+
+} // namespace Trace
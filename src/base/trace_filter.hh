@@ -0,0 +1,144 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __BASE_TRACE_FILTER_HH__
+#define __BASE_TRACE_FILTER_HH__
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/types.hh"
+
+namespace Trace {
+
+/**
+ * Run time filter on the debug messages of enabled flags, restricting
+ * them to windows of ticks, to objects whose name matches a glob
+ * pattern, and to the handling of packets to some address ranges.
+ *
+ * Each kind of filter is only applied once set, and a message must
+ * pass all of them. When no filter is set, checking a message is a
+ * single test.
+ */
+class Filter
+{
+  protected:
+    /** Whether any filter is set */
+    bool _active = false;
+
+    /** Windows of ticks [start, end), sorted and not overlapping */
+    std::vector<std::pair<Tick, Tick>> windows;
+
+    /** Glob patterns of object names */
+    std::vector<std::string> patterns;
+
+    /** Address ranges [start, end) */
+    std::vector<std::pair<Addr, Addr>> ranges;
+
+    /**
+     * Number of times the patterns changed, to invalidate the cached
+     * matches of names.
+     */
+    uint64_t generation = 1;
+
+    void update();
+
+    bool acceptTick(Tick when) const;
+    bool acceptName(const std::string &name) const;
+    bool acceptAddr(Addr addr) const;
+    bool acceptSlow(Tick when, const std::string &name) const;
+
+  public:
+    bool active() const { return _active; }
+
+    /**
+     * Check if a message passes the filters.
+     *
+     * @param when Current tick
+     * @param name Name of the object logging the message. Messages
+     * without a name are never filtered out by name.
+     */
+    bool
+    accept(Tick when, const std::string &name) const
+    {
+        return !_active || acceptSlow(when, name);
+    }
+
+    /** Only accept messages logged in a window of ticks [start, end) */
+    void addWindow(Tick start, Tick end);
+
+    /** Only accept messages of objects matching a glob pattern */
+    void addName(const std::string &pattern);
+
+    /**
+     * Only accept messages logged while handling a packet to an
+     * address range [start, end). Messages logged outside of the
+     * handling of a packet are never filtered out by address.
+     */
+    void addAddrRange(Addr start, Addr end);
+
+    void clearWindows();
+    void clearNames();
+    void clearAddrRanges();
+};
+
+/** Filter applied to the messages of the debug logger */
+extern Filter debugFilter;
+
+/**
+ * Address of the packet a thread is handling, set for the lifetime
+ * of a scope. The ports set it when delivering a packet, so that
+ * the address filter applies to everything the receiver logs.
+ */
+class AddrScope
+{
+#if TRACING_ON
+  protected:
+    /** Address being handled, MaxAddr if none */
+    static thread_local Addr current;
+
+    const Addr previous;
+
+  public:
+    AddrScope(Addr addr) : previous(current) { current = addr; }
+    ~AddrScope() { current = previous; }
+
+    static Addr get() { return current; }
+#else
+  public:
+    AddrScope(Addr addr) { }
+
+    static Addr get() { return MaxAddr; }
+#endif
+};
+
+} // namespace Trace
+
+#endif // __BASE_TRACE_FILTER_HH__
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "base/trace_filter.hh"
+
+using Trace::AddrScope;
+using Trace::Filter;
+
+TEST(TraceFilterTest, NoFilter)
+{
+    Filter filter;
+    EXPECT_FALSE(filter.active());
+    EXPECT_TRUE(filter.accept(0, "system.cpu"));
+    EXPECT_TRUE(filter.accept(MaxTick, ""));
+}
+
+TEST(TraceFilterTest, Windows)
+{
+    Filter filter;
+    filter.addWindow(100, 200);
+    filter.addWindow(500, 600);
+    // overlaps with the first window
+    filter.addWindow(150, 300);
+    EXPECT_TRUE(filter.active());
+
+    EXPECT_FALSE(filter.accept(99, "a"));
+    EXPECT_TRUE(filter.accept(100, "a"));
+    EXPECT_TRUE(filter.accept(250, "a"));
+    EXPECT_FALSE(filter.accept(300, "a"));
+    EXPECT_TRUE(filter.accept(599, "a"));
+    EXPECT_FALSE(filter.accept(600, "a"));
+
+    filter.clearWindows();
+    EXPECT_FALSE(filter.active());
+    EXPECT_TRUE(filter.accept(99, "a"));
+}
+
+TEST(TraceFilterTest, Names)
+{
+    Filter filter;
+    const std::string dcache("system.cpu1.dcache");
+    const std::string icache("system.cpu1.icache");
+    const std::string l2("system.l2");
+
+    filter.addName("system.cpu*.dcache");
+    EXPECT_TRUE(filter.accept(0, dcache));
+    EXPECT_FALSE(filter.accept(0, icache));
+    EXPECT_FALSE(filter.accept(0, l2));
+    // messages without a name are kept
+    EXPECT_TRUE(filter.accept(0, ""));
+
+    // the cached matches must not outlive a change of the patterns
+    filter.addName("*.l2");
+    EXPECT_TRUE(filter.accept(0, l2));
+    EXPECT_TRUE(filter.accept(0, dcache));
+    filter.clearNames();
+    filter.addName("*icache");
+    EXPECT_FALSE(filter.accept(0, dcache));
+    EXPECT_TRUE(filter.accept(0, icache));
+
+    // a name at the same address with a different text
+    std::string name("system.cpu0.icache");
+    EXPECT_TRUE(filter.accept(0, name));
+    name = "system.cpu0.dcache";
+    EXPECT_FALSE(filter.accept(0, name));
+}
+
+TEST(TraceFilterTest, AddrRanges)
+{
+    Filter filter;
+    filter.addAddrRange(0x1000, 0x1040);
+
+    // not handling a packet
+    EXPECT_TRUE(filter.accept(0, "system.l2"));
+
+    {
+        AddrScope scope(0x2000);
+        EXPECT_FALSE(filter.accept(0, "system.l2"));
+        {
+            AddrScope inner(0x1020);
+            EXPECT_TRUE(filter.accept(0, "system.l2"));
+        }
+        EXPECT_FALSE(filter.accept(0, "system.l2"));
+    }
+    EXPECT_TRUE(filter.accept(0, "system.l2"));
+
+    AddrScope scope(0x1040);
+    EXPECT_FALSE(filter.accept(0, "system.l2"));
+    filter.clearAddrRanges();
+    EXPECT_TRUE(filter.accept(0, "system.l2"));
+}
@@ -88,9 +88,6 @@ class BaseDynInst : public ExecContext, public RefCounted
     typedef typename Impl::DynInstPtr DynInstPtr;
     typedef RefCountingPtr<BaseDynInst<Impl> > BaseDynInstPtr;
 
-    // The list of instructions iterator type.
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
-
     enum {
         MaxInstSrcRegs = TheISA::MaxInstSrcRegs,        /// Max source regs
         MaxInstDestRegs = TheISA::MaxInstDestRegs       /// Max dest regs
@@ -190,8 +187,8 @@ class BaseDynInst : public ExecContext, public RefCounted
     /** The thread this instruction is from. */
     ThreadID threadNumber;
 
-    /** Iterator pointing to this BaseDynInst in the list of all insts. */
-    ListIt instListIt;
+    /** Index of this BaseDynInst in the list of all insts. */
+    int instListIdx;
 
     ////////////////////// Branch Data ///////////////
     /** Predicted PC state after this instruction. */
@@ -924,11 +921,11 @@ class BaseDynInst : public ExecContext, public RefCounted
     /** Assert this instruction has generated a memory request. */
     void setRequest() { instFlags[ReqMade] = true; }
 
-    /** Returns iterator to this instruction in the list of all insts. */
-    ListIt &getInstListIt() { return instListIt; }
+    /** Returns the index of this instruction in the list of all insts. */
+    int getInstListIdx() const { return instListIdx; }
 
-    /** Sets iterator for this instruction in the list of all insts. */
-    void setInstListIt(ListIt _instListIt) { instListIt = _instListIt; }
+    /** Sets the index of this instruction in the list of all insts. */
+    void setInstListIdx(int idx) { instListIdx = idx; }
 
   public:
     /** Returns the number of consecutive store conditional failures. */
@@ -105,6 +105,7 @@ BaseDynInst<Impl>::initVars()
 
     lqIdx = -1;
     sqIdx = -1;
+    instListIdx = -1;
 
     // Eventually make this a parameter.
     threadNumber = 0;
@@ -33,6 +33,7 @@
 
 #include "arch/isa_traits.hh"
 #include "arch/types.hh"
+#include "base/flat_hash_map.hh"
 #include "config/the_isa.hh"
 #include "cpu/static_inst_fwd.hh"
 
@@ -49,6 +50,13 @@ template <typename EMI>
 using InstMap = std::unordered_map<EMI, StaticInstPtr>;
 
 /// A sparse map from an Addr to a Value, stored in page chunks.
+///
+/// Pages are found through a direct mapped table of the most recently
+/// used ones, which holds the working set of pages of most programs,
+/// and only go to a hash map of all the pages when they miss in it.
+/// Users are expected to check the values they find against the bytes
+/// actually fetched, which keeps self-modifying code correct without
+/// having to invalidate anything.
 template<class Value>
 class AddrMap
 {
@@ -57,65 +65,47 @@ class AddrMap
     struct CachePage {
         Value items[TheISA::PageBytes];
     };
+
+    // Number of entries of the table of recently used pages.
+    static const unsigned recentPages = 256;
+    static_assert((recentPages & (recentPages - 1)) == 0,
+                  "The number of recent pages must be a power of 2");
+
+    struct RecentPage {
+        // Not page aligned, so it never matches when unused.
+        Addr addr = 1;
+        CachePage *page = nullptr;
+    };
+    RecentPage recent[recentPages];
+
     // A map of cache pages which allows a sparse mapping.
-    typedef typename std::unordered_map<Addr, CachePage *> PageMap;
-    typedef typename PageMap::iterator PageIt;
-    // Mini cache of recent lookups.
-    PageIt recent[2];
-    PageMap pageMap;
-
-    /// Update the mini cache of recent lookups.
-    /// @param recentest The most recent result;
-    void
-    update(PageIt recentest)
-    {
-        recent[1] = recent[0];
-        recent[0] = recentest;
-    }
+    FlatHashMap<Addr, CachePage *> pageMap;
 
-    /// Attempt to find the CacheePage which goes with a particular
-    /// address. First check the small cache of recent results, then
+    /// Attempt to find the CachePage which goes with a particular
+    /// address. First check the table of recently used pages, then
     /// actually look in the hash map.
     /// @param addr The address to look up.
     CachePage *
     getPage(Addr addr)
     {
-        Addr page_addr = addr & ~(TheISA::PageBytes - 1);
-
-        // Check against recent lookups.
-        if (recent[0] != pageMap.end()) {
-            if (recent[0]->first == page_addr)
-                return recent[0]->second;
-            if (recent[1] != pageMap.end() &&
-                    recent[1]->first == page_addr) {
-                update(recent[1]);
-                // recent[1] has just become recent[0].
-                return recent[0]->second;
-            }
-        }
-
-        // Actually look in the has_map.
-        PageIt it = pageMap.find(page_addr);
-        if (it != pageMap.end()) {
-            update(it);
-            return it->second;
-        }
+        const Addr page_addr = addr & ~(TheISA::PageBytes - 1);
 
+        RecentPage &entry =
+            recent[(page_addr / TheISA::PageBytes) & (recentPages - 1)];
+        if (entry.addr == page_addr)
+            return entry.page;
+
+        CachePage *&page = pageMap[page_addr];
         // Didn't find an existing page, so add a new one.
-        CachePage *newPage = new CachePage;
-        page_addr = page_addr & ~(TheISA::PageBytes - 1);
-        typename PageMap::value_type to_insert(page_addr, newPage);
-        update(pageMap.insert(to_insert).first);
-        return newPage;
-    }
+        if (!page)
+            page = new CachePage;
 
-  public:
-    /// Constructor
-    AddrMap()
-    {
-        recent[0] = recent[1] = pageMap.end();
+        entry.addr = page_addr;
+        entry.page = page;
+        return page;
     }
 
+  public:
     Value &
     lookup(Addr addr)
     {
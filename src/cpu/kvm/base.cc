@@ -1109,7 +1109,7 @@ BaseKvmCPU::doMMIOAccess(Addr paddr, void *data, int size, bool write)
     ThreadContext *tc(thread->getTC());
     syncThreadContext();
 
-    RequestPtr mmio_req = std::make_shared<Request>(
+    RequestPtr mmio_req = new Request(
         paddr, size, Request::UNCACHEABLE, dataMasterId());
 
     mmio_req->setContext(tc->contextId());
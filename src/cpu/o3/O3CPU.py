@@ -156,6 +156,10 @@ class DerivO3CPU(BaseCPU):
     numPhysCCRegs = Param.Unsigned(_defaultNumPhysCCRegs,
                                    "Number of physical cc registers")
     numIQEntries = Param.Unsigned(64, "Number of instruction queue entries")
+    iqWakeupMatrix = Param.Bool(False, "Use the alternative instruction "
+        "queue implementation tracking dependencies and ready instructions "
+        "in arrays rather than linked lists and priority queues (issues "
+        "the same instructions in the same order)")
     numROBEntries = Param.Unsigned(192, "Number of reorder buffer entries")
 
     smtNumFetchingThreads = Param.Unsigned(1, "SMT Number of Fetching Threads")
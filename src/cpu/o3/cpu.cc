@@ -146,6 +146,20 @@ FullO3CPU<Impl>::FullO3CPU(DerivO3CPUParams *params)
         checker = NULL;
     }
 
+    // Get the instructions that can be in flight at once up front:
+    // those in the ROB, and those in the fetch queues and the decode
+    // and rename skid buffers. More are allocated if squashed
+    // instructions outlive this, e.g. while they wait for the memory
+    // system. The free lists of the allocator are per thread, so the
+    // instructions are only reserved once the CPU ticks on the thread
+    // of its event queue.
+    const std::size_t max_in_flight = params->numROBEntries +
+        params->numThreads * params->fetchQueueSize +
+        (params->fetchToDecodeDelay + params->decodeToRenameDelay + 2) *
+        params->fetchWidth;
+    instsToReserve = max_in_flight;
+    instList.reserve(max_in_flight);
+
     if (!FullSystem) {
         thread.resize(numThreads);
         tids.resize(numThreads);
@@ -522,6 +536,11 @@ FullO3CPU<Impl>::tick()
     assert(!switchedOut());
     assert(drainState() != DrainState::Drained);
 
+    if (instsToReserve) {
+        O3DynInstAllocator<Impl>::reserve(instsToReserve);
+        instsToReserve = 0;
+    }
+
     ++numCycles;
     updateCycleCounters(BaseCPU::CPU_STATE_ON);
 
@@ -1505,12 +1524,10 @@ FullO3CPU<Impl>::squashFromTC(ThreadID tid)
 }
 
 template <class Impl>
-typename FullO3CPU<Impl>::ListIt
+typename FullO3CPU<Impl>::ListIdx
 FullO3CPU<Impl>::addInst(const DynInstPtr &inst)
 {
-    instList.push_back(inst);
-
-    return --(instList.end());
+    return instList.push_back(inst);
 }
 
 template <class Impl>
@@ -1545,7 +1562,7 @@ FullO3CPU<Impl>::removeFrontInst(const DynInstPtr &inst)
     removeInstsThisCycle = true;
 
     // Remove the front instruction.
-    removeList.push(inst->getInstListIt());
+    removeList.push_back(inst->getInstListIdx());
 }
 
 template <class Impl>
@@ -1555,7 +1572,7 @@ FullO3CPU<Impl>::removeInstsNotInROB(ThreadID tid)
     DPRINTF(O3CPU, "Thread %i: Deleting instructions from instruction"
             " list.\n", tid);
 
-    ListIt end_it;
+    ListIdx end_idx;
 
     bool rob_empty = false;
 
@@ -1563,33 +1580,31 @@ FullO3CPU<Impl>::removeInstsNotInROB(ThreadID tid)
         return;
     } else if (rob.isEmpty(tid)) {
         DPRINTF(O3CPU, "ROB is empty, squashing all insts.\n");
-        end_it = instList.begin();
+        end_idx = instList.front();
         rob_empty = true;
     } else {
-        end_it = (rob.readTailInst(tid))->getInstListIt();
+        end_idx = (rob.readTailInst(tid))->getInstListIdx();
         DPRINTF(O3CPU, "ROB is not empty, squashing insts not in ROB.\n");
     }
 
     removeInstsThisCycle = true;
 
-    ListIt inst_it = instList.end();
-
-    inst_it--;
+    ListIdx inst_idx = instList.back();
 
     // Walk through the instruction list, removing any instructions
-    // that were inserted after the given instruction iterator, end_it.
-    while (inst_it != end_it) {
+    // that were inserted after the given instruction, end_idx.
+    while (inst_idx != end_idx) {
         assert(!instList.empty());
 
-        squashInstIt(inst_it, tid);
+        squashInstAt(inst_idx, tid);
 
-        inst_it--;
+        inst_idx = instList.prev(inst_idx);
     }
 
     // If the ROB was empty, then we actually need to remove the first
     // instruction as well.
     if (rob_empty) {
-        squashInstIt(inst_it, tid);
+        squashInstAt(inst_idx, tid);
     }
 }
 
@@ -1601,21 +1616,19 @@ FullO3CPU<Impl>::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
 
     removeInstsThisCycle = true;
 
-    ListIt inst_iter = instList.end();
-
-    inst_iter--;
+    ListIdx inst_idx = instList.back();
 
     DPRINTF(O3CPU, "Deleting instructions from instruction "
             "list that are from [tid:%i] and above [sn:%lli] (end=%lli).\n",
-            tid, seq_num, (*inst_iter)->seqNum);
+            tid, seq_num, instList[inst_idx]->seqNum);
 
-    while ((*inst_iter)->seqNum > seq_num) {
+    while (instList[inst_idx]->seqNum > seq_num) {
 
-        bool break_loop = (inst_iter == instList.begin());
+        bool break_loop = (inst_idx == instList.front());
 
-        squashInstIt(inst_iter, tid);
+        squashInstAt(inst_idx, tid);
 
-        inst_iter--;
+        inst_idx = instList.prev(inst_idx);
 
         if (break_loop)
             break;
@@ -1624,22 +1637,23 @@ FullO3CPU<Impl>::removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid)
 
 template <class Impl>
 inline void
-FullO3CPU<Impl>::squashInstIt(const ListIt &instIt, ThreadID tid)
+FullO3CPU<Impl>::squashInstAt(ListIdx idx, ThreadID tid)
 {
-    if ((*instIt)->threadNumber == tid) {
+    const DynInstPtr &inst = instList[idx];
+    if (inst->threadNumber == tid) {
         DPRINTF(O3CPU, "Squashing instruction, "
                 "[tid:%i] [sn:%lli] PC %s\n",
-                (*instIt)->threadNumber,
-                (*instIt)->seqNum,
-                (*instIt)->pcState());
+                inst->threadNumber,
+                inst->seqNum,
+                inst->pcState());
 
         // Mark it as squashed.
-        (*instIt)->setSquashed();
+        inst->setSquashed();
 
         // @todo: Formulate a consistent method for deleting
         // instructions from the instruction list
         // Remove the instruction from the list.
-        removeList.push(instIt);
+        removeList.push_back(idx);
     }
 }
 
@@ -1647,17 +1661,21 @@ template <class Impl>
 void
 FullO3CPU<Impl>::cleanUpRemovedInsts()
 {
-    while (!removeList.empty()) {
+    for (ListIdx idx : removeList) {
+        // An instruction may be on the list twice if overlapping
+        // squashes happened in the same cycle.
+        if (!instList[idx])
+            continue;
+
         DPRINTF(O3CPU, "Removing instruction, "
                 "[tid:%i] [sn:%lli] PC %s\n",
-                (*removeList.front())->threadNumber,
-                (*removeList.front())->seqNum,
-                (*removeList.front())->pcState());
-
-        instList.erase(removeList.front());
+                instList[idx]->threadNumber,
+                instList[idx]->seqNum,
+                instList[idx]->pcState());
 
-        removeList.pop();
+        instList.erase(idx);
     }
+    removeList.clear();
 
     removeInstsThisCycle = false;
 }
@@ -1675,17 +1693,18 @@ FullO3CPU<Impl>::dumpInsts()
 {
     int num = 0;
 
-    ListIt inst_list_it = instList.begin();
+    ListIdx inst_idx = instList.front();
 
     cprintf("Dumping Instruction List\n");
 
-    while (inst_list_it != instList.end()) {
+    while (inst_idx != DynInstList<DynInstPtr>::Invalid) {
+        const DynInstPtr &inst = instList[inst_idx];
         cprintf("Instruction:%i\nPC:%#x\n[tid:%i]\n[sn:%lli]\nIssued:%i\n"
                 "Squashed:%i\n\n",
-                num, (*inst_list_it)->instAddr(), (*inst_list_it)->threadNumber,
-                (*inst_list_it)->seqNum, (*inst_list_it)->isIssued(),
-                (*inst_list_it)->isSquashed());
-        inst_list_it++;
+                num, inst->instAddr(), inst->threadNumber,
+                inst->seqNum, inst->isIssued(),
+                inst->isSquashed());
+        inst_idx = instList.next(inst_idx);
         ++num;
     }
 }
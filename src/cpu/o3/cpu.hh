@@ -55,6 +55,7 @@
 #include "config/the_isa.hh"
 #include "cpu/o3/comm.hh"
 #include "cpu/o3/cpu_policy.hh"
+#include "cpu/o3/dyn_inst_list.hh"
 #include "cpu/o3/scoreboard.hh"
 #include "cpu/o3/thread_state.hh"
 #include "cpu/activity.hh"
@@ -107,7 +108,7 @@ class FullO3CPU : public BaseO3CPU
     typedef O3ThreadState<Impl> ImplState;
     typedef O3ThreadState<Impl> Thread;
 
-    typedef typename std::list<DynInstPtr>::iterator ListIt;
+    typedef typename DynInstList<DynInstPtr>::Index ListIdx;
 
     friend class O3ThreadContext<Impl>;
 
@@ -505,7 +506,7 @@ class FullO3CPU : public BaseO3CPU
     /** Function to add instruction onto the head of the list of the
      *  instructions.  Used when new instructions are fetched.
      */
-    ListIt addInst(const DynInstPtr &inst);
+    ListIdx addInst(const DynInstPtr &inst);
 
     /** Function to tell the CPU that an instruction has completed. */
     void instDone(ThreadID tid, const DynInstPtr &inst);
@@ -522,8 +523,8 @@ class FullO3CPU : public BaseO3CPU
     /** Remove all instructions younger than the given sequence number. */
     void removeInstsUntil(const InstSeqNum &seq_num, ThreadID tid);
 
-    /** Removes the instruction pointed to by the iterator. */
-    inline void squashInstIt(const ListIt &instIt, ThreadID tid);
+    /** Removes the instruction at the given index of the list. */
+    inline void squashInstAt(ListIdx idx, ThreadID tid);
 
     /** Cleans up all instructions on the remove list. */
     void cleanUpRemovedInsts();
@@ -538,12 +539,18 @@ class FullO3CPU : public BaseO3CPU
 #endif
 
     /** List of all the instructions in flight. */
-    std::list<DynInstPtr> instList;
+    DynInstList<DynInstPtr> instList;
+
+    /**
+     * Number of instructions to reserve from the allocator at the
+     * first tick, on the thread which then allocates them.
+     */
+    std::size_t instsToReserve;
 
     /** List of all the instructions that will be removed at the end of this
      *  cycle.
      */
-    std::queue<ListIt> removeList;
+    std::vector<ListIdx> removeList;
 
 #ifdef DEBUG
     /** Debug structure to keep track of the sequence numbers still in
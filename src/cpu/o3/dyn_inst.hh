@@ -45,6 +45,7 @@
 #include <array>
 
 #include "arch/isa_traits.hh"
+#include "base/slab_alloc.hh"
 #include "config/the_isa.hh"
 #include "cpu/o3/cpu.hh"
 #include "cpu/o3/isa_specific.hh"
@@ -86,6 +87,16 @@ class BaseO3DynInst : public BaseDynInst<Impl>
 
     ~BaseO3DynInst();
 
+    /**
+     * Instructions are allocated from a per-thread pool rather than
+     * from the heap, as one is created for every fetched instruction,
+     * including those on mispredicted paths.
+     * @{
+     */
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr);
+    /** @} */
+
     /** Executes the instruction.*/
     Fault execute();
 
@@ -426,5 +437,24 @@ class BaseO3DynInst : public BaseDynInst<Impl>
     }
 };
 
+template <class Impl>
+using O3DynInstAllocator =
+    SlabAllocator<BaseO3DynInst<Impl>, sizeof(BaseO3DynInst<Impl>)>;
+
+template <class Impl>
+inline void *
+BaseO3DynInst<Impl>::operator new(std::size_t size)
+{
+    assert(size == sizeof(BaseO3DynInst<Impl>));
+    return O3DynInstAllocator<Impl>::allocate();
+}
+
+template <class Impl>
+inline void
+BaseO3DynInst<Impl>::operator delete(void *ptr)
+{
+    O3DynInstAllocator<Impl>::release(ptr);
+}
+
 #endif // __CPU_O3_ALPHA_DYN_INST_HH__
 
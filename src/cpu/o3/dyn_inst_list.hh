@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_DYN_INST_LIST_HH__
+#define __CPU_O3_DYN_INST_LIST_HH__
+
+#include <cassert>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Doubly linked list of instructions whose nodes are kept in a vector
+ * and linked by index. Nodes of erased instructions are recycled, so
+ * that once the list has grown to the number of instructions in
+ * flight, adding and removing instructions does not allocate memory.
+ * The index of an instruction stays valid until it is erased, even if
+ * the list grows.
+ */
+template <class DynInstPtr>
+class DynInstList
+{
+  public:
+    /** Position of an instruction in the list */
+    typedef int Index;
+
+    /** Index before the first and after the last instruction */
+    static const Index Invalid = -1;
+
+  private:
+    struct Node
+    {
+        DynInstPtr inst;
+        Index prev;
+        Index next;
+    };
+
+    std::vector<Node> nodes;
+
+    Index head;
+    Index tail;
+
+    /** First unused node, the others being linked by their next field */
+    Index freeHead;
+
+    std::size_t _size;
+
+  public:
+    DynInstList()
+        : head(Invalid), tail(Invalid), freeHead(Invalid), _size(0)
+    {}
+
+    /** Make room for a number of instructions. */
+    void
+    reserve(std::size_t count)
+    {
+        if (count <= nodes.size())
+            return;
+        const Index first = nodes.size();
+        nodes.resize(count);
+        for (Index idx = count - 1; idx >= first; --idx) {
+            nodes[idx].next = freeHead;
+            freeHead = idx;
+        }
+    }
+
+    /**
+     * Add an instruction at the end of the list.
+     * @return The index of the instruction.
+     */
+    Index
+    push_back(const DynInstPtr &inst)
+    {
+        if (freeHead == Invalid)
+            reserve(nodes.empty() ? 64 : nodes.size() * 2);
+
+        const Index idx = freeHead;
+        Node &node = nodes[idx];
+        freeHead = node.next;
+
+        node.inst = inst;
+        node.prev = tail;
+        node.next = Invalid;
+        if (tail == Invalid)
+            head = idx;
+        else
+            nodes[tail].next = idx;
+        tail = idx;
+        ++_size;
+        return idx;
+    }
+
+    /** Remove an instruction from the list. */
+    void
+    erase(Index idx)
+    {
+        Node &node = nodes[idx];
+        assert(node.inst);
+
+        if (node.prev == Invalid)
+            head = node.next;
+        else
+            nodes[node.prev].next = node.next;
+        if (node.next == Invalid)
+            tail = node.prev;
+        else
+            nodes[node.next].prev = node.prev;
+
+        node.inst = nullptr;
+        node.next = freeHead;
+        freeHead = idx;
+        --_size;
+    }
+
+    /** Remove all the instructions. */
+    void
+    clear()
+    {
+        while (head != Invalid)
+            erase(head);
+    }
+
+    const DynInstPtr &operator[](Index idx) const { return nodes[idx].inst; }
+
+    /** Index of the oldest instruction, or Invalid if the list is empty */
+    Index front() const { return head; }
+    /** Index of the youngest instruction, or Invalid if the list is empty */
+    Index back() const { return tail; }
+    /** Index of the instruction after another one, or Invalid */
+    Index next(Index idx) const { return nodes[idx].next; }
+    /** Index of the instruction before another one, or Invalid */
+    Index prev(Index idx) const { return nodes[idx].prev; }
+
+    bool empty() const { return _size == 0; }
+    std::size_t size() const { return _size; }
+};
+
+template <class DynInstPtr>
+const typename DynInstList<DynInstPtr>::Index DynInstList<DynInstPtr>::Invalid;
+
+#endif // __CPU_O3_DYN_INST_LIST_HH__
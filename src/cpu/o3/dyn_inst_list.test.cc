@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "cpu/o3/dyn_inst_list.hh"
+
+typedef std::shared_ptr<int> InstPtr;
+typedef DynInstList<InstPtr> List;
+
+/** Values of the instructions of a list, from front to back */
+static std::vector<int>
+contents(const List &list)
+{
+    std::vector<int> values;
+    for (List::Index idx = list.front(); idx != List::Invalid;
+         idx = list.next(idx)) {
+        values.push_back(*list[idx]);
+    }
+    return values;
+}
+
+TEST(DynInstListTest, PushErase)
+{
+    List list;
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(List::Invalid, list.front());
+
+    std::vector<List::Index> idx;
+    for (int i = 0; i < 5; ++i)
+        idx.push_back(list.push_back(std::make_shared<int>(i)));
+    EXPECT_EQ(5, list.size());
+    EXPECT_EQ(std::vector<int>({ 0, 1, 2, 3, 4 }), contents(list));
+
+    // erase from the middle and both ends
+    list.erase(idx[2]);
+    list.erase(idx[0]);
+    list.erase(idx[4]);
+    EXPECT_EQ(std::vector<int>({ 1, 3 }), contents(list));
+    EXPECT_EQ(idx[1], list.front());
+    EXPECT_EQ(idx[3], list.back());
+    EXPECT_EQ(idx[1], list.prev(idx[3]));
+
+    // erased nodes are reused
+    List::Index reused = list.push_back(std::make_shared<int>(5));
+    EXPECT_TRUE(reused == idx[0] || reused == idx[2] || reused == idx[4]);
+    EXPECT_EQ(std::vector<int>({ 1, 3, 5 }), contents(list));
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+    EXPECT_EQ(List::Invalid, list.back());
+}
+
+TEST(DynInstListTest, Grow)
+{
+    // indices stay valid when the list grows beyond its reservation
+    List list;
+    list.reserve(4);
+    std::vector<List::Index> idx;
+    for (int i = 0; i < 1000; ++i)
+        idx.push_back(list.push_back(std::make_shared<int>(i)));
+    for (int i = 0; i < 1000; ++i)
+        EXPECT_EQ(i, *list[idx[i]]);
+
+    // the objects are released once erased
+    std::weak_ptr<int> weak = list[idx[10]];
+    list.erase(idx[10]);
+    EXPECT_TRUE(weak.expired());
+    EXPECT_EQ(999, list.size());
+}
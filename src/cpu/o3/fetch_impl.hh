@@ -629,7 +629,7 @@ DefaultFetch<Impl>::fetchCacheLine(Addr vaddr, ThreadID tid, Addr pc)
     // Setup the memReq to do a read of the first instruction's address.
     // Set the appropriate read size and flags as well.
     // Build request here.
-    RequestPtr mem_req = std::make_shared<Request>(
+    RequestPtr mem_req = new Request(
         fetchBufferBlockPC, fetchBufferSize,
         Request::INST_FETCH, cpu->instMasterId(), pc,
         cpu->thread[tid]->contextId());
@@ -1131,7 +1131,7 @@ DefaultFetch<Impl>::buildInst(ThreadID tid, StaticInstPtr staticInst,
 #endif
 
     // Add instruction to the CPU's list of instructions.
-    instruction->setInstListIt(cpu->addInst(instruction));
+    instruction->setInstListIdx(cpu->addInst(instruction));
 
     // Write the instruction to the first slot in the queue
     // that heads to decode.
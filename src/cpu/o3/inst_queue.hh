@@ -50,6 +50,7 @@
 #include "base/statistics.hh"
 #include "base/types.hh"
 #include "cpu/o3/dep_graph.hh"
+#include "cpu/o3/wakeup_matrix.hh"
 #include "cpu/inst_seq.hh"
 #include "cpu/op_class.hh"
 #include "cpu/timebuf.hh"
@@ -398,6 +399,46 @@ class InstructionQueue
 
     DependencyGraph<DynInstPtr> dependGraph;
 
+    /** Whether the wakeup matrix is used instead of the dependency
+     *  graph, ready queues and age order list.
+     */
+    bool useWakeupMatrix;
+
+    /** Array based dependencies and ready instructions. */
+    WakeupMatrix<DynInstPtr> wakeupMatrix;
+
+    /** Updates the queue read stats for an instruction considered for
+     *  issue.
+     */
+    void countQueueRead(const DynInstPtr &inst);
+
+    /**
+     * Tries to get a FU for an instruction and, if one is available,
+     * issues the instruction to it.
+     * @return Whether the instruction issued.
+     */
+    bool issueToFU(const DynInstPtr &issuing_inst, IssueStruct *i2e_info);
+
+    /** Removes and returns the newest dependent of a register. */
+    DynInstPtr
+    popDependent(PhysRegIndex idx)
+    {
+        return useWakeupMatrix ? wakeupMatrix.pop(idx) : dependGraph.pop(idx);
+    }
+
+    /** Clears the producer of a register, once it has no dependents. */
+    void
+    clearProducer(PhysRegIndex idx)
+    {
+        if (useWakeupMatrix) {
+            assert(wakeupMatrix.empty(idx));
+            wakeupMatrix.clearInst(idx);
+        } else {
+            assert(dependGraph.empty(idx));
+            dependGraph.clearInst(idx);
+        }
+    }
+
     //////////////////////////////////////
     // Various parameters
     //////////////////////////////////////
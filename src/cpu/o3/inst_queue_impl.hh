@@ -87,6 +87,7 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
     : cpu(cpu_ptr),
       iewStage(iew_ptr),
       fuPool(params->fuPool),
+      useWakeupMatrix(params->iqWakeupMatrix),
       iqPolicy(params->smtIQPolicy),
       numEntries(params->numIQEntries),
       totalWidth(params->issueWidth),
@@ -106,7 +107,11 @@ InstructionQueue<Impl>::InstructionQueue(O3CPU *cpu_ptr, IEW *iew_ptr,
 
     //Create an entry for each physical register within the
     //dependency graph.
-    dependGraph.resize(numPhysRegs);
+    if (useWakeupMatrix) {
+        wakeupMatrix.resize(numPhysRegs, numEntries);
+    } else {
+        dependGraph.resize(numPhysRegs);
+    }
 
     // Resize the register scoreboard.
     regScoreboard.resize(numPhysRegs);
@@ -159,6 +164,7 @@ template <class Impl>
 InstructionQueue<Impl>::~InstructionQueue()
 {
     dependGraph.reset();
+    wakeupMatrix.reset();
 #ifdef DEBUG
     cprintf("Nodes traversed: %i, removed: %i\n",
             dependGraph.nodesTraversed, dependGraph.nodesRemoved);
@@ -421,6 +427,7 @@ InstructionQueue<Impl>::resetState()
         queueOnList[i] = false;
         readyIt[i] = listOrder.end();
     }
+    wakeupMatrix.clearReady();
     nonSpecInsts.clear();
     listOrder.clear();
     deferredMemInsts.clear();
@@ -456,7 +463,7 @@ template <class Impl>
 bool
 InstructionQueue<Impl>::isDrained() const
 {
-    bool drained = dependGraph.empty() &&
+    bool drained = dependGraph.empty() && wakeupMatrix.empty() &&
                    instsToExecute.empty() &&
                    wbOutstanding == 0;
     for (ThreadID tid = 0; tid < numThreads; ++tid)
@@ -470,6 +477,7 @@ void
 InstructionQueue<Impl>::drainSanityCheck() const
 {
     assert(dependGraph.empty());
+    assert(wakeupMatrix.empty());
     assert(instsToExecute.empty());
     for (ThreadID tid = 0; tid < numThreads; ++tid)
         memDepUnit[tid].drainSanityCheck();
@@ -559,7 +567,7 @@ template <class Impl>
 bool
 InstructionQueue<Impl>::hasReadyInsts()
 {
-    if (!listOrder.empty()) {
+    if (!listOrder.empty() || wakeupMatrix.numReady()) {
         return true;
     }
 
@@ -765,6 +773,104 @@ InstructionQueue<Impl>::processFUCompletion(const DynInstPtr &inst, int fu_idx)
     instsToExecute.push_back(inst);
 }
 
+template <class Impl>
+void
+InstructionQueue<Impl>::countQueueRead(const DynInstPtr &inst)
+{
+    if (inst->isFloating()) {
+        fpInstQueueReads++;
+    } else if (inst->isVector()) {
+        vecInstQueueReads++;
+    } else {
+        intInstQueueReads++;
+    }
+}
+
+template <class Impl>
+bool
+InstructionQueue<Impl>::issueToFU(const DynInstPtr &issuing_inst,
+                                  IssueStruct *i2e_info)
+{
+    OpClass op_class = issuing_inst->opClass();
+    int idx = FUPool::NoCapableFU;
+    Cycles op_latency = Cycles(1);
+    ThreadID tid = issuing_inst->threadNumber;
+
+    if (op_class != No_OpClass) {
+        idx = fuPool->getUnit(op_class);
+        if (issuing_inst->isFloating()) {
+            fpAluAccesses++;
+        } else if (issuing_inst->isVector()) {
+            vecAluAccesses++;
+        } else {
+            intAluAccesses++;
+        }
+        if (idx > FUPool::NoFreeFU) {
+            op_latency = fuPool->getOpLatency(op_class);
+        }
+    }
+
+    // If we have an instruction that doesn't require a FU, or a
+    // valid FU, then schedule for execution.
+    if (idx == FUPool::NoFreeFU) {
+        statFuBusy[op_class]++;
+        fuBusy[tid]++;
+        return false;
+    }
+
+    if (op_latency == Cycles(1)) {
+        i2e_info->size++;
+        instsToExecute.push_back(issuing_inst);
+
+        // Add the FU onto the list of FU's to be freed next
+        // cycle if we used one.
+        if (idx >= 0)
+            fuPool->freeUnitNextCycle(idx);
+    } else {
+        bool pipelined = fuPool->isPipelined(op_class);
+        // Generate completion event for the FU
+        ++wbOutstanding;
+        FUCompletion *execution = new FUCompletion(issuing_inst,
+                                                   idx, this);
+
+        cpu->schedule(execution,
+                      cpu->clockEdge(Cycles(op_latency - 1)));
+
+        if (!pipelined) {
+            // If FU isn't pipelined, then it must be freed
+            // upon the execution completing.
+            execution->setFreeFU();
+        } else {
+            // Add the FU onto the list of FU's to be freed next cycle.
+            fuPool->freeUnitNextCycle(idx);
+        }
+    }
+
+    DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
+            "[sn:%llu]\n",
+            tid, issuing_inst->pcState(),
+            issuing_inst->seqNum);
+
+    issuing_inst->setIssued();
+
+#if TRACING_ON
+    issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
+#endif
+
+    if (!issuing_inst->isMemRef()) {
+        // Memory instructions can not be freed from the IQ until they
+        // complete.
+        ++freeEntries;
+        count[tid]--;
+        issuing_inst->clearInIQ();
+    } else {
+        memDepUnit[tid].issue(issuing_inst);
+    }
+
+    statIssuedInstType[tid][op_class]++;
+    return true;
+}
+
 // @todo: Figure out a better way to remove the squashed items from the
 // lists.  Checking the top item of each list to see if it's squashed
 // wastes time and forces jumps.
@@ -796,6 +902,39 @@ InstructionQueue<Impl>::scheduleReadyInsts()
     // This will avoid trying to schedule a certain op class if there are no
     // FUs that handle it.
     int total_issued = 0;
+
+    if (useWakeupMatrix) {
+        typedef typename WakeupMatrix<DynInstPtr>::Pick Pick;
+
+        // As with the ready queues, an op class is not considered any
+        // further once its oldest ready instruction could not get a FU.
+        bool fu_busy[Num_OpClasses] = {};
+
+        wakeupMatrix.select([&](const DynInstPtr &issuing_inst) {
+            if (total_issued >= totalWidth)
+                return Pick::Stop;
+
+            OpClass op_class = issuing_inst->opClass();
+            if (fu_busy[op_class])
+                return Pick::Keep;
+
+            countQueueRead(issuing_inst);
+
+            if (issuing_inst->isSquashed()) {
+                ++iqSquashedInstsIssued;
+                return Pick::Take;
+            }
+
+            if (!issueToFU(issuing_inst, i2e_info)) {
+                fu_busy[op_class] = true;
+                return Pick::Keep;
+            }
+
+            ++total_issued;
+            return Pick::Take;
+        });
+    }
+
     ListOrderIt order_it = listOrder.begin();
     ListOrderIt order_end_it = listOrder.end();
 
@@ -806,13 +945,7 @@ InstructionQueue<Impl>::scheduleReadyInsts()
 
         DynInstPtr issuing_inst = readyInsts[op_class].top();
 
-        if (issuing_inst->isFloating()) {
-            fpInstQueueReads++;
-        } else if (issuing_inst->isVector()) {
-            vecInstQueueReads++;
-        } else {
-            intInstQueueReads++;
-        }
+        countQueueRead(issuing_inst);
 
         assert(issuing_inst->seqNum == (*order_it).oldestInst);
 
@@ -833,60 +966,7 @@ InstructionQueue<Impl>::scheduleReadyInsts()
             continue;
         }
 
-        int idx = FUPool::NoCapableFU;
-        Cycles op_latency = Cycles(1);
-        ThreadID tid = issuing_inst->threadNumber;
-
-        if (op_class != No_OpClass) {
-            idx = fuPool->getUnit(op_class);
-            if (issuing_inst->isFloating()) {
-                fpAluAccesses++;
-            } else if (issuing_inst->isVector()) {
-                vecAluAccesses++;
-            } else {
-                intAluAccesses++;
-            }
-            if (idx > FUPool::NoFreeFU) {
-                op_latency = fuPool->getOpLatency(op_class);
-            }
-        }
-
-        // If we have an instruction that doesn't require a FU, or a
-        // valid FU, then schedule for execution.
-        if (idx != FUPool::NoFreeFU) {
-            if (op_latency == Cycles(1)) {
-                i2e_info->size++;
-                instsToExecute.push_back(issuing_inst);
-
-                // Add the FU onto the list of FU's to be freed next
-                // cycle if we used one.
-                if (idx >= 0)
-                    fuPool->freeUnitNextCycle(idx);
-            } else {
-                bool pipelined = fuPool->isPipelined(op_class);
-                // Generate completion event for the FU
-                ++wbOutstanding;
-                FUCompletion *execution = new FUCompletion(issuing_inst,
-                                                           idx, this);
-
-                cpu->schedule(execution,
-                              cpu->clockEdge(Cycles(op_latency - 1)));
-
-                if (!pipelined) {
-                    // If FU isn't pipelined, then it must be freed
-                    // upon the execution completing.
-                    execution->setFreeFU();
-                } else {
-                    // Add the FU onto the list of FU's to be freed next cycle.
-                    fuPool->freeUnitNextCycle(idx);
-                }
-            }
-
-            DPRINTF(IQ, "Thread %i: Issuing instruction PC %s "
-                    "[sn:%llu]\n",
-                    tid, issuing_inst->pcState(),
-                    issuing_inst->seqNum);
-
+        if (issueToFU(issuing_inst, i2e_info)) {
             readyInsts[op_class].pop();
 
             if (!readyInsts[op_class].empty()) {
@@ -896,28 +976,10 @@ InstructionQueue<Impl>::scheduleReadyInsts()
                 queueOnList[op_class] = false;
             }
 
-            issuing_inst->setIssued();
             ++total_issued;
 
-#if TRACING_ON
-            issuing_inst->issueTick = curTick() - issuing_inst->fetchTick;
-#endif
-
-            if (!issuing_inst->isMemRef()) {
-                // Memory instructions can not be freed from the IQ until they
-                // complete.
-                ++freeEntries;
-                count[tid]--;
-                issuing_inst->clearInIQ();
-            } else {
-                memDepUnit[tid].issue(issuing_inst);
-            }
-
             listOrder.erase(order_it++);
-            statIssuedInstType[tid][op_class]++;
         } else {
-            statFuBusy[op_class]++;
-            fuBusy[tid]++;
             ++order_it;
         }
     }
@@ -1047,7 +1109,7 @@ InstructionQueue<Impl>::wakeDependents(const DynInstPtr &completed_inst)
 
         //Go through the dependency chain, marking the registers as
         //ready within the waiting instructions.
-        DynInstPtr dep_inst = dependGraph.pop(dest_reg->flatIndex());
+        DynInstPtr dep_inst = popDependent(dest_reg->flatIndex());
 
         while (dep_inst) {
             DPRINTF(IQ, "Waking up a dependent instruction, [sn:%llu] "
@@ -1061,15 +1123,14 @@ InstructionQueue<Impl>::wakeDependents(const DynInstPtr &completed_inst)
 
             addIfReady(dep_inst);
 
-            dep_inst = dependGraph.pop(dest_reg->flatIndex());
+            dep_inst = popDependent(dest_reg->flatIndex());
 
             ++dependents;
         }
 
         // Reset the head node now that all of its dependents have
         // been woken up.
-        assert(dependGraph.empty(dest_reg->flatIndex()));
-        dependGraph.clearInst(dest_reg->flatIndex());
+        clearProducer(dest_reg->flatIndex());
 
         // Mark the scoreboard as having that register ready.
         regScoreboard[dest_reg->flatIndex()] = true;
@@ -1083,16 +1144,20 @@ InstructionQueue<Impl>::addReadyMemInst(const DynInstPtr &ready_inst)
 {
     OpClass op_class = ready_inst->opClass();
 
-    readyInsts[op_class].push(ready_inst);
+    if (useWakeupMatrix) {
+        wakeupMatrix.setReady(ready_inst);
+    } else {
+        readyInsts[op_class].push(ready_inst);
 
-    // Will need to reorder the list if either a queue is not on the list,
-    // or it has an older instruction than last time.
-    if (!queueOnList[op_class]) {
-        addToOrderList(op_class);
-    } else if (readyInsts[op_class].top()->seqNum  <
-               (*readyIt[op_class]).oldestInst) {
-        listOrder.erase(readyIt[op_class]);
-        addToOrderList(op_class);
+        // Will need to reorder the list if either a queue is not on the
+        // list, or it has an older instruction than last time.
+        if (!queueOnList[op_class]) {
+            addToOrderList(op_class);
+        } else if (readyInsts[op_class].top()->seqNum  <
+                   (*readyIt[op_class]).oldestInst) {
+            listOrder.erase(readyIt[op_class]);
+            addToOrderList(op_class);
+        }
     }
 
     DPRINTF(IQ, "Instruction is ready to issue, putting it onto "
@@ -1288,8 +1353,13 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
 
                     if (!squashed_inst->isReadySrcRegIdx(src_reg_idx) &&
                         !src_reg->isFixedMapping()) {
-                        dependGraph.remove(src_reg->flatIndex(),
-                                           squashed_inst);
+                        if (useWakeupMatrix) {
+                            wakeupMatrix.remove(src_reg->flatIndex(),
+                                                squashed_inst);
+                        } else {
+                            dependGraph.remove(src_reg->flatIndex(),
+                                               squashed_inst);
+                        }
                     }
 
                     ++iqSquashedOperandsExamined;
@@ -1352,8 +1422,7 @@ InstructionQueue<Impl>::doSquash(ThreadID tid)
             if (dest_reg->isFixedMapping()){
                 continue;
             }
-            assert(dependGraph.empty(dest_reg->flatIndex()));
-            dependGraph.clearInst(dest_reg->flatIndex());
+            clearProducer(dest_reg->flatIndex());
         }
         instList[tid].erase(squash_it--);
         ++iqSquashedInstsExamined;
@@ -1389,7 +1458,11 @@ InstructionQueue<Impl>::addToDependents(const DynInstPtr &new_inst)
                         new_inst->pcState(), src_reg->index(),
                         src_reg->className());
 
-                dependGraph.insert(src_reg->flatIndex(), new_inst);
+                if (useWakeupMatrix) {
+                    wakeupMatrix.insert(src_reg->flatIndex(), new_inst);
+                } else {
+                    dependGraph.insert(src_reg->flatIndex(), new_inst);
+                }
 
                 // Change the return value to indicate that something
                 // was added to the dependency graph.
@@ -1430,14 +1503,25 @@ InstructionQueue<Impl>::addToProducers(const DynInstPtr &new_inst)
             continue;
         }
 
-        if (!dependGraph.empty(dest_reg->flatIndex())) {
-            dependGraph.dump();
-            panic("Dependency graph %i (%s) (flat: %i) not empty!",
-                  dest_reg->index(), dest_reg->className(),
-                  dest_reg->flatIndex());
-        }
+        if (useWakeupMatrix) {
+            if (!wakeupMatrix.empty(dest_reg->flatIndex())) {
+                wakeupMatrix.dump();
+                panic("Wakeup matrix %i (%s) (flat: %i) not empty!",
+                      dest_reg->index(), dest_reg->className(),
+                      dest_reg->flatIndex());
+            }
+
+            wakeupMatrix.setInst(dest_reg->flatIndex(), new_inst);
+        } else {
+            if (!dependGraph.empty(dest_reg->flatIndex())) {
+                dependGraph.dump();
+                panic("Dependency graph %i (%s) (flat: %i) not empty!",
+                      dest_reg->index(), dest_reg->className(),
+                      dest_reg->flatIndex());
+            }
 
-        dependGraph.setInst(dest_reg->flatIndex(), new_inst);
+            dependGraph.setInst(dest_reg->flatIndex(), new_inst);
+        }
 
         // Mark the scoreboard to say it's not yet ready.
         regScoreboard[dest_reg->flatIndex()] = false;
@@ -1470,6 +1554,11 @@ InstructionQueue<Impl>::addIfReady(const DynInstPtr &inst)
                 "the ready list, PC %s opclass:%i [sn:%llu].\n",
                 inst->pcState(), op_class, inst->seqNum);
 
+        if (useWakeupMatrix) {
+            wakeupMatrix.setReady(inst);
+            return;
+        }
+
         readyInsts[op_class].push(inst);
 
         // Will need to reorder the list if either a queue is not on the list,
@@ -1501,6 +1590,9 @@ InstructionQueue<Impl>::dumpLists()
         cprintf("\n");
     }
 
+    if (useWakeupMatrix)
+        cprintf("Wakeup matrix ready: %i\n", wakeupMatrix.numReady());
+
     cprintf("Non speculative list size: %i\n", nonSpecInsts.size());
 
     NonSpecMapIt non_spec_it = nonSpecInsts.begin();
@@ -0,0 +1,108 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/o3/lsq_addr_index.hh"
+
+#include <algorithm>
+#include <cassert>
+
+LSQAddrIndex::Range
+LSQAddrIndex::granuleRange(Addr addr, unsigned size) const
+{
+    Range range;
+    range.valid = true;
+    if (size == 0) {
+        range.wide = true;
+        return range;
+    }
+    range.first = addr >> shift;
+    range.last = (addr + size - 1) >> shift;
+    // accesses wrapping around the address space are never indexed
+    range.wide = range.last < range.first ||
+        range.last - range.first >= maxGranules;
+    return range;
+}
+
+void
+LSQAddrIndex::init(std::size_t entries, unsigned _shift)
+{
+    shift = _shift;
+    ranges.assign(entries, Range());
+    granules.clear();
+    wide.clear();
+}
+
+void
+LSQAddrIndex::insert(int idx, Addr addr, unsigned size)
+{
+    remove(idx);
+
+    Range &range = ranges[idx];
+    range = granuleRange(addr, size);
+    if (range.wide) {
+        wide.push_back(idx);
+        return;
+    }
+    for (Addr granule = range.first; granule <= range.last; ++granule)
+        granules[granule].push_back(idx);
+}
+
+namespace
+{
+
+void
+eraseIdx(std::vector<int> &entries, int idx)
+{
+    auto it = std::find(entries.begin(), entries.end(), idx);
+    assert(it != entries.end());
+    *it = entries.back();
+    entries.pop_back();
+}
+
+} // anonymous namespace
+
+void
+LSQAddrIndex::remove(int idx)
+{
+    Range &range = ranges[idx];
+    if (!range.valid)
+        return;
+    range.valid = false;
+
+    if (range.wide) {
+        eraseIdx(wide, idx);
+        return;
+    }
+    for (Addr granule = range.first; granule <= range.last; ++granule) {
+        std::vector<int> *entries = granules.find(granule);
+        assert(entries);
+        eraseIdx(*entries, idx);
+        if (entries->empty())
+            granules.erase(granule);
+    }
+}
@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_LSQ_ADDR_INDEX_HH__
+#define __CPU_O3_LSQ_ADDR_INDEX_HH__
+
+#include <cstddef>
+#include <vector>
+
+#include "base/flat_hash_map.hh"
+#include "base/types.hh"
+
+/**
+ * Index of the entries of a load or store queue by the addresses they
+ * access, which lets the LSQ find the entries that may overlap an
+ * access without scanning the whole queue.
+ *
+ * Addresses are indexed by granules of 2^shift bytes. Entries that
+ * cover too many granules to be indexed by each of them, including
+ * zero-sized ones whose range the LSQ takes to extend below their
+ * address, are kept aside and visited by every lookup. The index is
+ * conservative: every entry overlapping an access is visited, maybe
+ * more than once, along with entries merely sharing a granule with it,
+ * so callers still have to check the actual addresses.
+ */
+class LSQAddrIndex
+{
+  private:
+    /** Granules accessed by an entry */
+    struct Range
+    {
+        Addr first = 0;
+        Addr last = 0;
+        bool valid = false;
+        bool wide = false;
+    };
+
+    /** Largest number of granules an indexed entry can cover */
+    static const Addr maxGranules = 16;
+
+    unsigned shift;
+
+    /** Range of each entry of the queue, by index */
+    std::vector<Range> ranges;
+
+    /** Entries accessing each granule */
+    FlatHashMap<Addr, std::vector<int>> granules;
+
+    /** Entries covering too many granules to be indexed */
+    std::vector<int> wide;
+
+    Range granuleRange(Addr addr, unsigned size) const;
+
+  public:
+    LSQAddrIndex() : shift(0) {}
+
+    /**
+     * Set up the index.
+     *
+     * @param entries Number of entries of the queue
+     * @param shift Log2 of the size of the granules
+     */
+    void init(std::size_t entries, unsigned shift);
+
+    /**
+     * Index the access of an entry, replacing any previous one.
+     *
+     * @param idx Index of the entry in the queue
+     * @param addr First address accessed
+     * @param size Number of bytes accessed
+     */
+    void insert(int idx, Addr addr, unsigned size);
+
+    /** Remove an entry from the index, if it is there */
+    void remove(int idx);
+
+    /**
+     * Call a function on the index of every entry which may overlap
+     * an access.
+     */
+    template <class F>
+    void
+    forEach(Addr addr, unsigned size, F func) const
+    {
+        const Range range = granuleRange(addr, size);
+        if (range.wide) {
+            for (std::size_t idx = 0; idx < ranges.size(); ++idx) {
+                if (ranges[idx].valid)
+                    func(idx);
+            }
+            return;
+        }
+
+        for (Addr granule = range.first; granule <= range.last; ++granule) {
+            if (const std::vector<int> *entries = granules.find(granule)) {
+                for (int idx : *entries)
+                    func(idx);
+            }
+        }
+        for (int idx : wide)
+            func(idx);
+    }
+};
+
+#endif // __CPU_O3_LSQ_ADDR_INDEX_HH__
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <set>
+#include <vector>
+
+#include "cpu/o3/lsq_addr_index.hh"
+
+namespace
+{
+
+std::set<int>
+lookup(const LSQAddrIndex &index, Addr addr, unsigned size)
+{
+    std::set<int> found;
+    index.forEach(addr, size, [&](int idx) { found.insert(idx); });
+    return found;
+}
+
+} // anonymous namespace
+
+TEST(LSQAddrIndexTest, InsertRemove)
+{
+    LSQAddrIndex index;
+    index.init(8, 6);
+    EXPECT_TRUE(lookup(index, 0x1000, 8).empty());
+
+    index.insert(1, 0x1000, 8);
+    index.insert(2, 0x107c, 8);
+    index.insert(3, 0x2000, 4);
+    EXPECT_EQ(std::set<int>({ 1 }), lookup(index, 0x1020, 4));
+    // the second entry straddles two granules
+    EXPECT_EQ(std::set<int>({ 2 }), lookup(index, 0x1078, 2));
+    EXPECT_EQ(std::set<int>({ 2 }), lookup(index, 0x1080, 1));
+    EXPECT_EQ(std::set<int>({ 1, 2 }), lookup(index, 0x1030, 0x20));
+
+    // inserting an entry again replaces its previous access
+    index.insert(1, 0x2004, 4);
+    EXPECT_TRUE(lookup(index, 0x1000, 8).empty());
+    EXPECT_EQ(std::set<int>({ 1, 3 }), lookup(index, 0x2000, 64));
+
+    index.remove(3);
+    index.remove(3);
+    EXPECT_EQ(std::set<int>({ 1 }), lookup(index, 0x2000, 64));
+}
+
+TEST(LSQAddrIndexTest, WideAccesses)
+{
+    LSQAddrIndex index;
+    index.init(8, 4);
+    index.insert(0, 0x1000, 4);
+    // zero-sized and very large accesses are seen by every lookup
+    index.insert(1, 0x8000, 0);
+    index.insert(2, 0x9000, 1024);
+    EXPECT_EQ(std::set<int>({ 1, 2 }), lookup(index, 0x4000, 4));
+    // and see every entry
+    EXPECT_EQ(std::set<int>({ 0, 1, 2 }), lookup(index, 0x4000, 0));
+    EXPECT_EQ(std::set<int>({ 0, 1, 2 }), lookup(index, ~Addr(0), 2));
+
+    index.remove(1);
+    index.remove(2);
+    EXPECT_TRUE(lookup(index, 0x4000, 4).empty());
+}
+
+TEST(LSQAddrIndexTest, FindsAllOverlaps)
+{
+    const int entries = 64;
+    LSQAddrIndex index;
+    index.init(entries, 6);
+    std::vector<std::pair<Addr, unsigned>> accesses(entries);
+    std::vector<bool> valid(entries, false);
+    std::mt19937_64 rng(0);
+
+    for (int i = 0; i < 20000; ++i) {
+        const int idx = rng() % entries;
+        if (rng() % 3 == 0) {
+            index.remove(idx);
+            valid[idx] = false;
+        } else {
+            accesses[idx] = { rng() % 4096, 1 + rng() % 64 };
+            index.insert(idx, accesses[idx].first, accesses[idx].second);
+            valid[idx] = true;
+        }
+
+        const Addr addr = rng() % 4096;
+        const unsigned size = 1 + rng() % 64;
+        std::set<int> found = lookup(index, addr, size);
+        for (int e = 0; e < entries; ++e) {
+            const bool overlaps = valid[e] &&
+                accesses[e].first < addr + size &&
+                addr < accesses[e].first + accesses[e].second;
+            if (overlaps) {
+                ASSERT_EQ(1, found.count(e));
+            }
+            if (!valid[e]) {
+                ASSERT_EQ(0, found.count(e));
+            }
+        }
+    }
+}
@@ -46,6 +46,7 @@
 #include <cstring>
 #include <map>
 #include <queue>
+#include <vector>
 
 #include "arch/generic/debugfaults.hh"
 #include "arch/generic/vec_reg.hh"
@@ -53,6 +54,7 @@
 #include "arch/locked_mem.hh"
 #include "config/the_isa.hh"
 #include "cpu/inst_seq.hh"
+#include "cpu/o3/lsq_addr_index.hh"
 #include "cpu/timebuf.hh"
 #include "debug/LSQUnit.hh"
 #include "mem/packet.hh"
@@ -256,11 +258,9 @@ class LSQUnit
     /** Check for ordering violations in the LSQ. For a store squash if we
      * ever find a conflicting load. For a load, only squash if we
      * an external snoop invalidate has been seen for that load address
-     * @param load_idx index to start checking at
-     * @param inst the instruction to check
+     * @param inst the instruction to check against the younger loads
      */
-    Fault checkViolations(typename LoadQueue::iterator& loadIt,
-            const DynInstPtr& inst);
+    Fault checkViolations(const DynInstPtr& inst);
 
     /** Check if an incoming invalidate hits in the lsq on a load
      * that might have issued out of order wrt another load beacuse
@@ -482,6 +482,15 @@ class LSQUnit
     LoadQueue loadQueue;
 
   private:
+    /** Loads with a valid address, by the addresses they access. */
+    LSQAddrIndex loadIndex;
+
+    /** Stores with data, by the addresses they access. */
+    LSQAddrIndex storeIndex;
+
+    /** Entries found in an index, reused between lookups. */
+    std::vector<int> indexHits;
+
     /** The number of places to shift addresses in the LSQ before checking
      * for dependency violations
      */
@@ -624,6 +633,10 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
 
     assert(!load_inst->isExecuted());
 
+    // The address of the load was just computed, younger stores need
+    // to find it when checking for violations.
+    loadIndex.insert(load_idx, load_inst->effAddr, load_inst->effSize);
+
     // Make sure this isn't a strictly ordered load
     // A bit of a hackish way to get strictly ordered accesses to work
     // only if they're at the head of the LSQ and are ready to commit
@@ -680,13 +693,27 @@ LSQUnit<Impl>::read(LSQRequest *req, int load_idx)
         return NoFault;
     }
 
-    // Check the SQ for any previous stores that might lead to forwarding
-    auto store_it = load_inst->sqIt;
-    assert (store_it >= storeWBIt);
-    // End once we've reached the top of the LSQ
-    while (store_it != storeWBIt) {
-        // Move the index to one younger
-        store_it--;
+    // Check the SQ for any previous stores that might lead to forwarding.
+    // Only the stores overlapping the load can, look at the ones between
+    // the top of the LSQ and the load from the youngest to the oldest.
+    assert(load_inst->sqIt >= storeWBIt);
+    indexHits.clear();
+    storeIndex.forEach(req->mainRequest()->getVaddr(),
+                       req->mainRequest()->getSize(), [&](int idx) {
+        if (storeQueue[idx].instruction()->seqNum < load_inst->seqNum &&
+            storeQueue.getIterator(idx) >= storeWBIt) {
+            indexHits.push_back(idx);
+        }
+    });
+    std::sort(indexHits.begin(), indexHits.end(), [this](int a, int b) {
+        return storeQueue[a].instruction()->seqNum >
+            storeQueue[b].instruction()->seqNum;
+    });
+    indexHits.erase(std::unique(indexHits.begin(), indexHits.end()),
+                    indexHits.end());
+
+    for (int idx : indexHits) {
+        auto store_it = storeQueue.getIterator(idx);
         assert(store_it->valid());
         assert(store_it->instruction()->seqNum < load_inst->seqNum);
         int store_size = store_it->size();
@@ -879,6 +906,12 @@ LSQUnit<Impl>::write(LSQRequest *req, uint8_t *data, int store_idx)
     storeQueue[store_idx].setRequest(req);
     unsigned size = req->_size;
     storeQueue[store_idx].size() = size;
+    if (size) {
+        storeIndex.insert(store_idx,
+                          storeQueue[store_idx].instruction()->effAddr, size);
+    } else {
+        storeIndex.remove(store_idx);
+    }
     bool store_no_data =
         req->mainRequest()->getFlags() & Request::STORE_NO_DATA;
     storeQueue[store_idx].isAllZeros() = store_no_data;
@@ -45,6 +45,7 @@
 
 #include "arch/generic/debugfaults.hh"
 #include "arch/locked_mem.hh"
+#include "base/intmath.hh"
 #include "base/str.hh"
 #include "config/the_isa.hh"
 #include "cpu/checker/cpu.hh"
@@ -166,6 +167,13 @@ LSQUnit<Impl>::init(O3CPU *cpu_ptr, IEW *iew_ptr, DerivO3CPUParams *params,
     checkLoads = params->LSQCheckLoads;
     needsTSO = params->needsTSO;
 
+    // The granules of the index must be at least as large as those
+    // compared when checking for violations.
+    const unsigned index_shift =
+        std::max<unsigned>(depCheckShift, floorLog2(cpu->cacheLineSize()));
+    loadIndex.init(loadQueue.capacity(), index_shift);
+    storeIndex.init(storeQueue.capacity(), index_shift);
+
     resetState();
 }
 
@@ -446,8 +454,7 @@ LSQUnit<Impl>::checkSnoop(PacketPtr pkt)
 
 template <class Impl>
 Fault
-LSQUnit<Impl>::checkViolations(typename LoadQueue::iterator& loadIt,
-        const DynInstPtr& inst)
+LSQUnit<Impl>::checkViolations(const DynInstPtr& inst)
 {
     Addr inst_eff_addr1 = inst->effAddr >> depCheckShift;
     Addr inst_eff_addr2 = (inst->effAddr + inst->effSize - 1) >> depCheckShift;
@@ -457,12 +464,24 @@ LSQUnit<Impl>::checkViolations(typename LoadQueue::iterator& loadIt,
      * all instructions that will execute before the store writes back. Thus,
      * like the implementation that came before it, we're overly conservative.
      */
-    while (loadIt != loadQueue.end()) {
-        DynInstPtr ld_inst = loadIt->instruction();
-        if (!ld_inst->effAddrValid() || ld_inst->strictlyOrdered()) {
-            ++loadIt;
+    // Only the loads accessing the same granules as the instruction
+    // can conflict with it, look at the younger ones in program order.
+    indexHits.clear();
+    loadIndex.forEach(inst->effAddr, inst->effSize, [&](int idx) {
+        if (loadQueue[idx].instruction()->seqNum > inst->seqNum)
+            indexHits.push_back(idx);
+    });
+    std::sort(indexHits.begin(), indexHits.end(), [this](int a, int b) {
+        return loadQueue[a].instruction()->seqNum <
+            loadQueue[b].instruction()->seqNum;
+    });
+    indexHits.erase(std::unique(indexHits.begin(), indexHits.end()),
+                    indexHits.end());
+
+    for (int idx : indexHits) {
+        DynInstPtr ld_inst = loadQueue[idx].instruction();
+        if (!ld_inst->effAddrValid() || ld_inst->strictlyOrdered())
             continue;
-        }
 
         Addr ld_eff_addr1 = ld_inst->effAddr >> depCheckShift;
         Addr ld_eff_addr2 =
@@ -516,8 +535,6 @@ LSQUnit<Impl>::checkViolations(typename LoadQueue::iterator& loadIt,
                     inst->seqNum, ld_inst->seqNum, ld_eff_addr1);
             }
         }
-
-        ++loadIt;
     }
     return NoFault;
 }
@@ -581,13 +598,8 @@ LSQUnit<Impl>::executeLoad(const DynInstPtr &inst)
         iewStage->instToCommit(inst);
         iewStage->activityThisCycle();
     } else {
-        if (inst->effAddrValid()) {
-            auto it = inst->lqIt;
-            ++it;
-
-            if (checkLoads)
-                return checkViolations(it, inst);
-        }
+        if (inst->effAddrValid() && checkLoads)
+            return checkViolations(inst);
     }
 
     return load_fault;
@@ -608,10 +620,6 @@ LSQUnit<Impl>::executeStore(const DynInstPtr &store_inst)
 
     assert(!store_inst->isSquashed());
 
-    // Check the recently completed loads to see if any match this store's
-    // address.  If so, then we have a memory ordering violation.
-    typename LoadQueue::iterator loadIt = store_inst->lqIt;
-
     Fault store_fault = store_inst->initiateAcc();
 
     if (store_inst->isTranslationDelayed() &&
@@ -642,7 +650,9 @@ LSQUnit<Impl>::executeStore(const DynInstPtr &store_inst)
         ++storesToWB;
     }
 
-    return checkViolations(loadIt, store_inst);
+    // Check the recently completed loads to see if any match this store's
+    // address.  If so, then we have a memory ordering violation.
+    return checkViolations(store_inst);
 
 }
 
@@ -655,6 +665,7 @@ LSQUnit<Impl>::commitLoad()
     DPRINTF(LSQUnit, "Committing head load instruction, PC %s\n",
             loadQueue.front().instruction()->pcState());
 
+    loadIndex.remove(loadQueue.head());
     loadQueue.front().clear();
     loadQueue.pop_front();
 
@@ -863,6 +874,7 @@ LSQUnit<Impl>::squash(const InstSeqNum &squashed_num)
 
         // Clear the smart pointer to make sure it is decremented.
         loadQueue.back().instruction()->setSquashed();
+        loadIndex.remove(loadQueue.tail());
         loadQueue.back().clear();
 
         --loads;
@@ -902,6 +914,7 @@ LSQUnit<Impl>::squash(const InstSeqNum &squashed_num)
         // Must delete request now that it wasn't handed off to
         // memory.  This is quite ugly.  @todo: Figure out the proper
         // place to really handle request deletes.
+        storeIndex.remove(storeQueue.tail());
         storeQueue.back().clear();
         --stores;
 
@@ -1003,6 +1016,7 @@ LSQUnit<Impl>::completeStore(typename StoreQueue::iterator store_idx)
     DynInstPtr store_inst = store_idx->instruction();
     if (store_idx == storeQueue.begin()) {
         do {
+            storeIndex.remove(storeQueue.head());
             storeQueue.front().clear();
             storeQueue.pop_front();
             --stores;
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_O3_WAKEUP_MATRIX_HH__
+#define __CPU_O3_WAKEUP_MATRIX_HH__
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "base/bitfield.hh"
+#include "base/cprintf.hh"
+#include "cpu/inst_seq.hh"
+
+/**
+ * Array based alternative to the dependency graph and ready queues of
+ * the instruction queue, closer to the wakeup and select logic of a
+ * real issue queue.
+ *
+ * The consumers of each physical register are kept in a vector which
+ * keeps its storage once the register has been written, so that
+ * tracking dependencies does not allocate memory in steady state. Like
+ * the dependency graph, the producer of each register is recorded
+ * along with its consumers, and consumers are woken newest first.
+ *
+ * Ready instructions occupy the slots of a table, whose occupancy is
+ * kept in a bitmap. Selection goes through the occupied slots oldest
+ * first, which issues instructions in the same order as the per op
+ * class ready queues of the instruction queue.
+ */
+template <class DynInstPtr>
+class WakeupMatrix
+{
+  public:
+    /** What to do with an instruction visited by select() */
+    enum class Pick
+    {
+        /** Leave the instruction ready */
+        Keep,
+        /** Remove the instruction from the ready instructions */
+        Take,
+        /** Leave the instruction ready and stop the selection */
+        Stop
+    };
+
+  private:
+    /** Producer and consumers of each register */
+    std::vector<DynInstPtr> producers;
+    std::vector<std::vector<DynInstPtr>> consumers;
+
+    /** Total number of consumers */
+    std::size_t numConsumers;
+
+    /** Ready instruction in each slot, and its sequence number */
+    std::vector<DynInstPtr> readyInsts;
+    std::vector<InstSeqNum> readySeqNums;
+
+    /** Bitmap of the occupied slots */
+    std::vector<uint64_t> readyBits;
+
+    /** Slots which are not occupied */
+    std::vector<int> freeSlots;
+
+    /** Occupied slots, sorted by age while selecting */
+    std::vector<std::pair<InstSeqNum, int>> order;
+
+    /** Add a word worth of slots to the ready table */
+    void
+    growReady()
+    {
+        const int first = readyInsts.size();
+        readyInsts.resize(first + 64);
+        readySeqNums.resize(first + 64);
+        readyBits.push_back(0);
+        for (int slot = first + 63; slot >= first; --slot)
+            freeSlots.push_back(slot);
+    }
+
+  public:
+    WakeupMatrix() : numConsumers(0) {}
+
+    /**
+     * Size the matrix.
+     *
+     * @param num_regs Number of physical registers
+     * @param num_entries Expected number of ready instructions, which
+     * is only a hint as the ready table grows when needed
+     */
+    void
+    resize(int num_regs, int num_entries)
+    {
+        producers.resize(num_regs);
+        consumers.resize(num_regs);
+        while (readyInsts.size() < (std::size_t)num_entries)
+            growReady();
+    }
+
+    /** Clear all of the dependencies and ready instructions. */
+    void
+    reset()
+    {
+        for (std::size_t reg = 0; reg < producers.size(); ++reg) {
+            producers[reg] = nullptr;
+            consumers[reg].clear();
+        }
+        numConsumers = 0;
+        clearReady();
+    }
+
+    /** Clear the ready instructions. */
+    void
+    clearReady()
+    {
+        freeSlots.clear();
+        for (int w = readyBits.size() - 1; w >= 0; --w) {
+            readyBits[w] = 0;
+            for (int slot = w * 64 + 63; slot >= w * 64; --slot) {
+                readyInsts[slot] = nullptr;
+                freeSlots.push_back(slot);
+            }
+        }
+    }
+
+    /** Sets the producing instruction of a given register. */
+    void
+    setInst(int reg, const DynInstPtr &inst)
+    {
+        producers[reg] = inst;
+    }
+
+    /** Clears the producing instruction. */
+    void clearInst(int reg) { producers[reg] = nullptr; }
+
+    /** Makes an instruction dependent on a register. */
+    void
+    insert(int reg, const DynInstPtr &inst)
+    {
+        consumers[reg].push_back(inst);
+        ++numConsumers;
+    }
+
+    /** Removes an instruction from the consumers of a register. */
+    void
+    remove(int reg, const DynInstPtr &inst)
+    {
+        std::vector<DynInstPtr> &list = consumers[reg];
+        auto it = std::find(list.begin(), list.end(), inst);
+        if (it != list.end()) {
+            list.erase(it);
+            --numConsumers;
+        }
+    }
+
+    /** Removes and returns the newest consumer of a register. */
+    DynInstPtr
+    pop(int reg)
+    {
+        std::vector<DynInstPtr> &list = consumers[reg];
+        if (list.empty())
+            return nullptr;
+        DynInstPtr inst = std::move(list.back());
+        list.pop_back();
+        --numConsumers;
+        return inst;
+    }
+
+    /** Checks if no instruction depends on any register. */
+    bool empty() const { return numConsumers == 0; }
+
+    /** Checks if there are any consumers of a register. */
+    bool empty(int reg) const { return consumers[reg].empty(); }
+
+    /** Marks an instruction as ready to issue. */
+    void
+    setReady(const DynInstPtr &inst)
+    {
+        if (freeSlots.empty())
+            growReady();
+        const int slot = freeSlots.back();
+        freeSlots.pop_back();
+        readyInsts[slot] = inst;
+        readySeqNums[slot] = inst->seqNum;
+        readyBits[slot / 64] |= (uint64_t)1 << (slot % 64);
+    }
+
+    /** Number of instructions ready to issue. */
+    std::size_t
+    numReady() const
+    {
+        return readyInsts.size() - freeSlots.size();
+    }
+
+    /**
+     * Visit the ready instructions, oldest first, and remove the ones
+     * the function takes.
+     *
+     * @param func Function called on each ready instruction, returning
+     * what to do with it
+     */
+    template <class F>
+    void
+    select(F func)
+    {
+        order.clear();
+        for (std::size_t w = 0; w < readyBits.size(); ++w) {
+            for (uint64_t bits = readyBits[w]; bits; bits &= bits - 1) {
+                const int slot = w * 64 + ctz64(bits);
+                order.emplace_back(readySeqNums[slot], slot);
+            }
+        }
+        std::sort(order.begin(), order.end());
+
+        for (const auto &entry : order) {
+            const int slot = entry.second;
+            const Pick pick = func(readyInsts[slot]);
+            if (pick == Pick::Stop)
+                break;
+            if (pick == Pick::Take) {
+                readyInsts[slot] = nullptr;
+                readyBits[slot / 64] &= ~((uint64_t)1 << (slot % 64));
+                freeSlots.push_back(slot);
+            }
+        }
+    }
+
+    /** Debugging function to dump out the matrix. */
+    void
+    dump() const
+    {
+        for (std::size_t reg = 0; reg < producers.size(); ++reg) {
+            if (producers[reg]) {
+                cprintf("wakeupMatrix[%i]: producer: %s [sn:%lli] "
+                        "consumer: ", reg, producers[reg]->pcState(),
+                        producers[reg]->seqNum);
+            } else {
+                cprintf("wakeupMatrix[%i]: No producer. consumer: ", reg);
+            }
+            for (const auto &inst : consumers[reg])
+                cprintf("%s [sn:%lli] ", inst->pcState(), inst->seqNum);
+            cprintf("\n");
+        }
+        cprintf("Ready instructions: %i\n", numReady());
+    }
+};
+
+#endif // __CPU_O3_WAKEUP_MATRIX_HH__
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <vector>
+
+#include "cpu/o3/wakeup_matrix.hh"
+
+namespace
+{
+
+struct Inst
+{
+    InstSeqNum seqNum;
+    Inst(InstSeqNum seq_num) : seqNum(seq_num) {}
+};
+
+typedef std::shared_ptr<Inst> InstPtr;
+typedef WakeupMatrix<InstPtr>::Pick Pick;
+
+} // anonymous namespace
+
+TEST(WakeupMatrixTest, Consumers)
+{
+    WakeupMatrix<InstPtr> matrix;
+    matrix.resize(8, 4);
+    EXPECT_TRUE(matrix.empty());
+
+    auto producer = std::make_shared<Inst>(1);
+    auto a = std::make_shared<Inst>(2);
+    auto b = std::make_shared<Inst>(3);
+    auto c = std::make_shared<Inst>(4);
+    matrix.setInst(5, producer);
+    matrix.insert(5, a);
+    matrix.insert(5, b);
+    matrix.insert(5, c);
+    matrix.insert(6, c);
+    EXPECT_FALSE(matrix.empty());
+    EXPECT_FALSE(matrix.empty(5));
+    EXPECT_TRUE(matrix.empty(4));
+
+    // consumers are woken newest first, as with the dependency graph
+    matrix.remove(5, b);
+    EXPECT_EQ(c, matrix.pop(5));
+    EXPECT_EQ(a, matrix.pop(5));
+    EXPECT_EQ(nullptr, matrix.pop(5));
+    EXPECT_TRUE(matrix.empty(5));
+    matrix.clearInst(5);
+
+    EXPECT_FALSE(matrix.empty());
+    matrix.remove(6, c);
+    EXPECT_TRUE(matrix.empty());
+}
+
+TEST(WakeupMatrixTest, SelectOldestFirst)
+{
+    WakeupMatrix<InstPtr> matrix;
+    matrix.resize(8, 4);
+
+    // more ready instructions than the hint, so that the table grows
+    std::vector<InstSeqNum> order;
+    for (InstSeqNum seq_num : { 70, 10, 40, 100, 20 }) {
+        for (int i = 0; i < 30; ++i)
+            matrix.setReady(std::make_shared<Inst>(seq_num + i));
+    }
+    EXPECT_EQ(150, matrix.numReady());
+
+    // take the odd ones, and stop after seeing 100 instructions
+    int seen = 0;
+    matrix.select([&](const InstPtr &inst) {
+        if (seen++ == 100)
+            return Pick::Stop;
+        order.push_back(inst->seqNum);
+        return inst->seqNum % 2 ? Pick::Take : Pick::Keep;
+    });
+    ASSERT_EQ(100, order.size());
+    for (std::size_t i = 1; i < order.size(); ++i)
+        EXPECT_LE(order[i - 1], order[i]);
+    EXPECT_EQ(100, matrix.numReady());
+
+    order.clear();
+    matrix.select([&](const InstPtr &inst) {
+        order.push_back(inst->seqNum);
+        return Pick::Take;
+    });
+    EXPECT_EQ(100, order.size());
+    EXPECT_EQ(10, order.front());
+    EXPECT_EQ(0, matrix.numReady());
+
+    matrix.setReady(std::make_shared<Inst>(5));
+    matrix.clearReady();
+    EXPECT_EQ(0, matrix.numReady());
+}
@@ -59,6 +59,13 @@ class AtomicSimpleCPU(BaseSimpleCPU):
     width = Param.Int(1, "CPU width")
     simulate_data_stalls = Param.Bool(False, "Simulate dcache stall cycles")
     simulate_inst_stalls = Param.Bool(False, "Simulate icache stall cycles")
+    use_backdoors = Param.Bool(False, "Access memory through back doors "
+        "when no cache needs to observe the accesses (the accesses then "
+        "take no time and are not seen by the memory system)")
+    translation_cache = Param.Bool(False, "Cache decoded instructions and "
+        "execute them again without fetching them (instructions taken "
+        "from the cache don't access the ITB or the icache, which is "
+        "meant for fast-forwarding)")
 
     def addSimPointProbe(self, interval):
         simpoint = SimPoint()
@@ -80,16 +80,33 @@ AtomicSimpleCPU::AtomicSimpleCPU(AtomicSimpleCPUParams *p)
       width(p->width), locked(false),
       simulate_data_stalls(p->simulate_data_stalls),
       simulate_inst_stalls(p->simulate_inst_stalls),
+      useBackdoors(p->use_backdoors), fetchPaddr(0),
+      instBackdoor(nullptr), dataBackdoor(nullptr),
       icachePort(name() + ".icache_port", this),
       dcachePort(name() + ".dcache_port", this),
       dcache_access(false), dcache_latency(0),
       ppCommit(nullptr)
 {
     _status = Idle;
-    ifetch_req = std::make_shared<Request>();
-    data_read_req = std::make_shared<Request>();
-    data_write_req = std::make_shared<Request>();
-    data_amo_req = std::make_shared<Request>();
+    ifetch_req = new Request();
+    data_read_req = new Request();
+    data_write_req = new Request();
+    data_amo_req = new Request();
+
+    if (p->translation_cache) {
+        fatal_if(simulate_inst_stalls,
+                 "%s: The translation cache can't simulate icache stalls.",
+                 name());
+        if (numThreads > 1) {
+            warn("%s: The translation cache only supports a single "
+                 "thread, disabling it.", name());
+        } else {
+            translationCache.reset(new TranslationCache(
+                [this](Addr paddr, std::size_t size, uint8_t *data) {
+                    readTranslatedInsts(paddr, size, data);
+                }));
+        }
+    }
 }
 
 
@@ -150,6 +167,15 @@ AtomicSimpleCPU::drainResume()
     DPRINTF(SimpleCPU, "Resume\n");
     verifyMemoryMode();
 
+    // The memory mode or the memory system may have changed while
+    // drained, get new back doors when needed.
+    dropBackdoors();
+
+    // Memory may have been written behind the CPU's back, e.g. when
+    // restoring a checkpoint.
+    if (translationCache)
+        translationCache->flush();
+
     assert(!threadContexts.empty());
 
     _status = BaseSimpleCPU::Idle;
@@ -195,6 +221,10 @@ AtomicSimpleCPU::switchOut()
 {
     BaseSimpleCPU::switchOut();
 
+    dropBackdoors();
+    if (translationCache)
+        translationCache->flush();
+
     assert(!tickEvent.scheduled());
     assert(_status == BaseSimpleCPU::Running || _status == Idle);
     assert(isCpuDrained());
@@ -206,6 +236,9 @@ AtomicSimpleCPU::takeOverFrom(BaseCPU *oldCPU)
 {
     BaseSimpleCPU::takeOverFrom(oldCPU);
 
+    if (translationCache)
+        translationCache->flush();
+
     // The tick event should have been descheduled by drain()
     assert(!tickEvent.scheduled());
 }
@@ -274,7 +307,87 @@ AtomicSimpleCPU::suspendContext(ThreadID thread_num)
 Tick
 AtomicSimpleCPU::sendPacket(MasterPort &port, const PacketPtr &pkt)
 {
-    return port.sendAtomic(pkt);
+    if (!useBackdoors)
+        return port.sendAtomic(pkt);
+
+    MemBackdoorPtr &backdoor =
+        &port == &icachePort ? instBackdoor : dataBackdoor;
+    if (backdoor && accessBackdoor(backdoor, pkt))
+        return 0;
+
+    MemBackdoorPtr new_backdoor = nullptr;
+    Tick latency = port.sendAtomicBackdoor(pkt, new_backdoor);
+    if (new_backdoor && new_backdoor != backdoor) {
+        DPRINTF(SimpleCPU, "Got back door for %s through %s\n",
+                new_backdoor->range().to_string(), port.name());
+        backdoor = new_backdoor;
+        // The callback stays registered when the back door is dropped,
+        // so only register one the first time the back door is seen.
+        if (watchedBackdoors.insert(backdoor).second) {
+            backdoor->addInvalidationCallback(
+                [this](const MemBackdoor &bd) {
+                    watchedBackdoors.erase(&bd);
+                    if (instBackdoor == &bd)
+                        instBackdoor = nullptr;
+                    if (dataBackdoor == &bd)
+                        dataBackdoor = nullptr;
+                });
+        }
+    }
+    return latency;
+}
+
+bool
+AtomicSimpleCPU::accessBackdoor(MemBackdoorPtr backdoor, const PacketPtr &pkt)
+{
+    const RequestPtr &req = pkt->req;
+
+    // Only plain reads and writes can bypass the memory system,
+    // anything with side effects has to be seen by the memory.
+    if ((pkt->cmd != MemCmd::ReadReq && pkt->cmd != MemCmd::WriteReq) ||
+        req->isUncacheable() || req->isStrictlyOrdered() ||
+        req->isLLSC() || req->isMasked()) {
+        return false;
+    }
+
+    const AddrRange &range = backdoor->range();
+    const Addr addr = pkt->getAddr();
+    if (!range.contains(addr) || !range.contains(addr + pkt->getSize() - 1))
+        return false;
+
+    uint8_t *host_addr = backdoor->ptr() + (addr - range.start());
+    if (pkt->isRead()) {
+        if (!backdoor->readable())
+            return false;
+        pkt->setData(host_addr);
+    } else {
+        if (!backdoor->writeable())
+            return false;
+        pkt->writeData(host_addr);
+    }
+    pkt->makeResponse();
+
+    return true;
+}
+
+void
+AtomicSimpleCPU::readTranslatedInsts(Addr paddr, std::size_t size,
+                                     uint8_t *data)
+{
+    RequestPtr req =
+        new Request(paddr, size, Request::INST_FETCH, instMasterId());
+    Packet pkt(req, MemCmd::ReadReq);
+    pkt.dataStatic(data);
+
+    if (!instBackdoor || !accessBackdoor(instBackdoor, &pkt))
+        icachePort.sendFunctional(&pkt);
+}
+
+void
+AtomicSimpleCPU::dropBackdoors()
+{
+    instBackdoor = nullptr;
+    dataBackdoor = nullptr;
 }
 
 Tick
@@ -302,6 +415,7 @@ AtomicSimpleCPU::AtomicCPUDPort::recvAtomicSnoop(PacketPtr pkt)
         for (auto &t_info : cpu->threadInfo) {
             TheISA::handleLockedSnoop(t_info->thread, pkt, cacheBlockMask);
         }
+        cpu->invalidateTranslations(pkt);
     }
 
     return 0;
@@ -329,6 +443,10 @@ AtomicSimpleCPU::AtomicCPUDPort::recvFunctionalSnoop(PacketPtr pkt)
             TheISA::handleLockedSnoop(t_info->thread, pkt, cacheBlockMask);
         }
     }
+
+    // functional writes, e.g. loading a program, may overwrite code
+    if (pkt->isInvalidate() || pkt->isWrite())
+        cpu->invalidateTranslations(pkt);
 }
 
 bool
@@ -518,6 +636,7 @@ AtomicSimpleCPU::writeMem(uint8_t *data, unsigned size, Addr addr,
 
                     // Notify other threads on this CPU of write
                     threadSnoop(&pkt, curThread);
+                    invalidateTranslations(&pkt);
                 }
                 dcache_access = true;
                 assert(!pkt.isError());
@@ -610,6 +729,7 @@ AtomicSimpleCPU::amoMem(Addr addr, uint8_t* data, unsigned size,
             dcache_latency += req->localAccessor(thread->getTC(), &pkt);
         else {
             dcache_latency += sendPacket(dcachePort, &pkt);
+            invalidateTranslations(&pkt);
         }
 
         dcache_access = true;
@@ -654,8 +774,14 @@ AtomicSimpleCPU::tick()
         updateCycleCounters(BaseCPU::CPU_STATE_ON);
 
         if (!curStaticInst || !curStaticInst->isDelayedCommit()) {
+            const Addr pc = thread->instAddr();
             checkForInterrupts();
             checkPcEventQueue();
+
+            // Taking an interrupt may have changed the mode the
+            // instructions are decoded in
+            if (translationCache && thread->instAddr() != pc)
+                translationCache->contextChanged();
         }
 
         // We must have just got suspended by a PC event
@@ -670,6 +796,15 @@ AtomicSimpleCPU::tick()
 
         bool needToFetch = !isRomMicroPC(pcState.microPC()) &&
                            !curMacroStaticInst;
+
+        // Instructions following one another in a translated block
+        // need neither to be translated nor to be fetched again
+        const TranslatedInst *translated = nullptr;
+        if (needToFetch && translationCache && t_info.fetchOffset == 0) {
+            translated = translationCache->next(pcState);
+            needToFetch = !translated;
+        }
+
         if (needToFetch) {
             ifetch_req->taskId(taskId());
             setupFetchRequest(ifetch_req);
@@ -701,9 +836,18 @@ AtomicSimpleCPU::tick()
                     // ifetch_req is initialized to read the instruction directly
                     // into the CPU object's inst field.
                 //}
+
+                if (t_info.fetchOffset == 0)
+                    fetchPaddr = ifetch_req->getPaddr();
             }
 
-            preExecute();
+            preExecute(translated);
+
+            if (needToFetch && translationCache && !t_info.stayAtPC) {
+                translationCache->decoded(pcState, thread->pcState(),
+                    curMacroStaticInst ? curMacroStaticInst : curStaticInst,
+                    fetchPaddr);
+            }
 
             Tick stall_ticks = 0;
             if (curStaticInst) {
@@ -728,6 +872,9 @@ AtomicSimpleCPU::tick()
                 }
 
                 postExecute();
+
+                if (translationCache)
+                    translationExecuted(curStaticInst, fault);
             }
 
             // @todo remove me after debugging with legion done
@@ -749,6 +896,9 @@ AtomicSimpleCPU::tick()
                     clockPeriod();
             }
 
+        } else if (translationCache) {
+            // the fault is invoked in a different mode
+            translationCache->contextChanged();
         }
         if (fault != NoFault || !t_info.stayAtPC)
             advancePC(fault);
@@ -765,6 +915,30 @@ AtomicSimpleCPU::tick()
         reschedule(tickEvent, curTick() + latency, true);
 }
 
+void
+AtomicSimpleCPU::translationExecuted(const StaticInstPtr &inst,
+                                     const Fault &fault)
+{
+    // System calls, which some ISAs raise as faults, and pseudo
+    // instructions may write memory functionally, which the CPU
+    // doesn't see.
+    if (fault != NoFault || inst->isSyscall() || inst->isNonSpeculative()) {
+        translationCache->flush();
+        return;
+    }
+
+    // Control registers hold the state the decoder depends on
+    for (int i = 0; i < inst->numDestRegs(); i++) {
+        if (inst->destRegIdx(i).isMiscReg()) {
+            translationCache->contextChanged();
+            return;
+        }
+    }
+
+    if (inst->isSerializing() || inst->isSquashAfter())
+        translationCache->stop();
+}
+
 void
 AtomicSimpleCPU::regProbePoints()
 {
@@ -41,8 +41,13 @@
 #ifndef __CPU_SIMPLE_ATOMIC_HH__
 #define __CPU_SIMPLE_ATOMIC_HH__
 
+#include <memory>
+#include <unordered_set>
+
 #include "cpu/simple/base.hh"
 #include "cpu/simple/exec_context.hh"
+#include "cpu/simple/translation_cache.hh"
+#include "mem/backdoor.hh"
 #include "mem/request.hh"
 #include "params/AtomicSimpleCPU.hh"
 #include "sim/probe/probe.hh"
@@ -65,6 +70,24 @@ class AtomicSimpleCPU : public BaseSimpleCPU
     const bool simulate_data_stalls;
     const bool simulate_inst_stalls;
 
+    /** Access memory through back doors when possible */
+    const bool useBackdoors;
+
+    /**
+     * Instructions decoded before, which are executed again without
+     * being fetched, if enabled.
+     */
+    std::unique_ptr<TranslationCache> translationCache;
+
+    /** Physical address of the current instruction */
+    Addr fetchPaddr;
+
+    /**
+     * Update the translation cache once an instruction has been
+     * executed.
+     */
+    void translationExecuted(const StaticInstPtr &inst, const Fault &fault);
+
     // main simulation loop (one cycle)
     void tick();
 
@@ -103,6 +126,51 @@ class AtomicSimpleCPU : public BaseSimpleCPU
 
     virtual Tick sendPacket(MasterPort &port, const PacketPtr &pkt);
 
+    /**
+     * Back doors to memory obtained through the instruction and data
+     * ports, if any. They are handed out by the memory when no cache
+     * can hold copies of the memory they cover, and are dropped when
+     * they are invalidated and when the CPU is drained,
+     * as the caches and the memory mode may change in between.
+     * @{
+     */
+    MemBackdoorPtr instBackdoor;
+    MemBackdoorPtr dataBackdoor;
+    /** @} */
+
+    /**
+     * Back doors this CPU has registered an invalidation callback
+     * with, whether or not it currently holds them.
+     */
+    std::unordered_set<const MemBackdoor *> watchedBackdoors;
+
+    /**
+     * Try to perform an access through a back door.
+     *
+     * @param backdoor Back door obtained through the port of the access.
+     * @param pkt Packet describing the access.
+     * @return True if the access was done, false if it needs to be
+     *         sent to the memory system.
+     */
+    bool accessBackdoor(MemBackdoorPtr backdoor, const PacketPtr &pkt);
+
+    /** Forget the back doors currently held */
+    void dropBackdoors();
+
+    /**
+     * Read instructions for the translation cache, without any side
+     * effect on the memory system.
+     */
+    void readTranslatedInsts(Addr paddr, std::size_t size, uint8_t *data);
+
+    /** Remove the translated instructions written by a packet */
+    void
+    invalidateTranslations(const PacketPtr &pkt)
+    {
+        if (translationCache)
+            translationCache->invalidate(pkt->getAddr(), pkt->getSize());
+    }
+
     /**
      * An AtomicCPUPort overrides the default behaviour of the
      * recvAtomicSnoop and ignores the packet instead of panicking. It
@@ -59,6 +59,7 @@
 #include "cpu/pred/bpred_unit.hh"
 #include "cpu/profile.hh"
 #include "cpu/simple/exec_context.hh"
+#include "cpu/simple/translation_cache.hh"
 #include "cpu/simple_thread.hh"
 #include "cpu/smt.hh"
 #include "cpu/static_inst.hh"
@@ -470,7 +471,7 @@ BaseSimpleCPU::setupFetchRequest(const RequestPtr &req)
 
 
 void
-BaseSimpleCPU::preExecute()
+BaseSimpleCPU::preExecute(const TranslatedInst *translated)
 {
     SimpleExecContext &t_info = *threadInfo[curThread];
     SimpleThread* thread = t_info.thread;
@@ -498,17 +499,24 @@ BaseSimpleCPU::preExecute()
 
         TheISA::Decoder *decoder = &(thread->decoder);
 
-        //Predecode, ie bundle up an ExtMachInst
-        //If more fetch data is needed, pass it in.
-        Addr fetchPC = (pcState.instAddr() & PCMask) + t_info.fetchOffset;
-        //if (decoder->needMoreBytes())
-            decoder->moreBytes(pcState, fetchPC, inst);
-        //else
-        //    decoder->process();
-
-        //Decode an instruction if one is ready. Otherwise, we'll have to
-        //fetch beyond the MachInst at the current pc.
-        instPtr = decoder->decode(pcState);
+        if (translated) {
+            // The instruction was decoded before at this very PC
+            instPtr = translated->inst;
+            pcState = translated->decodedPC;
+        } else {
+            //Predecode, ie bundle up an ExtMachInst
+            //If more fetch data is needed, pass it in.
+            Addr fetchPC = (pcState.instAddr() & PCMask) +
+                t_info.fetchOffset;
+            //if (decoder->needMoreBytes())
+                decoder->moreBytes(pcState, fetchPC, inst);
+            //else
+            //    decoder->process();
+
+            //Decode an instruction if one is ready. Otherwise, we'll have
+            //to fetch beyond the MachInst at the current pc.
+            instPtr = decoder->decode(pcState);
+        }
         if (instPtr) {
             t_info.stayAtPC = false;
             thread->pcState(pcState);
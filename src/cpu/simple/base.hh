@@ -76,6 +76,7 @@ namespace Trace {
 struct BaseSimpleCPUParams;
 class BPredUnit;
 class SimpleExecContext;
+struct TranslatedInst;
 
 class BaseSimpleCPU : public BaseCPU
 {
@@ -123,7 +124,13 @@ class BaseSimpleCPU : public BaseCPU
   public:
     void checkForInterrupts();
     void setupFetchRequest(const RequestPtr &req);
-    void preExecute();
+    /**
+     * Decode the instruction at the PC of the current thread.
+     *
+     * @param translated Previously decoded instruction to use instead
+     * of decoding the fetched bytes, if any.
+     */
+    void preExecute(const TranslatedInst *translated = nullptr);
     void postExecute();
     void advancePC(const Fault &fault);
 
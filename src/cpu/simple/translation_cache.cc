@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "cpu/simple/translation_cache.hh"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+void
+TranslationCache::decoded(const TheISA::PCState &pc,
+                          const TheISA::PCState &decoded_pc,
+                          const StaticInstPtr &inst, Addr paddr)
+{
+    replaying = nullptr;
+
+    const Addr vpage = pageOf(pc.instAddr());
+    const Addr ppage = pageOf(paddr);
+
+    auto it = blocks.find(pc.instAddr());
+    if (it != blocks.end()) {
+        const Block &block = it->second;
+        const TranslatedInst &first = block.insts.front();
+        if (block.generation == generation && block.ppage == ppage &&
+            first.inst == inst && first.pc == pc &&
+            first.decodedPC == decoded_pc && unchanged(block)) {
+            recording = nullptr;
+            replaying = &block;
+            nextInst = 1;
+            return;
+        }
+    }
+
+    // The translation of the first page of an instruction says
+    // nothing about the next one, so instructions crossing pages
+    // (or whose end isn't known) are never recorded.
+    const Addr next_addr = decoded_pc.nextInstAddr();
+    if (next_addr <= pc.instAddr() || pageOf(next_addr - 1) != vpage) {
+        recording = nullptr;
+        return;
+    }
+
+    if (recording && recording->vpage == vpage &&
+        recording->ppage == ppage &&
+        recording->insts.size() < maxBlockInsts) {
+        addInst(*recording, pc, decoded_pc, inst);
+        return;
+    }
+
+    // Start a new block, replacing any stale one at the same PC
+    if (it != blocks.end())
+        removeBlock(it);
+    if (blocks.size() >= maxBlocks)
+        flush();
+
+    Block &block = blocks[pc.instAddr()];
+    block.vpage = vpage;
+    block.ppage = ppage;
+    block.generation = generation;
+    block.first = offsetOf(pc.instAddr());
+    block.last = block.first;
+    addInst(block, pc, decoded_pc, inst);
+    pageBlocks[ppage].push_back(pc.instAddr());
+    recording = &block;
+}
+
+void
+TranslationCache::addInst(Block &block, const TheISA::PCState &pc,
+                          const TheISA::PCState &decoded_pc,
+                          const StaticInstPtr &inst)
+{
+    const Addr offset = offsetOf(pc.instAddr());
+    const std::size_t size = decoded_pc.nextInstAddr() - pc.instAddr();
+
+    block.insts.push_back({ pc, decoded_pc, inst });
+    block.bytes.resize(block.bytes.size() + size);
+    read(block.ppage + offset, size, &block.bytes[block.bytes.size() - size]);
+    block.first = std::min(block.first, offset);
+    block.last = std::max(block.last, offset + size - 1);
+}
+
+bool
+TranslationCache::unchanged(const Block &block)
+{
+    // Read all the instructions at once, they are usually contiguous
+    current.resize(block.last - block.first + 1);
+    read(block.ppage + block.first, current.size(), current.data());
+
+    const uint8_t *bytes = block.bytes.data();
+    for (const TranslatedInst &ti : block.insts) {
+        const Addr offset = offsetOf(ti.pc.instAddr()) - block.first;
+        const std::size_t size =
+            ti.decodedPC.nextInstAddr() - ti.pc.instAddr();
+        if (memcmp(&current[offset], bytes, size) != 0)
+            return false;
+        bytes += size;
+    }
+    return true;
+}
+
+void
+TranslationCache::removeBlock(std::unordered_map<Addr, Block>::iterator it)
+{
+    Block &block = it->second;
+    if (recording == &block || replaying == &block)
+        stop();
+
+    std::vector<Addr> *keys = pageBlocks.find(block.ppage);
+    assert(keys);
+    keys->erase(std::find(keys->begin(), keys->end(), it->first));
+    if (keys->empty())
+        pageBlocks.erase(block.ppage);
+
+    blocks.erase(it);
+}
+
+void
+TranslationCache::invalidatePage(Addr ppage)
+{
+    std::vector<Addr> *keys = pageBlocks.find(ppage);
+    if (!keys)
+        return;
+
+    for (Addr key : *keys) {
+        auto it = blocks.find(key);
+        if (recording == &it->second || replaying == &it->second)
+            stop();
+        blocks.erase(it);
+    }
+    pageBlocks.erase(ppage);
+}
+
+void
+TranslationCache::flush()
+{
+    stop();
+    blocks.clear();
+    pageBlocks.clear();
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __CPU_SIMPLE_TRANSLATION_CACHE_HH__
+#define __CPU_SIMPLE_TRANSLATION_CACHE_HH__
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include "arch/isa_traits.hh"
+#include "arch/types.hh"
+#include "base/flat_hash_map.hh"
+#include "base/types.hh"
+#include "config/the_isa.hh"
+#include "cpu/static_inst.hh"
+
+/** Instruction decoded by a thread, as recorded in a translated block */
+struct TranslatedInst
+{
+    /** State of the PC before decoding the instruction */
+    TheISA::PCState pc;
+    /** State of the PC once the instruction is decoded */
+    TheISA::PCState decodedPC;
+    /** Decoded instruction, which may be a macroop */
+    StaticInstPtr inst;
+};
+
+/**
+ * Cache of the instructions decoded by a simple CPU, which lets the
+ * CPU execute straight line code again without fetching and decoding
+ * it.
+ *
+ * Decoded instructions are recorded as blocks, which start at the
+ * virtual PC of their first instruction and never leave the virtual
+ * and physical pages of that instruction. A block is only entered
+ * once its first instruction has been fetched and decoded again with
+ * the same result, from the same physical page, which validates both
+ * the address translation and the decoding context of the block. The
+ * following instructions are then taken from the block for as long
+ * as the PC matches the one they were recorded with, so that a taken
+ * branch simply leaves the block.
+ *
+ * The bytes of the instructions are also recorded, and compared with
+ * the contents of memory whenever a block is entered. This catches
+ * code written by anything the owner can't see, e.g. DMA devices or
+ * other CPUs when there is no cache to snoop them. The owner should
+ * still invalidate the blocks it knows are written to, and it is
+ * responsible for telling the cache about instructions that change
+ * the decoding context.
+ */
+class TranslationCache
+{
+  public:
+    /** Largest number of instructions in a block */
+    static const std::size_t maxBlockInsts = 64;
+
+    /** Function reading size bytes of memory at a physical address */
+    typedef std::function<void(Addr paddr, std::size_t size,
+                               uint8_t *data)> ReadFunc;
+
+  private:
+    struct Block
+    {
+        Addr vpage;
+        Addr ppage;
+        /** Context generation the block was recorded in */
+        uint64_t generation;
+        std::vector<TranslatedInst> insts;
+        /** Bytes of the instructions, one after the other */
+        std::vector<uint8_t> bytes;
+        /** Page offsets of the first and last bytes of instructions */
+        Addr first;
+        Addr last;
+    };
+
+    /** Blocks, by the virtual PC of their first instruction */
+    std::unordered_map<Addr, Block> blocks;
+
+    /** Start PCs of the blocks recorded from each physical page */
+    FlatHashMap<Addr, std::vector<Addr>> pageBlocks;
+
+    /** Largest number of blocks before the cache is flushed */
+    const std::size_t maxBlocks;
+
+    /** Reads the instructions of the blocks from memory */
+    const ReadFunc read;
+
+    /** Contents of memory, as read when entering a block */
+    std::vector<uint8_t> current;
+
+    /** Number of decoding context changes */
+    uint64_t generation = 0;
+
+    /** Block decoded instructions are appended to, if any */
+    Block *recording = nullptr;
+
+    /** Block instructions are replayed from, if any */
+    const Block *replaying = nullptr;
+    /** Index of the next instruction to replay */
+    std::size_t nextInst = 0;
+
+    static Addr pageOf(Addr addr) { return addr & ~(TheISA::PageBytes - 1); }
+    static Addr offsetOf(Addr addr) { return addr & (TheISA::PageBytes - 1); }
+
+    void removeBlock(std::unordered_map<Addr, Block>::iterator it);
+
+    /** Add an instruction to a block, along with its bytes */
+    void addInst(Block &block, const TheISA::PCState &pc,
+                 const TheISA::PCState &decoded_pc,
+                 const StaticInstPtr &inst);
+
+    /** Check that the instructions of a block are still in memory */
+    bool unchanged(const Block &block);
+
+  public:
+    /**
+     * @param read Function reading the instructions from memory
+     * @param max_blocks Largest number of blocks
+     */
+    TranslationCache(const ReadFunc &_read,
+                     std::size_t max_blocks = 16384)
+        : maxBlocks(max_blocks), read(_read)
+    {}
+
+    /**
+     * Get the next instruction of the block being replayed.
+     *
+     * @param pc State of the PC before the instruction is decoded
+     * @return The instruction, or nullptr if it needs to be fetched
+     * and decoded.
+     */
+    const TranslatedInst *
+    next(const TheISA::PCState &pc)
+    {
+        if (!replaying)
+            return nullptr;
+        if (nextInst < replaying->insts.size() &&
+            replaying->insts[nextInst].pc == pc) {
+            return &replaying->insts[nextInst++];
+        }
+        replaying = nullptr;
+        return nullptr;
+    }
+
+    /**
+     * Record an instruction fetched and decoded by the CPU, which
+     * either enters the block starting at that instruction or adds
+     * it to the block being recorded.
+     *
+     * @param pc State of the PC before decoding
+     * @param decoded_pc State of the PC after decoding
+     * @param inst Decoded instruction
+     * @param paddr Physical address the instruction was fetched from
+     */
+    void decoded(const TheISA::PCState &pc,
+                 const TheISA::PCState &decoded_pc,
+                 const StaticInstPtr &inst, Addr paddr);
+
+    /**
+     * Stop replaying and recording blocks, e.g. after a fault or an
+     * instruction the following ones may depend on.
+     */
+    void
+    stop()
+    {
+        recording = nullptr;
+        replaying = nullptr;
+    }
+
+    /**
+     * Note that the decoding context may have changed, which makes
+     * all the blocks recorded so far unusable until they have been
+     * recorded again.
+     */
+    void
+    contextChanged()
+    {
+        stop();
+        ++generation;
+    }
+
+    /** Remove the blocks holding instructions from a physical range */
+    void
+    invalidate(Addr paddr, std::size_t size)
+    {
+        // most writes are to pages without any instruction
+        if (pageBlocks.empty())
+            return;
+        for (Addr page = pageOf(paddr); page < paddr + size;
+             page += TheISA::PageBytes) {
+            if (pageBlocks.find(page))
+                invalidatePage(page);
+        }
+    }
+
+    /** Remove the blocks holding instructions from a physical page */
+    void invalidatePage(Addr ppage);
+
+    /** Remove all the blocks */
+    void flush();
+
+    std::size_t size() const { return blocks.size(); }
+};
+
+#endif // __CPU_SIMPLE_TRANSLATION_CACHE_HH__
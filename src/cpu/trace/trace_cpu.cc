@@ -649,7 +649,7 @@ TraceCPU::ElasticDataGen::executeMemReq(GraphNode* node_ptr)
     }
 
     // Create a request and the packet containing request
-    auto req = std::make_shared<Request>(
+    RequestPtr req = new Request(
         node_ptr->physAddr, node_ptr->size, node_ptr->flags, masterID);
     req->setReqInstSeqNum(node_ptr->seqNum);
 
@@ -1146,7 +1146,7 @@ TraceCPU::FixedRetryGen::send(Addr addr, unsigned size, const MemCmd& cmd,
 {
 
     // Create new request
-    auto req = std::make_shared<Request>(addr, size, flags, masterID);
+    RequestPtr req = new Request(addr, size, flags, masterID);
     req->setPC(pc);
 
     // If this is not done it triggers assert in L1 cache for invalid contextId
@@ -193,10 +193,10 @@ class WholeTranslationState
     void
     deleteReqs()
     {
-        mainReq.reset();
+        mainReq = nullptr;
         if (isSplit) {
-            sreqLow.reset();
-            sreqHigh.reset();
+            sreqLow = nullptr;
+            sreqHigh = nullptr;
         }
     }
 };
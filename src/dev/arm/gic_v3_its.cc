@@ -88,7 +88,7 @@ ItsProcess::doRead(Yield &yield, Addr addr, void *ptr, size_t size)
     ItsAction a;
     a.type = ItsActionType::SEND_REQ;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = new Request(
         addr, size, 0, its.masterId);
 
     req->taskId(ContextSwitchTaskId::DMA);
@@ -112,7 +112,7 @@ ItsProcess::doWrite(Yield &yield, Addr addr, void *ptr, size_t size)
     ItsAction a;
     a.type = ItsActionType::SEND_REQ;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = new Request(
         addr, size, 0, its.masterId);
 
     req->taskId(ContextSwitchTaskId::DMA);
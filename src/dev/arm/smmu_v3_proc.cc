@@ -75,7 +75,7 @@ SMMUProcess::doRead(Yield &yield, Addr addr, void *ptr, size_t size)
     SMMUAction a;
     a.type = ACTION_SEND_REQ;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = new Request(
         addr, size, 0, smmu.masterId);
 
     req->taskId(ContextSwitchTaskId::DMA);
@@ -107,7 +107,7 @@ SMMUProcess::doWrite(Yield &yield, Addr addr, const void *ptr, size_t size)
     SMMUAction a;
     a.type = ACTION_SEND_REQ;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = new Request(
         addr, size, 0, smmu.masterId);
 
     req->taskId(ContextSwitchTaskId::DMA);
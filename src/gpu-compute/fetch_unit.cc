@@ -141,7 +141,7 @@ FetchUnit::initiateFetch(Wavefront *wavefront)
     }
 
     // set up virtual request
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = new Request(
         vaddr, size, Request::INST_FETCH,
         computeUnit->masterId(), 0, 0, nullptr);
 
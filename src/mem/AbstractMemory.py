@@ -69,3 +69,15 @@ class AbstractMemory(ClockedObject):
     # particularly useful for ROMs.
     image_file = Param.String('',
             "Image to load into memory as its initial contents")
+
+    # Raw image mapped copy-on-write as the initial contents of this
+    # memory, rather than copied into it. The pages of the image are
+    # only read when accessed, and are shared through the host page
+    # cache by all the simulations using it, e.g. a batch of jobs
+    # starting from the same state. The image may be shorter than the
+    # memory, the rest being zeros. The raw store files of checkpoints
+    # taken with the 'raw' memory checkpoint format can be used as
+    # images. All the memories of an interleaved range must use the
+    # same image, which covers the whole range.
+    shared_image = Param.String('',
+            "Raw image mapped copy-on-write as the initial contents")
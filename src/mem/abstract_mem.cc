@@ -267,6 +267,11 @@ AbstractMemory::trackLoadLocked(PacketPtr pkt)
         }
     }
 
+    // Stores made through the back door would not clear the lock,
+    // make everybody go through the memory until it is released.
+    if (lockedAddrList.empty() && backdoor.ptr())
+        backdoor.invalidate();
+
     // no record for this xc: need to allocate a new one
     DPRINTF(LLSC, "Adding lock record: context %d addr %#x\n",
             req->contextId(), paddr);
@@ -1490,7 +1490,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 
     stats.writebacks[Request::wbMasterId]++;
 
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = new Request(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbMasterId);
 
     if (blk->isSecure())
@@ -1532,7 +1532,7 @@ BaseCache::writebackBlk(CacheBlk *blk)
 PacketPtr
 BaseCache::writecleanBlk(CacheBlk *blk, Request::Flags dest, PacketId id)
 {
-    RequestPtr req = std::make_shared<Request>(
+    RequestPtr req = new Request(
         regenerateBlkAddr(blk), blkSize, 0, Request::wbMasterId);
 
     if (blk->isSecure()) {
@@ -1605,7 +1605,7 @@ BaseCache::writebackVisitor(CacheBlk &blk)
     if (blk.isDirty()) {
         assert(blk.isValid());
 
-        RequestPtr request = std::make_shared<Request>(
+        RequestPtr request = new Request(
             regenerateBlkAddr(&blk), blkSize, 0, Request::funcMasterId);
 
         request->taskId(blk.task_id);
@@ -2340,6 +2340,20 @@ BaseCache::CpuSidePort::recvAtomic(PacketPtr pkt)
     }
 }
 
+Tick
+BaseCache::CpuSidePort::recvAtomicBackdoor(PacketPtr pkt,
+                                           MemBackdoorPtr &backdoor)
+{
+    if (cache->system->bypassCaches()) {
+        // The cache is not involved in bypass mode, let the memory
+        // below hand out a back door if it can.
+        return cache->memSidePort.sendAtomicBackdoor(pkt, backdoor);
+    } else {
+        // The cache has to observe every access, no back door.
+        return cache->recvAtomic(pkt);
+    }
+}
+
 void
 BaseCache::CpuSidePort::recvFunctional(PacketPtr pkt)
 {
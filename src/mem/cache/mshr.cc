@@ -484,7 +484,7 @@ MSHR::handleSnoop(PacketPtr pkt, Counter _order)
         // the packet and the request as part of handling the deferred
         // snoop.
         PacketPtr cp_pkt = will_respond ? new Packet(pkt, true, true) :
-            new Packet(std::make_shared<Request>(*pkt->req), pkt->cmd,
+            new Packet(new Request(*pkt->req), pkt->cmd,
                        blkSize, pkt->id);
 
         if (will_respond) {
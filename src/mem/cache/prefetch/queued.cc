@@ -54,7 +54,7 @@ Queued::DeferredPacket::createPkt(Addr paddr, unsigned blk_size,
                                             MasterID mid, bool tag_prefetch,
                                             Tick t) {
     /* Create a prefetch memory request */
-    RequestPtr req = std::make_shared<Request>(paddr, blk_size, 0, mid);
+    RequestPtr req = new Request(paddr, blk_size, 0, mid);
 
     if (pfInfo.isSecure()) {
         req->setFlags(Request::SECURE);
@@ -341,7 +341,7 @@ RequestPtr
 Queued::createPrefetchRequest(Addr addr, PrefetchInfo const &pfi,
                                         PacketPtr pkt)
 {
-    RequestPtr translation_req = std::make_shared<Request>(
+    RequestPtr translation_req = new Request(
             addr, blkSize, pkt->req->getFlags(), masterId, pfi.getPC(),
             pkt->req->contextId());
     translation_req->setFlags(Request::PREFETCH);
@@ -45,13 +45,18 @@
 
 #include "mem/cache/tags/base_set_assoc.hh"
 
+#include <cassert>
 #include <string>
 
 #include "base/intmath.hh"
+#include "mem/cache/tags/indexing_policies/set_associative.hh"
 
 BaseSetAssoc::BaseSetAssoc(const Params *p)
     :BaseTags(p), allocAssoc(p->assoc), blks(p->size / p->block_size),
-     sequentialAccess(p->sequential_access),
+     assoc(p->assoc), setShift(floorLog2(p->block_size)),
+     setMask(p->size / (p->block_size * p->assoc) - 1),
+     packedLookup(dynamic_cast<SetAssociative *>(indexingPolicy) != nullptr),
+     packedTags(numBlocks, 0), sequentialAccess(p->sequential_access),
      replacementPolicy(p->replacement_policy)
 {
     // Check parameters
@@ -83,6 +88,7 @@ void
 BaseSetAssoc::invalidate(CacheBlk *blk)
 {
     BaseTags::invalidate(blk);
+    packedTag(blk) = 0;
 
     // Decrease the number of tags in use
     stats.tagsInUse--;
@@ -91,6 +97,30 @@ BaseSetAssoc::invalidate(CacheBlk *blk)
     replacementPolicy->invalidate(blk->replacementData);
 }
 
+CacheBlk*
+BaseSetAssoc::findBlock(Addr addr, bool is_secure) const
+{
+    if (!packedLookup) {
+        return BaseTags::findBlock(addr, is_secure);
+    }
+
+    const Addr key = packTag(extractTag(addr), is_secure);
+    const uint32_t set = (addr >> setShift) & setMask;
+    const Addr *tags = &packedTags[set * assoc];
+
+    const unsigned way = findTag(tags, assoc, key);
+    if (way == assoc) {
+        // Did not find block
+        return nullptr;
+    }
+
+    CacheBlk *blk = static_cast<CacheBlk*>(
+        indexingPolicy->getEntry(set, way));
+    assert(blk->tag == extractTag(addr) && blk->isValid() &&
+           blk->isSecure() == is_secure);
+    return blk;
+}
+
 BaseSetAssoc *
 BaseSetAssocParams::create()
 {
@@ -59,6 +59,7 @@
 #include "mem/cache/replacement_policies/replaceable_entry.hh"
 #include "mem/cache/tags/base.hh"
 #include "mem/cache/tags/indexing_policies/base.hh"
+#include "mem/cache/tags/packed_tags.hh"
 #include "mem/packet.hh"
 #include "params/BaseSetAssoc.hh"
 
@@ -78,6 +79,37 @@ class BaseSetAssoc : public BaseTags
     /** The cache blocks. */
     std::vector<CacheBlk> blks;
 
+    /** The associativity of the cache. */
+    const unsigned assoc;
+
+    /** The amount to shift an address to get its set. */
+    const int setShift;
+
+    /** Mask out all bits that aren't part of the set index. */
+    const unsigned setMask;
+
+    /**
+     * Whether each address maps to the ways of a single set, so that
+     * lookups can use the packed tags. Other indexing policies, such
+     * as skewed ones, look up the blocks themselves.
+     */
+    bool packedLookup;
+
+    /**
+     * Tags of the blocks, packed together with their valid and secure
+     * bits as given by packTag(), and laid out set after set as the
+     * blocks are. Comparing a whole set of these only touches a few
+     * cache lines of the host, rather than a block object per way.
+     */
+    std::vector<Addr> packedTags;
+
+    /** Location of the packed tag of a block. */
+    Addr &
+    packedTag(const CacheBlk *blk)
+    {
+        return packedTags[blk->getSet() * assoc + blk->getWay()];
+    }
+
     /** Whether tags and data are accessed sequentially. */
     const bool sequentialAccess;
 
@@ -111,6 +143,16 @@ class BaseSetAssoc : public BaseTags
      */
     void invalidate(CacheBlk *blk) override;
 
+    /**
+     * Find a block, comparing the packed tags of all the ways of its
+     * set at once.
+     *
+     * @param addr The address to find.
+     * @param is_secure True if the target memory space is secure.
+     * @return Pointer to the cache block if found.
+     */
+    CacheBlk *findBlock(Addr addr, bool is_secure) const override;
+
     /**
      * Access block and update replacement data. May not succeed, in which case
      * nullptr is returned. This has all the implications of a cache access and
@@ -191,6 +233,7 @@ class BaseSetAssoc : public BaseTags
     {
         // Insert block
         BaseTags::insertBlock(pkt, blk);
+        packedTag(blk) = packTag(blk->tag, blk->isSecure());
 
         // Increment tag counter
         stats.tagsInUse++;
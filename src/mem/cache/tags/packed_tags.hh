@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/**
+ * @file
+ * Comparison of packed cache tags, used by BaseSetAssoc to look up all
+ * the ways of a set at once.
+ */
+
+#ifndef __MEM_CACHE_TAGS_PACKED_TAGS_HH__
+#define __MEM_CACHE_TAGS_PACKED_TAGS_HH__
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__SSE2__) || defined(__x86_64__)
+#include <immintrin.h>
+#endif
+
+#include "base/bitfield.hh"
+#include "base/types.hh"
+
+/**
+ * Pack the tag and secure bit of a valid block. Invalid blocks are
+ * packed as 0, which never matches a valid block.
+ */
+inline Addr
+packTag(Addr tag, bool is_secure)
+{
+    return (tag << 2) | (is_secure ? 2 : 0) | 1;
+}
+
+/**
+ * Compare packed tags with a key, one at a time.
+ *
+ * @param tags The packed tags.
+ * @param count Number of tags, at most 64.
+ * @param key The packed tag to look for.
+ * @return Bit mask of the tags equal to the key.
+ */
+inline uint64_t
+matchTagsScalar(const Addr *tags, unsigned count, Addr key)
+{
+    uint64_t match = 0;
+    for (unsigned i = 0; i < count; i++) {
+        match |= (uint64_t)(tags[i] == key) << i;
+    }
+    return match;
+}
+
+#if defined(__SSE2__)
+/** Compare packed tags with a key, two at a time with SSE2. */
+inline uint64_t
+matchTagsSSE2(const Addr *tags, unsigned count, Addr key)
+{
+    uint64_t match = 0;
+    unsigned i = 0;
+    // There is no 64-bit compare in SSE2, so both halves must be equal
+    const __m128i key_vec = _mm_set1_epi64x(key);
+    for (; i + 2 <= count; i += 2) {
+        __m128i eq = _mm_cmpeq_epi32(key_vec,
+            _mm_loadu_si128((const __m128i *)(tags + i)));
+        eq = _mm_and_si128(eq,
+                           _mm_shuffle_epi32(eq, _MM_SHUFFLE(2, 3, 0, 1)));
+        match |= (uint64_t)_mm_movemask_pd(_mm_castsi128_pd(eq)) << i;
+    }
+    for (; i < count; i++) {
+        match |= (uint64_t)(tags[i] == key) << i;
+    }
+    return match;
+}
+#endif
+
+#if defined(__x86_64__)
+/**
+ * Compare packed tags with a key, four at a time with AVX2. This is
+ * always compiled on x86-64 hosts so that it can be tested, but it is
+ * only used by matchTags() when the whole build targets AVX2.
+ */
+__attribute__((target("avx2"))) inline uint64_t
+matchTagsAVX2(const Addr *tags, unsigned count, Addr key)
+{
+    uint64_t match = 0;
+    unsigned i = 0;
+    const __m256i key_vec = _mm256_set1_epi64x(key);
+    for (; i + 4 <= count; i += 4) {
+        const __m256i eq = _mm256_cmpeq_epi64(key_vec,
+            _mm256_loadu_si256((const __m256i *)(tags + i)));
+        match |= (uint64_t)_mm256_movemask_pd(_mm256_castsi256_pd(eq)) << i;
+    }
+    for (; i < count; i++) {
+        match |= (uint64_t)(tags[i] == key) << i;
+    }
+    return match;
+}
+#endif
+
+/** Compare packed tags with a key, with the widest vectors available. */
+inline uint64_t
+matchTags(const Addr *tags, unsigned count, Addr key)
+{
+#if defined(__AVX2__)
+    return matchTagsAVX2(tags, count, key);
+#elif defined(__SSE2__)
+    return matchTagsSSE2(tags, count, key);
+#else
+    return matchTagsScalar(tags, count, key);
+#endif
+}
+
+/**
+ * Find the first of any number of packed tags equal to a key, by
+ * groups of 64.
+ *
+ * @param tags The packed tags.
+ * @param count Number of tags.
+ * @param key The packed tag to look for.
+ * @param match Function comparing up to 64 tags with the key.
+ * @return Index of the first matching tag, or count if none matches.
+ */
+inline unsigned
+findTag(const Addr *tags, unsigned count, Addr key,
+        uint64_t (*match)(const Addr *, unsigned, Addr) = matchTags)
+{
+    for (unsigned i = 0; i < count; i += 64) {
+        const uint64_t mask = match(tags + i, std::min(count - i, 64u), key);
+        if (mask) {
+            return i + ctz64(mask);
+        }
+    }
+    return count;
+}
+
+#endif // __MEM_CACHE_TAGS_PACKED_TAGS_HH__
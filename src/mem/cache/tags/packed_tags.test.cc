@@ -0,0 +1,113 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "mem/cache/tags/packed_tags.hh"
+
+typedef uint64_t (*MatchTagsFunc)(const Addr *, unsigned, Addr);
+
+/** Reference implementation of findTag() */
+static unsigned
+findTagReference(const std::vector<Addr> &tags, Addr key)
+{
+    for (unsigned i = 0; i < tags.size(); i++) {
+        if (tags[i] == key)
+            return i;
+    }
+    return tags.size();
+}
+
+/**
+ * Compare a match function with the reference on random sets of tags,
+ * for all associativities up to 130. The tags are drawn from a few
+ * values, secure and non-secure, and some blocks are invalid, so that
+ * sets often hold several copies of the key, or the same tag with the
+ * other secure bit.
+ */
+static void
+checkMatchTags(MatchTagsFunc match)
+{
+    std::mt19937_64 rng(0);
+    for (unsigned assoc = 1; assoc <= 130; assoc++) {
+        std::vector<Addr> tags(assoc);
+        for (int round = 0; round < 100; round++) {
+            for (auto &tag : tags) {
+                tag = rng() % 8 ? packTag(rng() % 4, rng() % 2) : 0;
+            }
+            const Addr key = packTag(rng() % 4, rng() % 2);
+
+            EXPECT_EQ(findTagReference(tags, key),
+                      findTag(tags.data(), assoc, key, match));
+
+            const unsigned count = std::min(assoc, 64u);
+            uint64_t ref = 0;
+            for (unsigned i = 0; i < count; i++) {
+                ref |= (uint64_t)(tags[i] == key) << i;
+            }
+            EXPECT_EQ(ref, match(tags.data(), count, key));
+        }
+    }
+}
+
+TEST(PackedTagsTest, PackTag)
+{
+    EXPECT_NE(packTag(0x10, false), packTag(0x10, true));
+    EXPECT_NE(packTag(0x10, false), packTag(0x11, false));
+    EXPECT_NE((Addr)0, packTag(0, false));
+    EXPECT_NE((Addr)0, packTag(0, true));
+}
+
+TEST(PackedTagsTest, Scalar)
+{
+    checkMatchTags(matchTagsScalar);
+}
+
+#if defined(__SSE2__)
+TEST(PackedTagsTest, SSE2)
+{
+    checkMatchTags(matchTagsSSE2);
+}
+#endif
+
+#if defined(__x86_64__)
+TEST(PackedTagsTest, AVX2)
+{
+    if (!__builtin_cpu_supports("avx2"))
+        return;
+    checkMatchTags(matchTagsAVX2);
+}
+#endif
+
+TEST(PackedTagsTest, Default)
+{
+    checkMatchTags(matchTags);
+}
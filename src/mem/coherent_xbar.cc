@@ -58,6 +58,7 @@ CoherentXBar::CoherentXBar(const CoherentXBarParams *p)
       maxRoutingTableSizeCheck(p->max_routing_table_size),
       pointOfCoherency(p->point_of_coherency),
       pointOfUnification(p->point_of_unification),
+      cacheAbove(false),
 
       snoops(this, "snoops", "Total snoops (count)"),
       snoopTraffic(this, "snoopTraffic", "Total snoop traffic (bytes)"),
@@ -144,6 +145,8 @@ CoherentXBar::recvTimingReq(PacketPtr pkt, PortID slave_port_id)
     // determine the source port based on the id
     SlavePort *src_port = slavePorts[slave_port_id];
 
+    checkCacheAbove(pkt);
+
     // remember if the packet is an express snoop
     bool is_express_snoop = pkt->isExpressSnoop();
     bool cache_responding = pkt->cacheResponding();
@@ -711,6 +714,20 @@ CoherentXBar::forwardTiming(PacketPtr pkt, PortID exclude_slave_port_id,
     snoopFanout.sample(fanout);
 }
 
+void
+CoherentXBar::checkCacheAbove(const PacketPtr pkt)
+{
+    if (cacheAbove || !pkt->fromCache())
+        return;
+
+    DPRINTF(CoherentXBar, "%s: first request from a cache, invalidating "
+            "%d back doors\n", __func__, grantedBackdoors.size());
+    cacheAbove = true;
+    for (auto backdoor : grantedBackdoors)
+        backdoor->invalidate();
+    grantedBackdoors.clear();
+}
+
 void
 CoherentXBar::recvReqRetry(PortID master_port_id)
 {
@@ -727,6 +744,8 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID slave_port_id,
     DPRINTF(CoherentXBar, "%s: src %s packet %s\n", __func__,
             slavePorts[slave_port_id]->name(), pkt->print());
 
+    checkCacheAbove(pkt);
+
     unsigned int pkt_size = pkt->hasData() ? pkt->getSize() : 0;
     unsigned int pkt_cmd = pkt->cmdToIndex();
 
@@ -799,11 +818,22 @@ CoherentXBar::recvAtomicBackdoor(PacketPtr pkt, PortID slave_port_id,
                 pkt->clearWriteThrough();
             }
 
+            // only ask for a back door if no cache can hold copies
+            // that the accesses made through it would bypass, the
+            // back doors are invalidated if a cache shows up later
+            const bool get_backdoor = backdoor &&
+                (!snoop_caches || !cacheAbove);
+
             // forward the request to the appropriate destination
             auto master = masterPorts[master_port_id];
-            response_latency = backdoor ?
-                master->sendAtomicBackdoor(pkt, *backdoor) :
-                master->sendAtomic(pkt);
+            if (get_backdoor) {
+                response_latency = master->sendAtomicBackdoor(pkt,
+                                                              *backdoor);
+                if (*backdoor)
+                    grantedBackdoors.insert(*backdoor);
+            } else {
+                response_latency = master->sendAtomic(pkt);
+            }
         } else {
             // if it does not need a response we sink the packet above
             assert(pkt->needsResponse());
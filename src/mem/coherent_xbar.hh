@@ -294,6 +294,22 @@ class CoherentXBar : public BaseXBar
      */
     std::unique_ptr<Packet> pendingDelete;
 
+    /**
+     * Has a cache sent a request through the crossbar? If so, caches
+     * may hold copies of memory that accesses made through a back door
+     * would bypass, and no back door is handed out.
+     */
+    bool cacheAbove;
+
+    /** Back doors handed out through the crossbar */
+    std::unordered_set<MemBackdoorPtr> grantedBackdoors;
+
+    /**
+     * Check whether a request comes from a cache, and if it is the
+     * first one to do so, invalidate the back doors handed out so far.
+     */
+    void checkCacheAbove(const PacketPtr pkt);
+
     bool recvTimingReq(PacketPtr pkt, PortID slave_port_id);
     bool recvTimingResp(PacketPtr pkt, PortID master_port_id);
     void recvTimingSnoopReq(PacketPtr pkt, PortID master_port_id);
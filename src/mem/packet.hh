@@ -57,6 +57,7 @@
 #include "base/flags.hh"
 #include "base/logging.hh"
 #include "base/printable.hh"
+#include "base/slab_alloc.hh"
 #include "base/types.hh"
 #include "mem/request.hh"
 #include "sim/core.hh"
@@ -64,6 +65,15 @@
 class Packet;
 typedef Packet *PacketPtr;
 typedef uint8_t* PacketDataPtr;
+
+/**
+ * Pool of packet payloads. Most packets carry at most a cache line,
+ * so payloads up to this size are taken from a per-thread pool of
+ * fixed-size blocks rather than from the heap.
+ */
+struct PacketDataBlock { uint8_t bytes[64]; };
+typedef SlabAllocator<PacketDataBlock, sizeof(PacketDataBlock)>
+    PacketDataAllocator;
 typedef std::list<PacketPtr> PacketList;
 typedef uint64_t PacketId;
 
@@ -297,6 +307,10 @@ class Packet : public Printable
         /// the packet is destroyed. The pointer is assumed to be pointing
         /// to an array, and delete [] is consequently called
         DYNAMIC_DATA           = 0x00002000,
+        /// The dynamic data was taken from the packet data pool
+        /// rather than allocated with new [], and is returned to the
+        /// pool when the packet is destroyed.
+        POOLED_DATA            = 0x00004000,
 
         /// suppress the error if this packet encounters a functional
         /// access failure.
@@ -923,6 +937,15 @@ class Packet : public Printable
         deleteData();
     }
 
+    /**
+     * Packets are allocated from a per-thread pool rather than from
+     * the heap, as one is created for every memory transaction.
+     * @{
+     */
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr);
+    /** @} */
+
     /**
      * Take a request packet and modify it in place to be suitable for
      * returning as a response to that request.
@@ -1214,10 +1237,12 @@ class Packet : public Printable
     void
     deleteData()
     {
-        if (flags.isSet(DYNAMIC_DATA))
+        if (flags.isSet(POOLED_DATA))
+            PacketDataAllocator::release(data);
+        else if (flags.isSet(DYNAMIC_DATA))
             delete [] data;
 
-        flags.clear(STATIC_DATA|DYNAMIC_DATA);
+        flags.clear(STATIC_DATA|DYNAMIC_DATA|POOLED_DATA);
         data = NULL;
     }
 
@@ -1230,7 +1255,13 @@ class Packet : public Printable
         if (hasData() || hasRespData()) {
             assert(flags.noneSet(STATIC_DATA|DYNAMIC_DATA));
             flags.set(DYNAMIC_DATA);
-            data = new uint8_t[getSize()];
+            if (getSize() <= sizeof(PacketDataBlock)) {
+                flags.set(POOLED_DATA);
+                data = static_cast<PacketDataPtr>(
+                    PacketDataAllocator::allocate());
+            } else {
+                data = new uint8_t[getSize()];
+            }
         }
     }
 
@@ -1345,4 +1376,19 @@ class Packet : public Printable
     std::string print() const;
 };
 
+typedef SlabAllocator<Packet, sizeof(Packet)> PacketAllocator;
+
+inline void *
+Packet::operator new(std::size_t size)
+{
+    assert(size == sizeof(Packet));
+    return PacketAllocator::allocate();
+}
+
+inline void
+Packet::operator delete(void *ptr)
+{
+    PacketAllocator::release(ptr);
+}
+
 #endif //__MEM_PACKET_HH
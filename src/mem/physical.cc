@@ -39,17 +39,25 @@
 
 #include <fcntl.h>
 #include <sys/mman.h>
+#include <sys/stat.h>
 #include <sys/types.h>
 #include <sys/user.h>
 #include <unistd.h>
 #include <zlib.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cerrno>
 #include <climits>
 #include <cstdio>
+#include <cstring>
+#include <functional>
 #include <iostream>
+#include <memory>
 #include <string>
+#include <thread>
 
+#include "base/intmath.hh"
 #include "base/trace.hh"
 #include "debug/AddrRanges.hh"
 #include "debug/Checkpoint.hh"
@@ -71,8 +79,14 @@ using namespace std;
 
 PhysicalMemory::PhysicalMemory(const string& _name,
                                const vector<AbstractMemory*>& _memories,
-                               bool mmap_using_noreserve) :
-    _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve)
+                               bool mmap_using_noreserve,
+                               Enums::MemoryCheckpointFormat
+                               checkpoint_format,
+                               unsigned checkpoint_threads) :
+    _name(_name), size(0), mmapUsingNoReserve(mmap_using_noreserve),
+    checkpointFormat(checkpoint_format),
+    checkpointThreads(checkpoint_threads ? checkpoint_threads :
+                      max(thread::hardware_concurrency(), 1u))
 {
     if (mmap_using_noreserve)
         warn("Not reserving swap space. May cause SIGSEGV on actual usage\n");
@@ -210,10 +224,24 @@ PhysicalMemory::createBackingStore(AddrRange range,
               range.to_string());
     }
 
+    // the initial contents of the memories may come from an image
+    // shared with other simulations
+    const string &image = _memories.front()->params()->shared_image;
+    for (const auto& m : _memories) {
+        fatal_if(m->params()->shared_image != image,
+                 "Inconsistent shared images in an interleaved range\n");
+    }
+    if (!image.empty()) {
+        DPRINTF(AddrRanges, "Mapping shared image %s for range %s\n",
+                image, range.to_string());
+        mapStoreFile(image, range, pmem, false);
+    }
+
     // remember this backing store so we can checkpoint it and unmap
     // it appropriately
     backingStore.emplace_back(range, pmem,
                               conf_table_reported, in_addr_map, kvm_map);
+    backingStore.back().fileMapped = !image.empty();
 
     // point the memories to their backing store
     for (const auto& m : _memories) {
@@ -326,8 +354,20 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
 {
     // we cannot use the address range for the name as the
     // memories that are not part of the address map can overlap
-    string filename = name() + ".store" + to_string(store_id) + ".pmem";
+    string filename = name() + ".store" + to_string(store_id);
+    switch (checkpointFormat) {
+      case Enums::raw:
+        filename += ".raw";
+        break;
+      case Enums::chunked:
+        filename += ".chunked";
+        break;
+      default:
+        filename += ".pmem";
+        break;
+    }
     long range_size = range.size();
+    string format = Enums::MemoryCheckpointFormatStrings[checkpointFormat];
 
     DPRINTF(Checkpoint, "Serializing physical memory %s with size %d\n",
             filename, range_size);
@@ -335,13 +375,33 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     SERIALIZE_SCALAR(store_id);
     SERIALIZE_SCALAR(filename);
     SERIALIZE_SCALAR(range_size);
+    SERIALIZE_SCALAR(format);
 
-    // write memory file
+    // write memory file, possibly from a snapshot in the background
     string filepath = CheckpointIn::dir() + "/" + filename.c_str();
+    Serializable::writeBulk([this, filepath, range, pmem]() {
+        switch (checkpointFormat) {
+          case Enums::raw:
+            serializeStoreRaw(filepath, range, pmem);
+            break;
+          case Enums::chunked:
+            serializeStoreChunked(filepath, range, pmem);
+            break;
+          default:
+            serializeStoreGzip(filepath, range, pmem);
+            break;
+        }
+    });
+}
+
+void
+PhysicalMemory::serializeStoreGzip(const string &filepath, AddrRange range,
+                                   const uint8_t *pmem) const
+{
     gzFile compressed_mem = gzopen(filepath.c_str(), "wb");
     if (compressed_mem == NULL)
         fatal("Can't open physical memory checkpoint file '%s'\n",
-              filename);
+              filepath);
 
     uint64_t pass_size = 0;
 
@@ -354,7 +414,7 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
         if (gzwrite(compressed_mem, pmem + written,
                     (unsigned int) pass_size) != (int) pass_size) {
             fatal("Write failed on physical memory checkpoint file '%s'\n",
-                  filename);
+                  filepath);
         }
     }
 
@@ -362,10 +422,235 @@ PhysicalMemory::serializeStore(CheckpointOut &cp, unsigned int store_id,
     // is zero
     if (gzclose(compressed_mem))
         fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+              filepath);
 
 }
 
+/**
+ * Check if a block of memory only contains zeros, by checking the
+ * first byte and then comparing the block with itself shifted by
+ * one byte.
+ */
+static bool
+isZero(const uint8_t *data, uint64_t size)
+{
+    return size == 0 ||
+        (data[0] == 0 && memcmp(data, data + 1, size - 1) == 0);
+}
+
+/**
+ * Write a buffer at a given offset of a file, retrying on short
+ * writes.
+ */
+static void
+writeFully(int fd, const uint8_t *data, uint64_t size, uint64_t offset,
+           const string &filepath)
+{
+    while (size > 0) {
+        ssize_t written = pwrite(fd, data, min<uint64_t>(size, INT_MAX),
+                                 offset);
+        if (written < 0 && errno == EINTR)
+            continue;
+        if (written <= 0)
+            fatal("Write failed on physical memory checkpoint file "
+                  "'%s': %s\n", filepath, strerror(errno));
+        data += written;
+        size -= written;
+        offset += written;
+    }
+}
+
+/**
+ * Read a buffer from a given offset of a file, retrying on short
+ * reads.
+ */
+static void
+readFully(int fd, uint8_t *data, uint64_t size, uint64_t offset,
+          const string &filepath)
+{
+    while (size > 0) {
+        ssize_t bytes_read = pread(fd, data, min<uint64_t>(size, INT_MAX),
+                                   offset);
+        if (bytes_read < 0 && errno == EINTR)
+            continue;
+        if (bytes_read <= 0)
+            fatal("Read failed on physical memory checkpoint file "
+                  "'%s': %s\n", filepath,
+                  bytes_read ? strerror(errno) : "unexpected end of file");
+        data += bytes_read;
+        size -= bytes_read;
+        offset += bytes_read;
+    }
+}
+
+/**
+ * Layout of chunked physical memory checkpoint files: a header, the
+ * index of the chunks, and the chunks themselves, in no particular
+ * order. Every chunk is compressed independently, so chunks can be
+ * written and read concurrently, and any subset of the store can be
+ * restored without reading the rest of the file.
+ * @{
+ */
+struct ChunkedStoreHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t chunkSize;
+    uint64_t storeSize;
+    uint64_t numChunks;
+};
+
+/**
+ * Location of a chunk in the file. Chunks that only contain zeros
+ * have a size of zero and no data, and chunks which do not compress
+ * are stored uncompressed, with a size equal to the chunk size.
+ */
+struct ChunkedStoreIndexEntry
+{
+    uint64_t offset;
+    uint64_t size;
+};
+
+static const char chunkedStoreMagic[8] = {
+    'g', 'e', 'm', '5', 'p', 'm', 'e', 'm' };
+static const uint32_t chunkedStoreVersion = 1;
+static const uint32_t chunkedStoreChunkSize = 1024 * 1024;
+/** @} */
+
+/**
+ * Call a function for all the integers below a given count, spreading
+ * the calls over a number of host threads.
+ */
+static void
+parallelFor(unsigned threads, uint64_t count,
+            const function<void(uint64_t)> &func)
+{
+    atomic<uint64_t> next(0);
+    auto worker = [&]() {
+        for (uint64_t i = next++; i < count; i = next++)
+            func(i);
+    };
+
+    vector<thread> pool;
+    for (unsigned t = 1; t < min<uint64_t>(threads, count); ++t)
+        pool.emplace_back(worker);
+    worker();
+    for (auto &t : pool)
+        t.join();
+}
+
+void
+PhysicalMemory::serializeStoreRaw(const string &filepath, AddrRange range,
+                                  const uint8_t *pmem) const
+{
+    // The file may currently be mapped by this very simulation if it
+    // was restored from a checkpoint in the same directory, so
+    // replace it rather than write to it.
+    if (unlink(filepath.c_str()) != 0 && errno != ENOENT)
+        fatal("Can't remove physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+
+    int fd = open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+
+    const uint64_t page_size = sysconf(_SC_PAGESIZE);
+    const uint64_t store_size = range.size();
+
+    uint64_t offset = 0;
+    while (offset < store_size) {
+        // skip the pages that are all zeros, they read back as zeros
+        // from the holes they leave in the file
+        uint64_t len = min(page_size, store_size - offset);
+        if (isZero(pmem + offset, len)) {
+            offset += len;
+            continue;
+        }
+
+        // write the run of non-zero pages starting here at once
+        uint64_t end = offset + len;
+        while (end < store_size) {
+            len = min(page_size, store_size - end);
+            if (isZero(pmem + end, len))
+                break;
+            end += len;
+        }
+
+        writeFully(fd, pmem + offset, end - offset, offset, filepath);
+        offset = end;
+    }
+
+    // extend the file to the size of the store, in case it ends with
+    // zero pages
+    if (ftruncate(fd, store_size) != 0)
+        fatal("Can't resize physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+
+    if (close(fd) != 0)
+        fatal("Close failed on physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+}
+
+void
+PhysicalMemory::serializeStoreChunked(const string &filepath,
+                                      AddrRange range,
+                                      const uint8_t *pmem) const
+{
+    int fd = open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+
+    ChunkedStoreHeader header;
+    memcpy(header.magic, chunkedStoreMagic, sizeof(header.magic));
+    header.version = chunkedStoreVersion;
+    header.chunkSize = chunkedStoreChunkSize;
+    header.storeSize = range.size();
+    header.numChunks = divCeil(header.storeSize, header.chunkSize);
+
+    // the chunks are appended after the index in the order they are
+    // compressed
+    vector<ChunkedStoreIndexEntry> index(header.numChunks);
+    atomic<uint64_t> file_size(sizeof(header) +
+                               index.size() * sizeof(index[0]));
+
+    parallelFor(checkpointThreads, header.numChunks, [&](uint64_t i) {
+        const uint8_t *chunk = pmem + i * header.chunkSize;
+        uLong chunk_size = min<uint64_t>(header.chunkSize,
+                                         header.storeSize -
+                                         i * header.chunkSize);
+
+        index[i].offset = 0;
+        index[i].size = 0;
+        if (isZero(chunk, chunk_size))
+            return;
+
+        uLongf compressed_size = compressBound(chunk_size);
+        unique_ptr<uint8_t[]> compressed(new uint8_t[compressed_size]);
+        const uint8_t *data = chunk;
+        uint64_t size = chunk_size;
+        if (compress(compressed.get(), &compressed_size,
+                     chunk, chunk_size) == Z_OK &&
+            compressed_size < chunk_size) {
+            data = compressed.get();
+            size = compressed_size;
+        }
+
+        index[i].offset = file_size.fetch_add(size);
+        index[i].size = size;
+        writeFully(fd, data, size, index[i].offset, filepath);
+    });
+
+    writeFully(fd, (const uint8_t *)&header, sizeof(header), 0, filepath);
+    writeFully(fd, (const uint8_t *)index.data(),
+               index.size() * sizeof(index[0]), sizeof(header), filepath);
+
+    if (close(fd) != 0)
+        fatal("Close failed on physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+}
+
 void
 PhysicalMemory::unserialize(CheckpointIn &cp)
 {
@@ -394,8 +679,6 @@ PhysicalMemory::unserialize(CheckpointIn &cp)
 void
 PhysicalMemory::unserializeStore(CheckpointIn &cp)
 {
-    const uint32_t chunk_size = 16384;
-
     unsigned int store_id;
     UNSERIALIZE_SCALAR(store_id);
 
@@ -403,10 +686,9 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
     UNSERIALIZE_SCALAR(filename);
     string filepath = cp.getCptDir() + "/" + filename;
 
-    // mmap memoryfile
-    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
-    if (compressed_mem == NULL)
-        fatal("Can't open physical memory checkpoint file '%s'", filename);
+    // checkpoints predating the raw format are always compressed
+    string format = "gzip";
+    UNSERIALIZE_OPT_SCALAR(format);
 
     // we've already got the actual backing store mapped
     uint8_t* pmem = backingStore[store_id].pmem;
@@ -422,6 +704,35 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
         fatal("Memory range size has changed! Saw %lld, expected %lld\n",
               range_size, range.size());
 
+    // The gzip and chunked formats leave out zeros, which only works
+    // if the store is all zeros to start with, and not backed by a
+    // shared image.
+    if (format != "raw" && backingStore[store_id].fileMapped) {
+        clearStore(range, pmem);
+        backingStore[store_id].fileMapped = false;
+    }
+
+    if (format == "raw")
+        unserializeStoreRaw(filepath, range, pmem);
+    else if (format == "chunked")
+        unserializeStoreChunked(filepath, range, pmem);
+    else if (format == "gzip")
+        unserializeStoreGzip(filepath, range, pmem);
+    else
+        fatal("Unknown format '%s' of physical memory checkpoint file '%s'\n",
+              format, filename);
+}
+
+void
+PhysicalMemory::unserializeStoreGzip(const string &filepath, AddrRange range,
+                                     uint8_t *pmem)
+{
+    const uint32_t chunk_size = 16384;
+
+    gzFile compressed_mem = gzopen(filepath.c_str(), "rb");
+    if (compressed_mem == NULL)
+        fatal("Can't open physical memory checkpoint file '%s'", filepath);
+
     uint64_t curr_size = 0;
     long* temp_page = new long[chunk_size];
     long* pmem_current;
@@ -448,5 +759,142 @@ PhysicalMemory::unserializeStore(CheckpointIn &cp)
 
     if (gzclose(compressed_mem))
         fatal("Close failed on physical memory checkpoint file '%s'\n",
-              filename);
+              filepath);
+}
+
+void
+PhysicalMemory::unserializeStoreRaw(const string &filepath, AddrRange range,
+                                    uint8_t *pmem)
+{
+    mapStoreFile(filepath, range, pmem, true);
+}
+
+void
+PhysicalMemory::mapStoreFile(const string &filepath, AddrRange range,
+                             uint8_t *pmem, bool exact)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory file '%s': %s\n",
+              filepath, strerror(errno));
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+        fatal("Can't stat physical memory file '%s': %s\n",
+              filepath, strerror(errno));
+    fatal_if(exact ? (uint64_t)st.st_size != range.size() :
+             (uint64_t)st.st_size > range.size(),
+             "Physical memory file '%s' has size %lld, expected %s%lld\n",
+             filepath, st.st_size, exact ? "" : "at most ", range.size());
+
+    // The part of the last page past the end of the file reads as
+    // zeros, further pages would fault, and are left to the
+    // anonymous backing store.
+    const uint64_t map_size = min<uint64_t>(
+        roundUp((uint64_t)st.st_size, (uint64_t)sysconf(_SC_PAGESIZE)),
+        range.size());
+    if (map_size == 0) {
+        close(fd);
+        return;
+    }
+
+    // Map the file on top of the anonymous backing store, so that
+    // the memories keep pointing to the same host addresses.
+    int map_flags = MAP_PRIVATE | MAP_FIXED;
+    if (mmapUsingNoReserve)
+        map_flags |= MAP_NORESERVE;
+
+    void *mapped = mmap(pmem, map_size, PROT_READ | PROT_WRITE,
+                        map_flags, fd, 0);
+    if (mapped == MAP_FAILED)
+        fatal("Could not mmap physical memory file '%s': %s\n",
+              filepath, strerror(errno));
+    panic_if(mapped != pmem, "Physical memory file '%s' mapped at %p, "
+             "not %p\n", filepath, mapped, pmem);
+
+    // the mapping holds its own reference to the file
+    close(fd);
+}
+
+void
+PhysicalMemory::clearStore(AddrRange range, uint8_t *pmem)
+{
+    int map_flags = MAP_ANON | MAP_PRIVATE | MAP_FIXED;
+    if (mmapUsingNoReserve)
+        map_flags |= MAP_NORESERVE;
+
+    void *mapped = mmap(pmem, range.size(), PROT_READ | PROT_WRITE,
+                        map_flags, -1, 0);
+    if (mapped == MAP_FAILED)
+        fatal("Could not mmap %d bytes for range %s: %s\n", range.size(),
+              range.to_string(), strerror(errno));
+    panic_if(mapped != pmem, "Backing store for range %s mapped at %p, "
+             "not %p\n", range.to_string(), mapped, pmem);
+}
+
+void
+PhysicalMemory::unserializeStoreChunked(const string &filepath,
+                                        AddrRange range, uint8_t *pmem)
+{
+    int fd = open(filepath.c_str(), O_RDONLY);
+    if (fd < 0)
+        fatal("Can't open physical memory checkpoint file '%s': %s\n",
+              filepath, strerror(errno));
+
+    ChunkedStoreHeader header;
+    readFully(fd, (uint8_t *)&header, sizeof(header), 0, filepath);
+    fatal_if(memcmp(header.magic, chunkedStoreMagic,
+                    sizeof(header.magic)) != 0 ||
+             header.version != chunkedStoreVersion,
+             "'%s' is not a chunked physical memory checkpoint file\n",
+             filepath);
+    fatal_if(header.storeSize != range.size() || header.chunkSize == 0 ||
+             header.numChunks != divCeil(header.storeSize,
+                                         header.chunkSize),
+             "Physical memory checkpoint file '%s' is corrupted\n",
+             filepath);
+
+    vector<ChunkedStoreIndexEntry> index(header.numChunks);
+    readFully(fd, (uint8_t *)index.data(), index.size() * sizeof(index[0]),
+              sizeof(header), filepath);
+
+    const uint64_t page_size = sysconf(_SC_PAGESIZE);
+
+    parallelFor(checkpointThreads, header.numChunks, [&](uint64_t i) {
+        // the backing store is still all zeros
+        if (index[i].size == 0)
+            return;
+
+        uint8_t *chunk = pmem + i * header.chunkSize;
+        uLongf chunk_size = min<uint64_t>(header.chunkSize,
+                                          header.storeSize -
+                                          i * header.chunkSize);
+        fatal_if(index[i].size > chunk_size,
+                 "Physical memory checkpoint file '%s' is corrupted\n",
+                 filepath);
+
+        unique_ptr<uint8_t[]> data(new uint8_t[index[i].size]);
+        readFully(fd, data.get(), index[i].size, index[i].offset, filepath);
+
+        if (index[i].size < chunk_size) {
+            unique_ptr<uint8_t[]> compressed(move(data));
+            data.reset(new uint8_t[chunk_size]);
+            uLongf size = chunk_size;
+            fatal_if(uncompress(data.get(), &size, compressed.get(),
+                                index[i].size) != Z_OK || size != chunk_size,
+                     "Failed to decompress chunk %d of physical memory "
+                     "checkpoint file '%s'\n", i, filepath);
+        }
+
+        // Only copy the pages that are non-zero, so that the parts of
+        // the backing store the simulated system never touched do not
+        // take up host memory.
+        for (uint64_t offset = 0; offset < chunk_size; offset += page_size) {
+            uint64_t len = min<uint64_t>(page_size, chunk_size - offset);
+            if (!isZero(data.get() + offset, len))
+                memcpy(chunk + offset, data.get() + offset, len);
+        }
+    });
+
+    close(fd);
 }
@@ -39,6 +39,7 @@
 #define __MEM_PHYSICAL_HH__
 
 #include "base/addr_range_map.hh"
+#include "enums/MemoryCheckpointFormat.hh"
 #include "mem/packet.hh"
 
 /**
@@ -60,7 +61,7 @@ class BackingStoreEntry
     BackingStoreEntry(AddrRange range, uint8_t* pmem,
                       bool conf_table_reported, bool in_addr_map, bool kvm_map)
         : range(range), pmem(pmem), confTableReported(conf_table_reported),
-          inAddrMap(in_addr_map), kvmMap(kvm_map)
+          inAddrMap(in_addr_map), kvmMap(kvm_map), fileMapped(false)
         {}
 
     /**
@@ -89,6 +90,12 @@ class BackingStoreEntry
       * acceleration.
       */
      bool kvmMap;
+
+     /**
+      * Whether a file, e.g. a shared image, is mapped over the start
+      * of this store, in which case it does not only contain zeros.
+      */
+     bool fileMapped;
 };
 
 /**
@@ -127,6 +134,12 @@ class PhysicalMemory : public Serializable
     // Let the user choose if we reserve swap space when calling mmap
     const bool mmapUsingNoReserve;
 
+    // Format used for the backing stores when checkpointing
+    const Enums::MemoryCheckpointFormat checkpointFormat;
+
+    // Number of host threads used to write and read chunked checkpoints
+    const unsigned checkpointThreads;
+
     // The physical memory used to provide the memory in the simulated
     // system
     std::vector<BackingStoreEntry> backingStore;
@@ -151,6 +164,72 @@ class PhysicalMemory : public Serializable
                             bool conf_table_reported,
                             bool in_addr_map, bool kvm_map);
 
+    /**
+     * Map a file privately over the start of a backing store, so that
+     * its pages are read on demand, are shared through the page cache
+     * with other simulations mapping the same file, and writes by the
+     * simulated system never reach the file.
+     *
+     * @param filepath The file to map
+     * @param range The address range of the backing store
+     * @param pmem The backing store
+     * @param exact Whether the file must be the size of the store,
+     * rather than at most its size
+     */
+    void mapStoreFile(const std::string &filepath, AddrRange range,
+                      uint8_t *pmem, bool exact);
+
+    /**
+     * Replace the contents of a backing store with anonymous zero
+     * pages, dropping any file mapped over it.
+     *
+     * @param range The address range of the backing store
+     * @param pmem The host address of the backing store
+     */
+    void clearStore(AddrRange range, uint8_t *pmem);
+
+    /**
+     * Write a backing store to a compressed checkpoint file.
+     */
+    void serializeStoreGzip(const std::string &filepath,
+                            AddrRange range, const uint8_t *pmem) const;
+
+    /**
+     * Write a backing store to an uncompressed checkpoint file which
+     * is an exact image of the store. Pages that only contain zeros
+     * are not written, and are left as holes in the file.
+     */
+    void serializeStoreRaw(const std::string &filepath,
+                           AddrRange range, const uint8_t *pmem) const;
+
+    /**
+     * Write a backing store to a checkpoint file made of independently
+     * compressed chunks, using multiple host threads. Chunks that only
+     * contain zeros are not written.
+     */
+    void serializeStoreChunked(const std::string &filepath,
+                               AddrRange range, const uint8_t *pmem) const;
+
+    /**
+     * Read a backing store from a compressed checkpoint file.
+     */
+    void unserializeStoreGzip(const std::string &filepath,
+                              AddrRange range, uint8_t *pmem);
+
+    /**
+     * Restore a backing store by mapping a raw checkpoint file in
+     * place of it, see mapStoreFile().
+     */
+    void unserializeStoreRaw(const std::string &filepath,
+                             AddrRange range, uint8_t *pmem);
+
+    /**
+     * Read a backing store from a chunked checkpoint file, using
+     * multiple host threads.
+     */
+    void unserializeStoreChunked(const std::string &filepath,
+                                 AddrRange range, uint8_t *pmem);
+
   public:
 
     /**
@@ -158,7 +237,9 @@ class PhysicalMemory : public Serializable
      */
     PhysicalMemory(const std::string& _name,
                    const std::vector<AbstractMemory*>& _memories,
-                   bool mmap_using_noreserve);
+                   bool mmap_using_noreserve,
+                   Enums::MemoryCheckpointFormat checkpoint_format,
+                   unsigned checkpoint_threads);
 
     /**
      * Unmap all the backing store we have used.
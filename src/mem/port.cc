@@ -94,7 +94,7 @@ MasterPort::getAddrRanges() const
 void
 MasterPort::printAddr(Addr a)
 {
-    auto req = std::make_shared<Request>(
+    RequestPtr req = new Request(
         a, 1, 0, Request::funcMasterId);
 
     Packet pkt(req, MemCmd::PrintReq);
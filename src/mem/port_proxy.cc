@@ -46,7 +46,7 @@ PortProxy::readBlobPhys(Addr addr, Request::Flags flags,
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        RequestPtr req = new Request(
             gen.addr(), gen.size(), flags, Request::funcMasterId);
 
         Packet pkt(req, MemCmd::ReadReq);
@@ -63,7 +63,7 @@ PortProxy::writeBlobPhys(Addr addr, Request::Flags flags,
     for (ChunkGenerator gen(addr, size, _cacheLineSize); !gen.done();
          gen.next()) {
 
-        auto req = std::make_shared<Request>(
+        RequestPtr req = new Request(
             gen.addr(), gen.size(), flags, Request::funcMasterId);
 
         Packet pkt(req, MemCmd::WriteReq);
@@ -41,6 +41,7 @@
 #include "mem/protocol/atomic.hh"
 
 #include "base/trace.hh"
+#include "base/trace_filter.hh"
 
 /* The request protocol. */
 
@@ -48,6 +49,7 @@ Tick
 AtomicRequestProtocol::send(AtomicResponseProtocol *peer, PacketPtr pkt)
 {
     assert(pkt->isRequest());
+    Trace::AddrScope scope(pkt->getAddr());
     return peer->recvAtomic(pkt);
 }
 
@@ -56,6 +58,7 @@ AtomicRequestProtocol::sendBackdoor(AtomicResponseProtocol *peer,
         PacketPtr pkt, MemBackdoorPtr &backdoor)
 {
     assert(pkt->isRequest());
+    Trace::AddrScope scope(pkt->getAddr());
     return peer->recvAtomicBackdoor(pkt, backdoor);
 }
 
@@ -65,5 +68,6 @@ Tick
 AtomicResponseProtocol::sendSnoop(AtomicRequestProtocol *peer, PacketPtr pkt)
 {
     assert(pkt->isRequest());
+    Trace::AddrScope scope(pkt->getAddr());
     return peer->recvAtomicSnoop(pkt);
 }
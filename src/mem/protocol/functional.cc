@@ -40,6 +40,8 @@
 
 #include "mem/protocol/functional.hh"
 
+#include "base/trace_filter.hh"
+
 /* The request protocol. */
 
 void
@@ -47,6 +49,7 @@ FunctionalRequestProtocol::send(
         FunctionalResponseProtocol *peer, PacketPtr pkt) const
 {
     assert(pkt->isRequest());
+    Trace::AddrScope scope(pkt->getAddr());
     return peer->recvFunctional(pkt);
 }
 
@@ -57,5 +60,6 @@ FunctionalResponseProtocol::sendSnoop(
         FunctionalRequestProtocol *peer, PacketPtr pkt) const
 {
     assert(pkt->isRequest());
+    Trace::AddrScope scope(pkt->getAddr());
     return peer->recvFunctionalSnoop(pkt);
 }
@@ -40,12 +40,15 @@
 
 #include "mem/protocol/timing.hh"
 
+#include "base/trace_filter.hh"
+
 /* The request protocol. */
 
 bool
 TimingRequestProtocol::sendReq(TimingResponseProtocol *peer, PacketPtr pkt)
 {
     assert(pkt->isRequest());
+    Trace::AddrScope scope(pkt->getAddr());
     return peer->recvTimingReq(pkt);
 }
 
@@ -62,6 +65,7 @@ TimingRequestProtocol::sendSnoopResp(
         TimingResponseProtocol *peer, PacketPtr pkt)
 {
     assert(pkt->isResponse());
+    Trace::AddrScope scope(pkt->getAddr());
     return peer->recvTimingSnoopResp(pkt);
 }
 
@@ -77,6 +81,7 @@ bool
 TimingResponseProtocol::sendResp(TimingRequestProtocol *peer, PacketPtr pkt)
 {
     assert(pkt->isResponse());
+    Trace::AddrScope scope(pkt->getAddr());
     return peer->recvTimingResp(pkt);
 }
 
@@ -85,6 +90,7 @@ TimingResponseProtocol::sendSnoopReq(
         TimingRequestProtocol *peer, PacketPtr pkt)
 {
     assert(pkt->isRequest());
+    Trace::AddrScope scope(pkt->getAddr());
     peer->recvTimingSnoopReq(pkt);
 }
 
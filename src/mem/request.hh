@@ -54,6 +54,8 @@
 #include "base/amo.hh"
 #include "base/flags.hh"
 #include "base/logging.hh"
+#include "base/refcnt.hh"
+#include "base/slab_alloc.hh"
 #include "base/types.hh"
 #include "cpu/inst_seq.hh"
 #include "sim/core.hh"
@@ -80,7 +82,7 @@ class Packet;
 class Request;
 class ThreadContext;
 
-typedef std::shared_ptr<Request> RequestPtr;
+typedef RefCountingPtr<Request> RequestPtr;
 typedef uint16_t MasterID;
 
 class Request
@@ -360,6 +362,13 @@ class Request
 
     LocalAccessor _localAccessor;
 
+    /**
+     * Number of RequestPtr referencing this request. As for the other
+     * reference counted objects (see base/refcnt.hh), the count is
+     * not atomic.
+     */
+    mutable int refCount = 0;
+
   public:
 
     /**
@@ -410,6 +419,23 @@ class Request
 
     ~Request() {}
 
+    /**
+     * Requests are allocated from a per-thread pool rather than from
+     * the heap, as one is created for every memory access.
+     * @{
+     */
+    static void *operator new(std::size_t size);
+    static void operator delete(void *ptr);
+    /** @} */
+
+    /**
+     * Reference counting interface used by RequestPtr.
+     * @{
+     */
+    void incref() const { ++refCount; }
+    void decref() const { if (--refCount <= 0) delete this; }
+    /** @} */
+
     /**
      * Set up Context numbers.
      */
@@ -483,8 +509,8 @@ class Request
         assert(privateFlags.isSet(VALID_VADDR));
         assert(privateFlags.noneSet(VALID_PADDR));
         assert(split_addr > _vaddr && split_addr < _vaddr + _size);
-        req1 = std::make_shared<Request>(*this);
-        req2 = std::make_shared<Request>(*this);
+        req1 = new Request(*this);
+        req2 = new Request(*this);
         req1->_size = split_addr - _vaddr;
         req2->_vaddr = split_addr;
         req2->_size = _size - req1->_size;
@@ -935,4 +961,19 @@ class Request
     /** @} */
 };
 
+typedef SlabAllocator<Request, sizeof(Request)> RequestAllocator;
+
+inline void *
+Request::operator new(std::size_t size)
+{
+    assert(size == sizeof(Request));
+    return RequestAllocator::allocate();
+}
+
+inline void
+Request::operator delete(void *ptr)
+{
+    RequestAllocator::release(ptr);
+}
+
 #endif // __MEM_REQUEST_HH__
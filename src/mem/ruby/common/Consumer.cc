@@ -39,6 +39,18 @@ Consumer::scheduleEvent(Cycles timeDelta)
 void
 Consumer::scheduleEventAbsolute(Tick evt_time)
 {
+    if (inParallelMode && wakeupEventQueue() != curEventQueue()) {
+        // The wakeup is requested by an object simulated by another
+        // thread. The set of scheduled wakeups belongs to the thread
+        // of the consumer, so let it do the bookkeeping when the
+        // wakeup time is reached.
+        auto *evt = new EventFunctionWrapper(
+            [this, evt_time]{ scheduleEventAbsolute(evt_time); },
+            "Consumer Remote Event", true);
+        em->schedule(evt, evt_time);
+        return;
+    }
+
     if (!alreadyScheduled(evt_time)) {
         // This wakeup is not redundant
         auto *evt = new EventFunctionWrapper(
@@ -70,6 +70,9 @@ class Consumer
 
     void scheduleEventAbsolute(Tick timeAbs);
 
+    //! Event queue in which the wakeups of this consumer are processed
+    EventQueue *wakeupEventQueue() const { return em->eventQueue(); }
+
   protected:
     void scheduleEvent(Cycles timeDelta);
 
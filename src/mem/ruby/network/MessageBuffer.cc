@@ -161,6 +161,12 @@ random_time()
 void
 MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
 {
+    assert(m_consumer != NULL);
+    if (inParallelMode && m_consumer->wakeupEventQueue() != curEventQueue()) {
+        enqueueRemote(message, current_time, delta);
+        return;
+    }
+
     // record current time incase we have a pop that also adjusts my size
     if (m_time_last_time_enqueue < current_time) {
         m_msgs_this_cycle = 0;  // first msg this cycle
@@ -234,6 +240,79 @@ MessageBuffer::enqueue(MsgPtr message, Tick current_time, Tick delta)
     m_consumer->storeEventInfo(m_vnet_id);
 }
 
+void
+MessageBuffer::enqueueRemote(MsgPtr message, Tick current_time, Tick delta)
+{
+    // The producer and the consumer are simulated in parallel, and only
+    // synchronize at the end of every quantum. The message can only be
+    // delivered on time if it arrives after the end of the current
+    // quantum, hence the latency of the links between event queues is
+    // the lookahead bounding the simulation quantum.
+    fatal_if(delta < simQuantum, "%s: Message latency (%d) between event "
+             "queues smaller than the simulation quantum (%d).\n",
+             name(), delta, simQuantum);
+    fatal_if(m_max_size != 0, "%s: Message buffers between event queues "
+             "must have an infinite size.\n", name());
+    fatal_if(m_randomization || RubySystem::getRandomization(),
+             "%s: Message buffers between event queues can't be "
+             "randomized.\n", name());
+
+    Tick arrival_time = current_time + delta;
+
+    Message* msg_ptr = message.get();
+    assert(msg_ptr != NULL);
+
+    assert(current_time >= msg_ptr->getLastEnqueueTime() &&
+           "ensure we aren't dequeued early");
+
+    msg_ptr->updateDelayedTicks(current_time);
+    msg_ptr->setLastEnqueueTime(arrival_time);
+
+    {
+        std::lock_guard<std::mutex> lock(m_remote_lock);
+        if (m_strict_fifo && arrival_time < m_last_arrival_time) {
+            panic("FIFO ordering violated: %s name: %s current time: %d "
+                  "delta: %d arrival_time: %d last arrival_time: %d\n",
+                  *this, name(), current_time, delta, arrival_time,
+                  m_last_arrival_time);
+        }
+        m_last_arrival_time = arrival_time;
+        m_remote_msgs.push_back(message);
+    }
+
+    DPRINTF(RubyQueue, "Remote enqueue arrival_time: %lld, Message: %s\n",
+            arrival_time, *msg_ptr);
+
+    // Hand the message over to the consumer's thread when it arrives.
+    auto *evt = new EventFunctionWrapper([this]{ receiveRemote(); },
+                                         "MessageBuffer Remote Event", true);
+    m_consumer->wakeupEventQueue()->schedule(evt, arrival_time);
+}
+
+void
+MessageBuffer::receiveRemote()
+{
+    std::vector<MsgPtr> msgs;
+    {
+        std::lock_guard<std::mutex> lock(m_remote_lock);
+        msgs.swap(m_remote_msgs);
+    }
+
+    for (auto &message : msgs) {
+        const Tick arrival_time = message->getLastEnqueueTime();
+
+        m_msg_counter++;
+        message->setMsgCounter(m_msg_counter);
+
+        m_prio_heap.push_back(message);
+        push_heap(m_prio_heap.begin(), m_prio_heap.end(), greater<MsgPtr>());
+        m_buf_msgs++;
+
+        m_consumer->scheduleEventAbsolute(arrival_time);
+        m_consumer->storeEventInfo(m_vnet_id);
+    }
+}
+
 Tick
 MessageBuffer::dequeue(Tick current_time, bool decrement_messages)
 {
@@ -484,6 +563,17 @@ MessageBuffer::functionalAccess(Packet *pkt, bool is_read)
         }
     }
 
+    // Check the messages sent by other event queues, which have not
+    // been handed over to the consumer yet.
+    std::lock_guard<std::mutex> lock(m_remote_lock);
+    for (auto &message : m_remote_msgs) {
+        Message *msg = message.get();
+        if (is_read && msg->functionalRead(pkt))
+            return 1;
+        else if (!is_read && msg->functionalWrite(pkt))
+            num_functional_accesses++;
+    }
+
     return num_functional_accesses;
 }
 
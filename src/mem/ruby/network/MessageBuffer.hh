@@ -50,6 +50,7 @@
 #include <cassert>
 #include <functional>
 #include <iostream>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -164,6 +165,13 @@ class MessageBuffer : public SimObject
 
     uint32_t functionalAccess(Packet *pkt, bool is_read);
 
+    //! Enqueue a message sent by an object simulated by another thread
+    //! than the consumer of this buffer.
+    void enqueueRemote(MsgPtr message, Tick current_time, Tick delta);
+    //! Move the messages sent by other threads to the priority heap.
+    //! Called in the thread of the consumer when they arrive.
+    void receiveRemote();
+
   private:
     // Data Members (m_ prefix)
     //! Consumer to signal a wakeup(), can be NULL
@@ -172,6 +180,11 @@ class MessageBuffer : public SimObject
 
     std::function<void()> m_dequeue_callback;
 
+    //! Messages sent from other event queues, waiting to be moved to
+    //! the priority heap by the thread of the consumer
+    std::vector<MsgPtr> m_remote_msgs;
+    std::mutex m_remote_lock;
+
     // use a std::map for the stalled messages as this container is
     // sorted and ensures a well-defined iteration order
     typedef std::map<Addr, std::list<MsgPtr> > StallMsgMapType;
@@ -107,6 +107,24 @@ GarnetNetwork::init()
     assert(m_topology_ptr != NULL);
     m_topology_ptr->createLinks(this);
 
+    // Routers, interfaces and links exchange flits and credits through
+    // shared buffers, they can't be simulated by different threads.
+    // Only the message buffers to and from the controllers can cross
+    // event queues.
+    auto check_eventq = [this](const ClockedObject *obj) {
+        fatal_if(obj->eventQueue() != eventQueue(),
+                 "%s: Garnet network components must all be in the event "
+                 "queue of the network.\n", obj->name());
+    };
+    for (auto router : m_routers)
+        check_eventq(router);
+    for (auto ni : m_nis)
+        check_eventq(ni);
+    for (auto link : m_networklinks)
+        check_eventq(link);
+    for (auto link : m_creditlinks)
+        check_eventq(link);
+
     // Initialize topology specific parameters
     if (getNumRows() > 0) {
         // Only for Mesh topology
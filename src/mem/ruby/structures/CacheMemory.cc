@@ -86,6 +86,7 @@ CacheMemory::init()
 
     m_cache.resize(m_cache_num_sets,
                     std::vector<AbstractCacheEntry*>(m_cache_assoc, nullptr));
+    m_tag_index.reserve(m_cache_num_sets * m_cache_assoc);
     replacement_data.resize(m_cache_num_sets,
                                std::vector<ReplData>(m_cache_assoc, nullptr));
     // instantiate all the replacement_data here
@@ -124,11 +125,10 @@ CacheMemory::findTagInSet(int64_t cacheSet, Addr tag) const
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        if (m_cache[cacheSet][it->second]->m_Permission !=
-            AccessPermission_NotPresent)
-            return it->second;
+    const int *way = m_tag_index.find(tag);
+    if (way && m_cache[cacheSet][*way]->m_Permission !=
+        AccessPermission_NotPresent)
+        return *way;
     return -1; // Not found
 }
 
@@ -140,10 +140,8 @@ CacheMemory::findTagInSetIgnorePermissions(int64_t cacheSet,
 {
     assert(tag == makeLineAddress(tag));
     // search the set for the tags
-    auto it = m_tag_index.find(tag);
-    if (it != m_tag_index.end())
-        return it->second;
-    return -1; // Not found
+    const int *way = m_tag_index.find(tag);
+    return way ? *way : -1;
 }
 
 // Given an unique cache block identifier (idx): return the valid address
@@ -29,8 +29,10 @@
 #ifndef __MEM_RUBY_STRUCTURES_PERFECTCACHEMEMORY_HH__
 #define __MEM_RUBY_STRUCTURES_PERFECTCACHEMEMORY_HH__
 
-#include <unordered_map>
+#include <deque>
+#include <vector>
 
+#include "base/flat_hash_map.hh"
 #include "mem/ruby/common/Address.hh"
 #include "mem/ruby/protocol/AccessPermission.hh"
 
@@ -87,8 +89,17 @@ class PerfectCacheMemory
     PerfectCacheMemory(const PerfectCacheMemory& obj);
     PerfectCacheMemory& operator=(const PerfectCacheMemory& obj);
 
+    // Get the state of a line, allocating it if it is not present
+    PerfectCacheLineState<ENTRY> &lineState(Addr address);
+    const PerfectCacheLineState<ENTRY> *findLineState(Addr address) const;
+
     // Data Members (m_prefix)
-    std::unordered_map<Addr, PerfectCacheLineState<ENTRY> > m_map;
+    // The map gives the position of the state of a line in m_lines,
+    // where it stays until the line is deallocated, so that pointers
+    // to entries stay valid.
+    FlatHashMap<Addr, int> m_map;
+    std::deque<PerfectCacheLineState<ENTRY> > m_lines;
+    std::vector<int> m_free_lines;
 };
 
 template<class ENTRY>
@@ -106,12 +117,40 @@ PerfectCacheMemory<ENTRY>::PerfectCacheMemory()
 {
 }
 
+template<class ENTRY>
+inline PerfectCacheLineState<ENTRY> &
+PerfectCacheMemory<ENTRY>::lineState(Addr address)
+{
+    Addr line_address = makeLineAddress(address);
+    if (const int *index = m_map.find(line_address))
+        return m_lines[*index];
+
+    if (m_free_lines.empty()) {
+        m_map[line_address] = m_lines.size();
+        m_lines.emplace_back();
+        return m_lines.back();
+    } else {
+        int index = m_free_lines.back();
+        m_free_lines.pop_back();
+        m_map[line_address] = index;
+        return m_lines[index];
+    }
+}
+
+template<class ENTRY>
+inline const PerfectCacheLineState<ENTRY> *
+PerfectCacheMemory<ENTRY>::findLineState(Addr address) const
+{
+    const int *index = m_map.find(makeLineAddress(address));
+    return index ? &m_lines[*index] : nullptr;
+}
+
 // tests to see if an address is present in the cache
 template<class ENTRY>
 inline bool
 PerfectCacheMemory<ENTRY>::isTagPresent(Addr address) const
 {
-    return m_map.count(makeLineAddress(address)) > 0;
+    return findLineState(address) != nullptr;
 }
 
 template<class ENTRY>
@@ -127,10 +166,9 @@ template<class ENTRY>
 inline void
 PerfectCacheMemory<ENTRY>::allocate(Addr address)
 {
-    PerfectCacheLineState<ENTRY> line_state;
+    PerfectCacheLineState<ENTRY>& line_state = lineState(address);
     line_state.m_permission = AccessPermission_Invalid;
     line_state.m_entry = ENTRY();
-    m_map[makeLineAddress(address)] = line_state;
 }
 
 // deallocate entry
@@ -138,7 +176,14 @@ template<class ENTRY>
 inline void
 PerfectCacheMemory<ENTRY>::deallocate(Addr address)
 {
-    m_map.erase(makeLineAddress(address));
+    Addr line_address = makeLineAddress(address);
+    const int *index = m_map.find(line_address);
+    if (!index)
+        return;
+
+    m_lines[*index] = PerfectCacheLineState<ENTRY>();
+    m_free_lines.push_back(*index);
+    m_map.erase(line_address);
 }
 
 // Returns with the physical address of the conflicting cache line
@@ -155,7 +200,7 @@ template<class ENTRY>
 inline ENTRY*
 PerfectCacheMemory<ENTRY>::lookup(Addr address)
 {
-    return &m_map[makeLineAddress(address)].m_entry;
+    return &lineState(address).m_entry;
 }
 
 // looks an address up in the cache
@@ -163,14 +208,16 @@ template<class ENTRY>
 inline const ENTRY*
 PerfectCacheMemory<ENTRY>::lookup(Addr address) const
 {
-    return &m_map[makeLineAddress(address)].m_entry;
+    const PerfectCacheLineState<ENTRY> *line_state = findLineState(address);
+    return line_state ? &line_state->m_entry : nullptr;
 }
 
 template<class ENTRY>
 inline AccessPermission
 PerfectCacheMemory<ENTRY>::getPermission(Addr address) const
 {
-    return m_map[makeLineAddress(address)].m_permission;
+    const PerfectCacheLineState<ENTRY> *line_state = findLineState(address);
+    return line_state ? line_state->m_permission : AccessPermission_NUM;
 }
 
 template<class ENTRY>
@@ -178,8 +225,7 @@ inline void
 PerfectCacheMemory<ENTRY>::changePermission(Addr address,
                                             AccessPermission new_perm)
 {
-    Addr line_address = makeLineAddress(address);
-    PerfectCacheLineState<ENTRY>& line_state = m_map[line_address];
+    PerfectCacheLineState<ENTRY>& line_state = lineState(address);
     line_state.m_permission = new_perm;
 }
 
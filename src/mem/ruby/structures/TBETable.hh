@@ -41,9 +41,11 @@
 #ifndef __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 #define __MEM_RUBY_STRUCTURES_TBETABLE_HH__
 
+#include <deque>
 #include <iostream>
-#include <unordered_map>
+#include <vector>
 
+#include "base/flat_hash_map.hh"
 #include "mem/ruby/common/Address.hh"
 
 template<class ENTRY>
@@ -53,6 +55,7 @@ class TBETable
     TBETable(int number_of_TBEs)
         : m_number_of_TBEs(number_of_TBEs)
     {
+        m_map.reserve(number_of_TBEs);
     }
 
     bool isPresent(Addr address) const;
@@ -76,7 +79,12 @@ class TBETable
     TBETable& operator=(const TBETable& obj);
 
     // Data Members (m_prefix)
-    std::unordered_map<Addr, ENTRY> m_map;
+    // The map gives the position of the TBE of an address in
+    // m_entries. The TBEs are kept out of the map since their
+    // addresses have to stay the same while they are allocated.
+    FlatHashMap<Addr, int> m_map;
+    std::deque<ENTRY> m_entries;
+    std::vector<int> m_free_entries;
 
   private:
     int m_number_of_TBEs;
@@ -106,7 +114,13 @@ TBETable<ENTRY>::allocate(Addr address)
 {
     assert(!isPresent(address));
     assert(m_map.size() < m_number_of_TBEs);
-    m_map[address] = ENTRY();
+    if (m_free_entries.empty()) {
+        m_map[address] = m_entries.size();
+        m_entries.emplace_back();
+    } else {
+        m_map[address] = m_free_entries.back();
+        m_free_entries.pop_back();
+    }
 }
 
 template<class ENTRY>
@@ -115,6 +129,9 @@ TBETable<ENTRY>::deallocate(Addr address)
 {
     assert(isPresent(address));
     assert(m_map.size() > 0);
+    int index = *m_map.find(address);
+    m_entries[index] = ENTRY();
+    m_free_entries.push_back(index);
     m_map.erase(address);
 }
 
@@ -130,8 +147,8 @@ template<class ENTRY>
 inline ENTRY*
 TBETable<ENTRY>::lookup(Addr address)
 {
-  if (m_map.find(address) != m_map.end()) return &(m_map.find(address)->second);
-  return NULL;
+    const int *index = m_map.find(address);
+    return index ? &m_entries[*index] : NULL;
 }
 
 
@@ -148,6 +148,8 @@ RubySystem::makeCacheRecorder(uint8_t *uncompressed_trace,
 void
 RubySystem::memWriteback()
 {
+    checkSingleEventQueue("flush its caches");
+
     m_cooldown_enabled = true;
 
     // Make the trace so we know what to write back.
@@ -363,6 +365,8 @@ RubySystem::startup()
     // state was checkpointed.
 
     if (m_warmup_enabled) {
+        checkSingleEventQueue("warm up its caches");
+
         DPRINTF(RubyCacheTrace, "Starting ruby cache warmup\n");
         // save the current tick value
         Tick curtick_original = curTick();
@@ -393,6 +397,16 @@ RubySystem::startup()
     resetStats();
 }
 
+void
+RubySystem::checkSingleEventQueue(const char *what) const
+{
+    for (auto cntrl : m_abs_cntrl_vec) {
+        fatal_if(cntrl->eventQueue() != eventq,
+                 "Ruby can't %s when its controllers are split across "
+                 "event queues (%s).\n", what, cntrl->name());
+    }
+}
+
 void
 RubySystem::processRubyEvent()
 {
@@ -409,9 +423,58 @@ RubySystem::resetStats()
     m_start_cycle = curCycle();
 }
 
+namespace
+{
+
+/**
+ * Stop all the simulation threads while a functional access walks
+ * through the controllers, sequencers and buffers of the Ruby system,
+ * which may be simulated by other threads than the caller.
+ *
+ * The caller first releases the lock of its own event queue, then takes
+ * the lock of every queue in index order, so concurrent functional
+ * accesses can't deadlock. The other threads are then either between
+ * two events or waiting on the quantum barrier. As their local time can
+ * differ from the one of the caller, a functional access in a parallel
+ * simulation is not deterministic.
+ */
+class ScopedFunctionalAccess
+{
+  public:
+    ScopedFunctionalAccess()
+        : parallel(inParallelMode && numMainEventQueues > 1),
+          caller(curEventQueue())
+    {
+        if (!parallel)
+            return;
+
+        caller->unlock();
+        for (uint32_t i = 0; i < numMainEventQueues; ++i)
+            mainEventQueue[i]->lock();
+    }
+
+    ~ScopedFunctionalAccess()
+    {
+        if (!parallel)
+            return;
+
+        for (uint32_t i = numMainEventQueues; i > 0; --i)
+            mainEventQueue[i - 1]->unlock();
+        caller->lock();
+    }
+
+  private:
+    const bool parallel;
+    EventQueue *const caller;
+};
+
+} // anonymous namespace
+
 bool
 RubySystem::functionalRead(PacketPtr pkt)
 {
+    ScopedFunctionalAccess scoped_access;
+
     Addr address(pkt->getAddr());
     Addr line_address = makeLineAddress(address);
 
@@ -530,6 +593,8 @@ RubySystem::functionalWrite(PacketPtr pkt)
     AccessPermission access_perm = AccessPermission_NotPresent;
     int num_controllers = m_abs_cntrl_vec.size();
 
+    ScopedFunctionalAccess scoped_access;
+
     DPRINTF(RubySystem, "Functional Write request for %#x\n", addr);
 
     uint32_t M5_VAR_USED num_functional_writes = 0;
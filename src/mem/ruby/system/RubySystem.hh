@@ -117,6 +117,14 @@ class RubySystem : public ClockedObject
                                      uint64_t uncompressed_trace_size);
 
     void processRubyEvent();
+
+    /**
+     * Check that all the controllers are simulated by the same event
+     * queue as the Ruby system. The cache warmup and flush replay a
+     * trace of requests on the queue of the Ruby system only, and can't
+     * deal with controllers simulated in parallel.
+     */
+    void checkSingleEventQueue(const char *what) const;
   private:
     // configuration parameters
     static bool m_randomization;
@@ -81,7 +81,9 @@ SimpleMemory::recvAtomicBackdoor(PacketPtr pkt, MemBackdoorPtr &_backdoor)
 {
     Tick latency = recvAtomic(pkt);
 
-    if (backdoor.ptr())
+    // Don't hand out the back door while some addresses are locked,
+    // as the stores made through it wouldn't be checked against them.
+    if (backdoor.ptr() && lockedAddrList.empty())
         _backdoor = &backdoor;
     return latency;
 }
@@ -115,6 +115,8 @@ def parse_options():
     group("Statistics Options")
     option("--stats-file", metavar="FILE", default="stats.txt",
         help="Sets the output file for statistics [Default: %default]")
+    option("--stats-background", action="store_true", default=False,
+        help="Format and write statistics in a background thread")
     option("--stats-help",
            action="callback", callback=_stats_help,
            help="Display documentation for available stat visitors")
@@ -146,8 +148,26 @@ def parse_options():
         help="End debug output at TICK")
     option("--debug-file", metavar="FILE", default="cout",
         help="Sets the output file for debug [Default: %default]")
+    option("--debug-binary", action='store_true', default=False,
+        help="Record debug output in binary form, to be decoded by "
+             "util/tracedecode (in trace.bin unless --debug-file is set)")
     option("--debug-ignore", metavar="EXPR", action='append', split=':',
         help="Ignore EXPR sim objects")
+    option("--debug-window", metavar="START:END", action='append',
+        help="Only output debug messages from tick START to END "
+             "(may be given more than once)")
+    option("--debug-objects", metavar="GLOB[,GLOB]", action='append',
+        split=',',
+        help="Only output debug messages of sim objects matching GLOB")
+    option("--debug-addr-range", metavar="START:END", action='append',
+        help="Only output debug messages logged while handling packets "
+             "to addresses from START to END (may be given more than once)")
+    option("--profile-events", action='store_true', default=False,
+        help="Account the host time spent in each event and SimObject, "
+             "in hostprof.txt and hostprof.folded (for flame graphs)")
+    option("--profile-events-period", metavar="N", type='int', default=1,
+        help="Only time one event out of N when profiling events "
+             "[Default: %default]")
     option("--remote-gdb-port", type='int', default=7000,
         help="Remote gdb base port (set to 0 to disable listening)")
 
@@ -364,7 +384,8 @@ def main(*args):
     sys.path[0:0] = options.path
 
     # set stats options
-    stats.addStatVisitor(options.stats_file)
+    stats.addStatVisitor(options.stats_file,
+                         background=options.stats_background)
 
     # Disable listeners unless running interactively or explicitly
     # enabled
@@ -419,7 +440,37 @@ def main(*args):
         e = event.create(trace.disable, event.Event.Debug_Enable_Pri)
         event.mainq.schedule(e, options.debug_end)
 
-    trace.output(options.debug_file)
+    if options.profile_events:
+        event.enableProfiling("hostprof", options.profile_events_period)
+
+    if options.debug_binary:
+        # binary traces don't belong on the terminal
+        if options.debug_file in ('cout', 'cerr'):
+            options.debug_file = 'trace.bin'
+        trace.outputBinary(options.debug_file)
+    else:
+        trace.output(options.debug_file)
+
+    def parse_range(option, value):
+        try:
+            start, end = [ int(v, 0) for v in value.split(':') ]
+        except ValueError:
+            fatal("Invalid %s '%s', expected START:END" % (option, value))
+        if start >= end:
+            fatal("Empty %s '%s'" % (option, value))
+        return start, end
+
+    for window in options.debug_window or []:
+        _check_tracing()
+        trace.window(*parse_range("--debug-window", window))
+
+    if options.debug_objects:
+        _check_tracing()
+        trace.objects(*options.debug_objects)
+
+    for addr_range in options.debug_addr_range or []:
+        _check_tracing()
+        trace.addrRange(*parse_range("--debug-addr-range", addr_range))
 
     for ignore in options.debug_ignore:
         _check_tracing()
@@ -40,6 +40,7 @@
 from __future__ import print_function
 
 import atexit
+import collections
 import os
 import sys
 
@@ -49,6 +50,7 @@ import _m5.core
 from _m5.stats import updateEvents as updateStatEvents
 
 from . import stats
+from . import trace
 from . import SimObject
 from . import ticks
 from . import objects
@@ -338,7 +340,6 @@ def fork(simout="%(parent)s.f%(fork_seq)i"):
     Return Value:
       pid of the child process or 0 if running in the child.
     """
-    from m5 import options
     global fork_count
 
     if not _m5.core.listenersDisabled():
@@ -346,28 +347,137 @@ def fork(simout="%(parent)s.f%(fork_seq)i"):
 
     drain()
 
-    try:
-        pid = os.fork()
-    except OSError as e:
-        raise e
+    pid = _forkDrained(simout, { "fork_seq" : fork_count })
+    if pid != 0:
+        fork_count += 1
+
+    return pid
+
+def _forkDrained(simout, fields):
+    """Fork the drained simulator, and move the outputs of the child to
+    the directory simout, formatted with the fields, the parent
+    output directory and the pid of the child."""
+
+    from m5 import options
+
+    stats.prepareFork()
+    trace.prepareFork()
+    sys.stdout.flush()
+    sys.stderr.flush()
+
+    pid = os.fork()
 
     if pid == 0:
         # In child, notify objects of the fork
         root = objects.Root.getInstance()
         notifyFork(root)
         # Setup a new output directory
-        parent = options.outdir
-        options.outdir = simout % {
-                "parent" : parent,
-                "fork_seq" : fork_count,
-                "pid" : os.getpid(),
-                }
+        fields = dict(fields)
+        fields["parent"] = options.outdir
+        fields["pid"] = os.getpid()
+        options.outdir = simout % fields
         _m5.core.setOutputDir(options.outdir)
-    else:
-        fork_count += 1
+
+    # The debug trace is resumed once the trace file of the child has
+    # moved to its output directory
+    trace.afterFork(pid == 0)
 
     return pid
 
+def forkSamples(samples, run, max_parallel=None,
+                simout="%(parent)s.s%(sample)i"):
+    """Simulate samples in forked copies of the simulator.
+
+    This function forks a child simulator per sample, from the state
+    of the simulator when it is called, typically after restoring a
+    checkpoint and warming up. The children share the memory of the
+    parent copy-on-write, so that the samples don't pay for the
+    configuration of the simulator and for restoring the checkpoint,
+    and several samples are simulated at once.
+
+    Each child gets its own output directory, and calls run with the
+    sample it simulates, e.g. the number of instructions to skip
+    before measuring, or parameters to change. The child exits when
+    run returns, with the status it returns, 0 if it returns None.
+
+    Output file formatting dictionary:
+      parent -- Path to the parent process's output directory.
+      sample -- Index of the sample.
+      pid -- PID of the child process.
+
+    Arguments:
+      samples -- Iterable of the samples to simulate.
+      run -- Function simulating a sample in the child.
+
+    Keyword Arguments:
+      max_parallel -- Maximum number of children simulating at once.
+                      Defaults to the number of host cores.
+      simout -- Output directory of each child.
+
+    Return Value:
+      List of the exit status of the children, in the order of the
+      samples. It only returns in the parent.
+    """
+
+    if not _m5.core.listenersDisabled():
+        raise RuntimeError("Can not fork a simulator with listeners enabled")
+
+    if max_parallel is None:
+        import multiprocessing
+        max_parallel = multiprocessing.cpu_count()
+    max_parallel = max(1, max_parallel)
+
+    # The simulator stays drained while the children are forked
+    drain()
+
+    samples = list(samples)
+    status = [ None ] * len(samples)
+    running = collections.OrderedDict()
+
+    def wait_child():
+        # Only wait for the samples, as other children of the simulator,
+        # e.g. background checkpoint writers, are reaped by their owner.
+        # Take any sample that has already finished, or else wait for
+        # the oldest one.
+        for pid in running:
+            done, ret = os.waitpid(pid, os.WNOHANG)
+            if done:
+                break
+        else:
+            pid = next(iter(running))
+            done, ret = os.waitpid(pid, 0)
+        index = running.pop(pid)
+        status[index] = os.WEXITSTATUS(ret) if os.WIFEXITED(ret) else -1
+        if status[index] != 0:
+            print("Sample %i (pid %i) failed with status %i" % \
+                  (index, pid, status[index]))
+
+    for index, sample in enumerate(samples):
+        while len(running) >= max_parallel:
+            wait_child()
+
+        pid = _forkDrained(simout, { "sample" : index })
+        if pid == 0:
+            ret = 1
+            try:
+                ret = run(sample)
+                ret = 0 if ret is None else ret
+            except SystemExit as e:
+                ret = e.code
+            except:
+                import traceback
+                traceback.print_exc()
+            # Exit the way the simulator usually does, which runs the
+            # exit handlers, e.g. to dump the stats of the sample.
+            sys.exit(ret)
+
+        running[pid] = index
+
+    while running:
+        wait_child()
+
+    return status
+
 from _m5.core import disableAllListeners, listenersDisabled
 from _m5.core import listenersLoopbackOnly
 from _m5.core import curTick
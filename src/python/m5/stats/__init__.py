@@ -52,6 +52,8 @@ from _m5.stats import schedStatEvent as schedEvent
 from _m5.stats import periodicStatDump
 
 outputList = []
+# Visitors wrapped by the outputs writing in the background
+_backgroundVisitors = []
 
 # Dictionary of stat visitor factories populated by the _url_factory
 # visitor.
@@ -184,7 +186,38 @@ def _hdf5Factory(fn, chunking=10, desc=True, formulas=True):
 
     return _m5.stats.initHDF5(fn, chunking, desc, formulas)
 
-def addStatVisitor(url):
+@_url_factory([ "columnar", ])
+def _columnarFactory(fn, compress=True, chunking=64):
+    """Output stats in a binary, columnar format.
+
+    Columnar stat files store the names of the stats once, and the
+    values of all the stats as a row of fixed-width numbers at every
+    dump. This makes frequent dumps of many stats cheap to write and
+    fast to load. The files can be read using util/columnar_stats.py.
+
+    Known limitations:
+      * Sparse histograms currently unsupported.
+      * Stat descriptions aren't stored.
+
+    Parameters:
+      * compress (bool): Compress the rows with zlib (default: True)
+      * chunking (unsigned): Number of dumps compressed together
+                             (default: 64)
+
+    Example:
+      columnar://stats.bin?compress=True;chunking=256
+
+    """
+
+    import atexit
+
+    output = _m5.stats.initColumnar(fn, compress, chunking)
+    # Write out the rows still waiting to be compressed after the
+    # final stat dump, which is also an exit handler.
+    atexit.register(output.flush)
+    return output
+
+def addStatVisitor(url, background=False):
     """Add a stat visitor specified using a URL string
 
     Stat visitors are specified using URLs on the following format:
@@ -195,6 +228,10 @@ def addStatVisitor(url):
     parameters are keyword arguments. Parameter values must be valid
     Python literals.
 
+    If background is set, the values of the stats are copied when
+    they are dumped, and the visitor formats and writes them in a
+    separate thread while the simulation goes on.
+
     """
 
     try:
@@ -213,7 +250,35 @@ def addStatVisitor(url):
     if factory is None:
         fatal("Stat type '%s' disabled at compile time" % parsed.scheme)
 
-    outputList.append(factory(parsed))
+    output = factory(parsed)
+    if background:
+        import atexit
+
+        _backgroundVisitors.append(output)
+        output = _m5.stats.initAsync(output)
+        # Wait for the final stat dump, which is also an exit handler,
+        # to be written. This runs before the exit handlers of the
+        # visitor, which were registered by its factory.
+        atexit.register(output.flush)
+
+    outputList.append(output)
+
+def prepareFork():
+    """Prepare the stat visitors for the simulator to be forked
+
+    Rows buffered by columnar visitors are written, so that they don't
+    end up in the files of the child as well. Visitors writing in the
+    background finish writing and stop their thread, which would not
+    exist in the child. It is started again by the next dump.
+
+    """
+
+    for output in outputList:
+        if isinstance(output, _m5.stats.AsyncOutput):
+            output.stop()
+    for output in outputList + _backgroundVisitors:
+        if isinstance(output, _m5.stats.Columnar):
+            output.flush()
 
 def printStatVisitorTypes():
     """List available stat visitors and their documentation"""
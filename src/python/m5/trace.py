@@ -28,4 +28,35 @@ from __future__ import print_function
 from __future__ import absolute_import
 
 # Export native methods to Python
-from _m5.trace import output, ignore, disable, enable
+from _m5.trace import output, outputBinary, ignore, disable, enable
+from _m5.trace import addWindow, clearWindows
+from _m5.trace import addObjectFilter, clearObjectFilters
+from _m5.trace import addAddrRange, clearAddrRanges
+from _m5.trace import prepareFork, afterFork
+
+def window(start, end):
+    """Only output debug messages from tick start up to tick end. Several
+    windows may be set, and the filter applies immediately, even in the
+    middle of a simulation."""
+    if start >= end:
+        raise ValueError("Empty trace window %d:%d" % (start, end))
+    addWindow(start, end)
+
+def objects(*patterns):
+    """Only output the debug messages of objects whose name matches
+    one of the glob patterns, e.g. 'system.cpu*.dcache'."""
+    for pattern in patterns:
+        addObjectFilter(pattern)
+
+def addrRange(start, end):
+    """Only output the debug messages logged while handling packets to
+    addresses from start up to end."""
+    if start >= end:
+        raise ValueError("Empty address range %#x:%#x" % (start, end))
+    addAddrRange(start, end)
+
+def clearFilters():
+    """Remove all the tick, object and address filters"""
+    clearWindows()
+    clearObjectFilters()
+    clearAddrRanges()
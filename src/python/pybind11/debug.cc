@@ -67,6 +67,17 @@ output(const char *filename)
     Trace::setDebugLogger(new Trace::OstreamLogger(*file_stream->stream()));
 }
 
+static void
+outputBinary(const char *filename)
+{
+    OutputStream *file_stream = simout.find(filename);
+
+    if (!file_stream)
+        file_stream = simout.create(filename, true);
+
+    Trace::setDebugLogger(new Trace::BinaryLogger(*file_stream->stream()));
+}
+
 static void
 ignore(const char *expr)
 {
@@ -109,7 +120,30 @@ pybind_init_debug(py::module &m_native)
     py::module m_trace = m_native.def_submodule("trace");
     m_trace
         .def("output", &output)
+        .def("outputBinary", &outputBinary)
+        .def("prepareFork", []() {
+                Trace::getDebugLogger()->prepareFork();
+            })
+        .def("afterFork", [](bool child) {
+                Trace::getDebugLogger()->afterFork(child);
+            })
         .def("ignore", &ignore)
+        .def("addWindow", [](Tick start, Tick end) {
+                Trace::debugFilter.addWindow(start, end);
+            })
+        .def("clearWindows", []() { Trace::debugFilter.clearWindows(); })
+        .def("addObjectFilter", [](const std::string &pattern) {
+                Trace::debugFilter.addName(pattern);
+            })
+        .def("clearObjectFilters", []() {
+                Trace::debugFilter.clearNames();
+            })
+        .def("addAddrRange", [](Addr start, Addr end) {
+                Trace::debugFilter.addAddrRange(start, end);
+            })
+        .def("clearAddrRanges", []() {
+                Trace::debugFilter.clearAddrRanges();
+            })
         .def("enable", &Trace::enable)
         .def("disable", &Trace::disable)
         ;
@@ -44,6 +44,7 @@
 #include "pybind11/stl.h"
 
 #include "base/logging.hh"
+#include "sim/event_profiler.hh"
 #include "sim/eventq.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
@@ -106,6 +107,9 @@ pybind_init_event(py::module &m_native)
     m.def("simulate", &simulate,
           py::arg("ticks") = MaxTick);
     m.def("exitSimLoop", &exitSimLoop);
+    m.def("enableProfiling", &EventProfiler::enable,
+          py::arg("base") = "hostprof", py::arg("period") = 1);
+    m.def("dumpProfile", &EventProfiler::dump);
     m.def("getEventQueue", []() { return curEventQueue(); },
           py::return_value_policy::reference);
     m.def("setEventQueue", [](EventQueue *q) { return curEventQueue(q); });
@@ -44,6 +44,8 @@
 #include "pybind11/stl.h"
 
 #include "base/statistics.hh"
+#include "base/stats/async.hh"
+#include "base/stats/columnar.hh"
 #include "base/stats/text.hh"
 #if USE_HDF5
 #include "base/stats/hdf5.hh"
@@ -80,6 +82,8 @@ pybind_init_stats(py::module &m_native)
     m
         .def("initSimStats", &Stats::initSimStats)
         .def("initText", &Stats::initText, py::return_value_policy::reference)
+        .def("initColumnar", &Stats::initColumnar)
+        .def("initAsync", &Stats::initAsync, py::keep_alive<0, 1>())
 #if USE_HDF5
         .def("initHDF5", &Stats::initHDF5)
 #endif
@@ -103,6 +107,17 @@ pybind_init_stats(py::module &m_native)
         .def("endGroup", &Stats::Output::endGroup)
         ;
 
+    py::class_<Stats::Columnar, Stats::Output>(m, "Columnar")
+        .def("flush", &Stats::Columnar::flush)
+        ;
+
+    py::class_<Stats::AsyncOutput, Stats::Output>(m, "AsyncOutput")
+        .def("flush", &Stats::AsyncOutput::flush,
+             py::call_guard<py::gil_scoped_release>())
+        .def("stop", &Stats::AsyncOutput::stop,
+             py::call_guard<py::gil_scoped_release>())
+        ;
+
     py::class_<Stats::Info, std::unique_ptr<Stats::Info, py::nodelete>>(
         m, "Info")
         .def_readwrite("name", &Stats::Info::name)
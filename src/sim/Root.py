@@ -30,6 +30,9 @@ from m5.SimObject import SimObject
 from m5.params import *
 from m5.util import fatal
 
+class EventQueueBackend(Enum): vals = ['BinList', 'Calendar']
+class CheckpointFormat(Enum): vals = ['ini', 'binary']
+
 class Root(SimObject):
 
     _the_instance = None
@@ -66,6 +69,25 @@ class Root(SimObject):
     # Needs to be set explicitly for a multi-eventq simulation.
     sim_quantum = Param.Tick(0, "simulation quantum")
 
+    # Data structure keeping the pending events of the main event
+    # queues sorted. The calendar queue is faster when thousands of
+    # events are pending, the service order is the same.
+    eventq_backend = Param.EventQueueBackend('BinList',
+        "data structure used by the main event queues")
+
+    # Format of the SimObject state in checkpoints (m5.cpt). Binary
+    # checkpoints store numbers natively and are much faster to
+    # restore. Both formats can be restored regardless of this setting.
+    checkpoint_format = Param.CheckpointFormat('ini',
+        "format of the checkpoints taken")
+
+    # Write the contents of memories in the background, from a forked
+    # copy-on-write snapshot of the simulator, rather than stopping the
+    # simulation until they are written. The simulator waits for the
+    # writes of a checkpoint before taking the next one, and on exit.
+    checkpoint_in_background = Param.Bool(False,
+        "write the memories of checkpoints in the background")
+
     full_system = Param.Bool("if this is a full system simulation")
 
     # Time syncing prevents the simulation from running faster than real time.
@@ -48,6 +48,8 @@ from m5.objects.SimpleMemory import *
 class MemoryMode(Enum): vals = ['invalid', 'atomic', 'timing',
                                 'atomic_noncaching']
 
+class MemoryCheckpointFormat(Enum): vals = ['gzip', 'raw', 'chunked']
+
 class System(SimObject):
     type = 'System'
     cxx_header = "sim/system.hh"
@@ -72,6 +74,13 @@ class System(SimObject):
     # (but sparse) memory is simulated.
     mmap_using_noreserve = Param.Bool(False, "mmap the backing store " \
                                           "without reserving swap")
+    memory_checkpoint_format = Param.MemoryCheckpointFormat('gzip',
+        "Format of the physical memory in checkpoints. 'raw' checkpoints "
+        "are larger but are mapped rather than read on restore, "
+        "'chunked' checkpoints are compressed using multiple threads")
+    memory_checkpoint_threads = Param.Unsigned(0, "Number of host threads "
+        "writing and reading 'chunked' memory checkpoints (0 for one per "
+        "host core)")
 
     # The memory ranges are to be populated when creating the system
     # such that these can be passed from the I/O subsystem through an
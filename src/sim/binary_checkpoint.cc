@@ -0,0 +1,307 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/binary_checkpoint.hh"
+
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+
+#include "base/str.hh"
+#include "sim/byteswap.hh"
+
+using namespace std;
+
+const char BinaryCheckpoint::magic[8] = {
+    'g', 'e', 'm', '5', 'c', 'p', 't', 'b' };
+
+string
+BinaryCheckpoint::Entry::toString() const
+{
+    if (type == Type::String)
+        return string((const char *)data, count);
+
+    ostringstream os;
+    os << setprecision(17);
+    for (uint64_t i = 0; i < count; ++i) {
+        if (i > 0)
+            os << " ";
+        switch (type) {
+          case Type::Int:
+            os << loadInt(i);
+            break;
+          case Type::UInt:
+            os << loadUInt(i);
+            break;
+          case Type::Float:
+            os << loadFloat(i);
+            break;
+          default:
+            os << (data[i] ? "true" : "false");
+            break;
+        }
+    }
+    return os.str();
+}
+
+bool
+BinaryCheckpoint::isBinary(const string &filename)
+{
+    ifstream file(filename, ios::binary);
+    char file_magic[sizeof(magic)];
+    return file.read(file_magic, sizeof(file_magic)) &&
+        memcmp(file_magic, magic, sizeof(magic)) == 0;
+}
+
+/**
+ * Cursor over the contents of a file, which fails rather than reading
+ * past its end.
+ */
+class BinaryCheckpointCursor
+{
+  private:
+    const uint8_t *pos;
+    const uint8_t *end;
+
+  public:
+    BinaryCheckpointCursor(const vector<uint8_t> &contents)
+        : pos(contents.data()), end(contents.data() + contents.size())
+    {}
+
+    bool done() const { return pos == end; }
+
+    bool
+    skip(uint64_t size, const uint8_t *&data)
+    {
+        if (size > (uint64_t)(end - pos))
+            return false;
+        data = pos;
+        pos += size;
+        return true;
+    }
+
+    template <class T>
+    bool
+    read(T &value)
+    {
+        const uint8_t *data;
+        if (!skip(sizeof(value), data))
+            return false;
+        memcpy(&value, data, sizeof(value));
+        value = letoh(value);
+        return true;
+    }
+
+    bool
+    readName(string &name)
+    {
+        uint32_t size;
+        const uint8_t *data;
+        if (!read(size) || !skip(size, data))
+            return false;
+        name.assign((const char *)data, size);
+        return true;
+    }
+};
+
+/** Check that values of a type can be stored on a number of bytes */
+static bool
+validWidth(BinaryCheckpoint::Type type, uint8_t width)
+{
+    switch (type) {
+      case BinaryCheckpoint::Type::Int:
+      case BinaryCheckpoint::Type::UInt:
+        return width == 1 || width == 2 || width == 4 || width == 8;
+      case BinaryCheckpoint::Type::Float:
+        return width == sizeof(float) || width == sizeof(double);
+      default:
+        return width == 1;
+    }
+}
+
+bool
+BinaryCheckpoint::load(const string &filename)
+{
+    ifstream file(filename, ios::binary | ios::ate);
+    if (!file)
+        return false;
+    contents.resize(file.tellg());
+    file.seekg(0);
+    if (!file.read((char *)contents.data(), contents.size()))
+        return false;
+
+    BinaryCheckpointCursor cursor(contents);
+    const uint8_t *file_magic;
+    if (!cursor.skip(sizeof(magic), file_magic) ||
+        memcmp(file_magic, magic, sizeof(magic)) != 0) {
+        return false;
+    }
+
+    Section *section = nullptr;
+    string name;
+    while (!cursor.done()) {
+        uint8_t record;
+        if (!cursor.read(record))
+            return false;
+
+        if (record == 'S') {
+            if (!cursor.readName(name))
+                return false;
+            section = &sections[name];
+            continue;
+        }
+
+        Entry entry;
+        uint8_t type;
+        if (record != 'E' || !section || !cursor.read(type) ||
+            type > (uint8_t)Type::Bool || !cursor.read(entry.width) ||
+            !cursor.readName(name) || !cursor.read(entry.count)) {
+            return false;
+        }
+        entry.type = (Type)type;
+
+        if (!validWidth(entry.type, entry.width) ||
+            entry.count > UINT64_MAX / entry.width ||
+            !cursor.skip(entry.count * entry.width, entry.data)) {
+            return false;
+        }
+        (*section)[name] = entry;
+    }
+
+    return true;
+}
+
+const BinaryCheckpoint::Entry *
+BinaryCheckpoint::find(const string &section, const string &entry) const
+{
+    auto s = sections.find(section);
+    if (s == sections.end())
+        return nullptr;
+    auto e = s->second.find(entry);
+    return e == s->second.end() ? nullptr : &e->second;
+}
+
+bool
+BinaryCheckpoint::sectionExists(const string &section) const
+{
+    return sections.find(section) != sections.end();
+}
+
+BinaryCheckpointWriter::BinaryCheckpointWriter(ostream &_out)
+    : out(_out)
+{
+    writeRaw(BinaryCheckpoint::magic, sizeof(BinaryCheckpoint::magic));
+}
+
+BinaryCheckpointWriter::~BinaryCheckpointWriter()
+{
+    parseLine();
+}
+
+void
+BinaryCheckpointWriter::writeRaw(const void *data, size_t size)
+{
+    out.write((const char *)data, size);
+}
+
+void
+BinaryCheckpointWriter::writeName(const string &name)
+{
+    const uint32_t size = htole((uint32_t)name.size());
+    writeRaw(&size, sizeof(size));
+    writeRaw(name.data(), name.size());
+}
+
+void
+BinaryCheckpointWriter::writeHeader(const string &name,
+                                    BinaryCheckpoint::Type type,
+                                    uint8_t width, uint64_t count)
+{
+    // flush any text that was not terminated by an end of line
+    parseLine();
+
+    const uint8_t header[3] = { 'E', (uint8_t)type, width };
+    writeRaw(header, sizeof(header));
+    writeName(name);
+    count = htole(count);
+    writeRaw(&count, sizeof(count));
+}
+
+void
+BinaryCheckpointWriter::parseLine()
+{
+    string text;
+    text.swap(line);
+    eat_white(text);
+
+    // blank lines and comments
+    if (text.empty() || text[0] == '#')
+        return;
+
+    if (text[0] == '[') {
+        string::size_type end = text.find(']');
+        const uint8_t record = 'S';
+        writeRaw(&record, sizeof(record));
+        writeName(text.substr(1, end == string::npos ? end : end - 1));
+        return;
+    }
+
+    // name=value lines, anything else is ignored as it would be by
+    // the ini parser
+    string::size_type eq = text.find('=');
+    if (eq == string::npos)
+        return;
+    string name = text.substr(0, eq);
+    string value = text.substr(eq + 1);
+    eat_white(name);
+    eat_white(value);
+
+    writeHeader(name, BinaryCheckpoint::Type::String, 1, value.size());
+    writeRaw(value.data(), value.size());
+}
+
+int
+BinaryCheckpointWriter::overflow(int c)
+{
+    if (c == traits_type::eof())
+        return traits_type::not_eof(c);
+
+    if (c == '\n')
+        parseLine();
+    else
+        line += (char)c;
+    return c;
+}
+
+streamsize
+BinaryCheckpointWriter::xsputn(const char *s, streamsize n)
+{
+    for (streamsize i = 0; i < n; ++i)
+        overflow((unsigned char)s[i]);
+    return n;
+}
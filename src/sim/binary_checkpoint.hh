@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/* @file
+ * Binary checkpoint file format
+ *
+ * A binary checkpoint holds the same sections and entries as an ini
+ * checkpoint, but numbers and arrays of numbers are stored in their
+ * native form rather than as text, and the file is indexed in a
+ * single pass without any parsing of the values.
+ *
+ * The file starts with an 8-byte magic string followed by a sequence
+ * of records, all integers being little endian:
+ *  - a section: 'S', u32 name length, name
+ *  - an entry: 'E', u8 type, u8 width, u32 name length, name,
+ *    u64 count, followed by count values of width bytes each.
+ * Strings and booleans are stored one byte per character or value,
+ * integers on the 1, 2, 4 or 8 bytes of the type they were written
+ * from, and floating point numbers as 4-byte floats or 8-byte doubles.
+ * Sections may appear more than once, in which case their entries
+ * are merged, as in ini files.
+ */
+
+#ifndef __SIM_BINARY_CHECKPOINT_HH__
+#define __SIM_BINARY_CHECKPOINT_HH__
+
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+class BinaryCheckpoint
+{
+  public:
+    /** Magic string at the start of binary checkpoint files */
+    static const char magic[8];
+
+    /** Type of the values of an entry */
+    enum class Type : uint8_t
+    {
+        String = 0,
+        Int = 1,
+        UInt = 2,
+        Float = 3,
+        Bool = 4,
+    };
+
+    /** Entry of a section, pointing into the loaded file */
+    struct Entry
+    {
+        Type type;
+        /** Size of each value in bytes */
+        uint8_t width;
+        /** Number of values, or length of a string */
+        uint64_t count;
+        const uint8_t *data;
+
+        /** Get a value of a numeric entry, converted to a given type */
+        template <class T>
+        T
+        get(uint64_t i) const
+        {
+            switch (type) {
+              case Type::Int:
+                return static_cast<T>(loadInt(i));
+              case Type::UInt:
+                return static_cast<T>(loadUInt(i));
+              case Type::Float:
+                return static_cast<T>(loadFloat(i));
+              default:
+                return static_cast<T>(data[i] != 0);
+            }
+        }
+
+        /**
+         * Get the value of the entry as text, in the form it would
+         * have in an ini checkpoint.
+         */
+        std::string toString() const;
+
+      private:
+        uint64_t
+        loadUInt(uint64_t i) const
+        {
+            const uint8_t *bytes = data + i * width;
+            uint64_t value = 0;
+            for (unsigned b = 0; b < width; ++b)
+                value |= (uint64_t)bytes[b] << (8 * b);
+            return value;
+        }
+
+        int64_t
+        loadInt(uint64_t i) const
+        {
+            // sign extend from the width of the values
+            const unsigned shift = 64 - 8 * width;
+            return (int64_t)(loadUInt(i) << shift) >> shift;
+        }
+
+        double
+        loadFloat(uint64_t i) const
+        {
+            const uint64_t bits = loadUInt(i);
+            if (width == sizeof(float)) {
+                const uint32_t bits32 = bits;
+                float value;
+                std::memcpy(&value, &bits32, sizeof(value));
+                return value;
+            }
+            double value;
+            std::memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+    };
+
+  private:
+    typedef std::unordered_map<std::string, Entry> Section;
+
+    /** Contents of the file, which the entries point into */
+    std::vector<uint8_t> contents;
+
+    std::unordered_map<std::string, Section> sections;
+
+  public:
+    /**
+     * Check if a file is a binary checkpoint.
+     */
+    static bool isBinary(const std::string &filename);
+
+    /**
+     * Load a binary checkpoint file.
+     *
+     * @return False if the file can't be read or is malformed.
+     */
+    bool load(const std::string &filename);
+
+    /**
+     * Find an entry.
+     *
+     * @return The entry, or nullptr if it does not exist.
+     */
+    const Entry *find(const std::string &section,
+                      const std::string &entry) const;
+
+    bool sectionExists(const std::string &section) const;
+};
+
+/**
+ * Stream buffer writing a binary checkpoint.
+ *
+ * Everything written to a stream using this buffer as text is
+ * parsed as lines of an ini checkpoint, and stored as sections and
+ * text entries. Arrays of numbers can bypass the text form by
+ * calling put() on the buffer, which is how the serialization
+ * functions store numbers natively.
+ */
+class BinaryCheckpointWriter : public std::streambuf
+{
+  private:
+    std::ostream &out;
+
+    /** Text written since the last end of line */
+    std::string line;
+
+    void parseLine();
+
+    void writeRaw(const void *data, std::size_t size);
+    void writeName(const std::string &name);
+    void writeHeader(const std::string &name, BinaryCheckpoint::Type type,
+                     uint8_t width, uint64_t count);
+
+    /** Values buffered while writing an entry */
+    std::vector<uint8_t> values;
+
+    template <class T>
+    static void
+    storeValue(uint8_t *bytes, T value)
+    {
+        typedef typename std::conditional<
+            sizeof(T) == 1, uint8_t, typename std::conditional<
+            sizeof(T) == 2, uint16_t, typename std::conditional<
+            sizeof(T) == 4, uint32_t, uint64_t>::type>::type>::type Bits;
+        Bits bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        for (unsigned b = 0; b < sizeof(bits); ++b)
+            bytes[b] = bits >> (8 * b);
+    }
+
+  protected:
+    int overflow(int c) override;
+    std::streamsize xsputn(const char *s, std::streamsize n) override;
+
+  public:
+    BinaryCheckpointWriter(std::ostream &out);
+    ~BinaryCheckpointWriter();
+
+    /**
+     * Write an entry holding an array of numbers, each stored on as
+     * many bytes as its type.
+     *
+     * @param name Name of the entry
+     * @param begin Iterator to the first value
+     * @param count Number of values
+     */
+    template <class T, class Iter>
+    void
+    put(const std::string &name, Iter begin, uint64_t count)
+    {
+        static_assert(std::is_arithmetic<T>::value,
+                      "Only numbers can be stored natively");
+        static_assert(std::is_floating_point<T>::value || sizeof(T) <= 8,
+                      "Integers are stored on at most 8 bytes");
+
+        // Floating point numbers wider than a double are stored as
+        // doubles, and booleans as bytes.
+        typedef typename std::conditional<
+            std::is_same<T, bool>::value, uint8_t,
+            typename std::conditional<
+                std::is_floating_point<T>::value && (sizeof(T) > 8),
+                double, T>::type>::type Stored;
+
+        const BinaryCheckpoint::Type type =
+            std::is_same<T, bool>::value ? BinaryCheckpoint::Type::Bool :
+            std::is_floating_point<T>::value ?
+                BinaryCheckpoint::Type::Float :
+            std::is_signed<T>::value ? BinaryCheckpoint::Type::Int :
+                BinaryCheckpoint::Type::UInt;
+        writeHeader(name, type, sizeof(Stored), count);
+
+        values.resize(count * sizeof(Stored));
+        for (uint64_t i = 0; i < count; ++i, ++begin) {
+            storeValue(&values[i * sizeof(Stored)],
+                       static_cast<Stored>(*begin));
+        }
+        writeRaw(values.data(), values.size());
+    }
+};
+
+#endif // __SIM_BINARY_CHECKPOINT_HH__
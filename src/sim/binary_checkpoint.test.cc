@@ -0,0 +1,207 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+#include <unistd.h>
+
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "sim/binary_checkpoint.hh"
+
+class BinaryCheckpointTest : public testing::Test
+{
+  protected:
+    std::string filename;
+
+    void
+    SetUp() override
+    {
+        char name[] = "/tmp/binary_checkpoint.XXXXXX";
+        int fd = mkstemp(name);
+        ASSERT_GE(fd, 0);
+        close(fd);
+        filename = name;
+    }
+
+    void TearDown() override { unlink(filename.c_str()); }
+
+    /** Write a checkpoint, the way the serialization functions do */
+    void
+    write()
+    {
+        std::ofstream file(filename, std::ios::binary);
+        BinaryCheckpointWriter writer(file);
+        std::ostream os(&writer);
+
+        os << "## checkpoint generated: today\n";
+        os << "\n[system.cpu]\n";
+        os << "name=  some text  \n";
+        std::vector<uint64_t> regs = { 0, 1, 0xffffffffffffffff };
+        writer.put<uint64_t>("regs", regs.begin(), regs.size());
+        int delta = -3;
+        writer.put<int>("delta", &delta, 1);
+        os << "\n[system.mem]\n";
+        double ratio = 0.1;
+        writer.put<double>("ratio", &ratio, 1);
+        std::vector<bool> flags = { true, false, true };
+        writer.put<bool>("flags", flags.begin(), flags.size());
+        // an unterminated line is flushed by the next record
+        os << "last=1";
+    }
+};
+
+TEST_F(BinaryCheckpointTest, IsBinary)
+{
+    EXPECT_FALSE(BinaryCheckpoint::isBinary(filename));
+    write();
+    EXPECT_TRUE(BinaryCheckpoint::isBinary(filename));
+}
+
+TEST_F(BinaryCheckpointTest, RoundTrip)
+{
+    write();
+    BinaryCheckpoint cpt;
+    ASSERT_TRUE(cpt.load(filename));
+
+    EXPECT_TRUE(cpt.sectionExists("system.cpu"));
+    EXPECT_TRUE(cpt.sectionExists("system.mem"));
+    EXPECT_FALSE(cpt.sectionExists("system"));
+    EXPECT_EQ(nullptr, cpt.find("system.cpu", "ratio"));
+
+    const BinaryCheckpoint::Entry *name = cpt.find("system.cpu", "name");
+    ASSERT_NE(nullptr, name);
+    EXPECT_EQ(BinaryCheckpoint::Type::String, name->type);
+    EXPECT_EQ("some text", name->toString());
+
+    const BinaryCheckpoint::Entry *regs = cpt.find("system.cpu", "regs");
+    ASSERT_NE(nullptr, regs);
+    EXPECT_EQ(BinaryCheckpoint::Type::UInt, regs->type);
+    EXPECT_EQ(8, regs->width);
+    ASSERT_EQ(3, regs->count);
+    EXPECT_EQ(0, regs->get<uint64_t>(0));
+    EXPECT_EQ(1, regs->get<uint64_t>(1));
+    EXPECT_EQ(0xffffffffffffffff, regs->get<uint64_t>(2));
+    EXPECT_EQ("0 1 18446744073709551615", regs->toString());
+
+    const BinaryCheckpoint::Entry *delta = cpt.find("system.cpu", "delta");
+    ASSERT_NE(nullptr, delta);
+    EXPECT_EQ(BinaryCheckpoint::Type::Int, delta->type);
+    EXPECT_EQ(sizeof(int), delta->width);
+    EXPECT_EQ(-3, delta->get<int>(0));
+    EXPECT_EQ(-3.0, delta->get<double>(0));
+
+    const BinaryCheckpoint::Entry *ratio = cpt.find("system.mem", "ratio");
+    ASSERT_NE(nullptr, ratio);
+    EXPECT_EQ(0.1, ratio->get<double>(0));
+
+    const BinaryCheckpoint::Entry *flags = cpt.find("system.mem", "flags");
+    ASSERT_NE(nullptr, flags);
+    EXPECT_EQ(BinaryCheckpoint::Type::Bool, flags->type);
+    EXPECT_EQ("true false true", flags->toString());
+    EXPECT_FALSE(flags->get<bool>(1));
+
+    const BinaryCheckpoint::Entry *last = cpt.find("system.mem", "last");
+    ASSERT_NE(nullptr, last);
+    EXPECT_EQ("1", last->toString());
+}
+
+TEST_F(BinaryCheckpointTest, Widths)
+{
+    // Numbers are stored on as many bytes as their type
+    const uint8_t bytes[] = { 0, 0x80, 0xff };
+    const int8_t small[] = { -128, -1, 127 };
+    const float single = -0.25f;
+    {
+        std::ofstream file(filename, std::ios::binary);
+        BinaryCheckpointWriter writer(file);
+        std::ostream os(&writer);
+        os << "[system]\n";
+        writer.put<uint8_t>("bytes", bytes, 3);
+        writer.put<int8_t>("small", small, 3);
+        writer.put<float>("single", &single, 1);
+    }
+
+    BinaryCheckpoint cpt;
+    ASSERT_TRUE(cpt.load(filename));
+
+    const BinaryCheckpoint::Entry *entry = cpt.find("system", "bytes");
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(1, entry->width);
+    EXPECT_EQ(0x80, entry->get<unsigned>(1));
+    EXPECT_EQ("0 128 255", entry->toString());
+
+    entry = cpt.find("system", "small");
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(1, entry->width);
+    EXPECT_EQ(-128, entry->get<int>(0));
+    EXPECT_EQ(-1, entry->get<int64_t>(1));
+    EXPECT_EQ("-128 -1 127", entry->toString());
+
+    entry = cpt.find("system", "single");
+    ASSERT_NE(nullptr, entry);
+    EXPECT_EQ(sizeof(float), entry->width);
+    EXPECT_EQ(-0.25, entry->get<double>(0));
+
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    EXPECT_EQ(sizeof(BinaryCheckpoint::magic) + 11 +
+              (15 + 5 + 3) + (15 + 5 + 3) + (15 + 6 + 4),
+              file.tellg());
+}
+
+TEST_F(BinaryCheckpointTest, BadWidth)
+{
+    double ratio = 1.0;
+    {
+        std::ofstream file(filename, std::ios::binary);
+        BinaryCheckpointWriter writer(file);
+        std::ostream os(&writer);
+        os << "[system]\n";
+        writer.put<double>("ratio", &ratio, 1);
+    }
+
+    // Make the width of the entry 3 bytes, which no type has
+    std::fstream file(filename, std::ios::binary | std::ios::in |
+                      std::ios::out);
+    file.seekp(sizeof(BinaryCheckpoint::magic) + 11 + 2);
+    file.put(3);
+    file.close();
+
+    BinaryCheckpoint cpt;
+    EXPECT_FALSE(cpt.load(filename));
+}
+
+TEST_F(BinaryCheckpointTest, Truncated)
+{
+    write();
+    truncate(filename.c_str(), 40);
+    BinaryCheckpoint cpt;
+    EXPECT_FALSE(cpt.load(filename));
+}
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "sim/event_profiler.hh"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+#include "base/callback.hh"
+#include "base/cprintf.hh"
+#include "base/output.hh"
+#include "base/statistics.hh"
+#include "sim/core.hh"
+#include "sim/eventq.hh"
+#include "sim/sim_object.hh"
+
+namespace {
+
+/** Cost of the events of a name */
+struct ProfileEntry
+{
+    uint64_t count = 0;
+    uint64_t cycles = 0;
+};
+
+/** Profile of the events processed by a thread */
+struct ThreadProfile
+{
+    /** Cost of the events, indexed by the id of their name */
+    std::vector<ProfileEntry> entries;
+
+    /** Ids of the names this thread has seen */
+    std::unordered_map<std::string, uint32_t> ids;
+
+    /** Number of events processed since the last timed one */
+    unsigned skipped = 0;
+};
+
+std::mutex profilesMutex;
+std::vector<std::unique_ptr<ThreadProfile>> profiles;
+
+/**
+ * Names of the events, indexed by their id. The ids are shared by all
+ * threads so that an event keeps its id when it moves between queues.
+ * Id 0 means that an event hasn't been named yet.
+ */
+std::vector<std::string> names(1);
+std::unordered_map<std::string, uint32_t> nameIds;
+
+std::string outputBase;
+unsigned samplingPeriod = 1;
+
+uint64_t startCycles;
+std::chrono::steady_clock::time_point startTime;
+
+/** Host cycle counter, or nanoseconds where there is none */
+inline uint64_t
+hostCycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+ThreadProfile &
+threadProfile()
+{
+    static thread_local ThreadProfile *profile = nullptr;
+    if (!profile) {
+        std::lock_guard<std::mutex> lock(profilesMutex);
+        profiles.emplace_back(new ThreadProfile);
+        profile = profiles.back().get();
+    }
+    return *profile;
+}
+
+/** Name an event is profiled under */
+std::string
+profileName(const Event *event)
+{
+    std::string name = event->name();
+
+    // Events without a name of their own are named after their
+    // instance, group them by type instead.
+    if (name.compare(0, 6, "Event_") == 0)
+        return csprintf("(%s)", event->description());
+
+    for (const char *suffix : { ".wrapped_function_event",
+                                ".wrapped_event" }) {
+        const std::size_t len = strlen(suffix);
+        if (name.size() > len &&
+            name.compare(name.size() - len, len, suffix) == 0) {
+            name.resize(name.size() - len);
+            break;
+        }
+    }
+    return name;
+}
+
+/** Id of the name of an event */
+uint32_t
+profileId(ThreadProfile &profile, const Event *event)
+{
+    std::string name = profileName(event);
+    auto it = profile.ids.find(name);
+    if (it != profile.ids.end())
+        return it->second;
+
+    std::lock_guard<std::mutex> lock(profilesMutex);
+    auto ins = nameIds.emplace(name, names.size());
+    if (ins.second)
+        names.push_back(name);
+    profile.ids.emplace(std::move(name), ins.first->second);
+    return ins.first->second;
+}
+
+/** Find the SimObject an event belongs to, from the name of the event */
+std::string
+ownerName(const std::string &name)
+{
+    for (std::size_t dot = name.rfind('.'); dot != std::string::npos;
+         dot = dot ? name.rfind('.', dot - 1) : std::string::npos) {
+        const std::string prefix = name.substr(0, dot);
+        if (SimObject::find(prefix.c_str()))
+            return prefix;
+    }
+    return SimObject::find(name.c_str()) ? name : std::string();
+}
+
+class EventProfilerCallback : public Callback
+{
+  public:
+    void process() override { EventProfiler::dump(); }
+};
+
+} // anonymous namespace
+
+bool EventProfiler::enabled = false;
+
+void
+EventProfiler::enable(const std::string &base, unsigned period)
+{
+    if (!enabled) {
+        Stats::registerDumpCallback(new EventProfilerCallback);
+        registerExitCallback(new EventProfilerCallback);
+        startCycles = hostCycles();
+        startTime = std::chrono::steady_clock::now();
+    }
+
+    outputBase = base;
+    samplingPeriod = std::max(period, 1U);
+    enabled = true;
+}
+
+void
+EventProfiler::process(Event *event)
+{
+    ThreadProfile &profile = threadProfile();
+    if (++profile.skipped < samplingPeriod) {
+        event->process();
+        return;
+    }
+    profile.skipped = 0;
+
+    // Find the entry before processing the event, which may delete
+    // it. The id is kept in the event so that it is only named once,
+    // and goes away with it.
+    uint32_t id = event->profileId;
+    if (!id)
+        id = event->profileId = profileId(profile, event);
+
+    const uint64_t start = hostCycles();
+    event->process();
+    const uint64_t cycles = hostCycles() - start;
+
+    if (id >= profile.entries.size())
+        profile.entries.resize(id + 1);
+    ProfileEntry &entry = profile.entries[id];
+    entry.cycles += cycles * samplingPeriod;
+    entry.count += samplingPeriod;
+}
+
+void
+EventProfiler::dump()
+{
+    if (!enabled)
+        return;
+
+    // the profiles are only updated while simulating
+    std::map<std::string, ProfileEntry> events;
+    for (auto &profile : profiles) {
+        for (uint32_t id = 1; id < profile->entries.size(); ++id) {
+            const ProfileEntry &e = profile->entries[id];
+            if (!e.count)
+                continue;
+            ProfileEntry &total = events[names[id]];
+            total.count += e.count;
+            total.cycles += e.cycles;
+        }
+    }
+
+    std::map<std::string, ProfileEntry> objects;
+    std::map<std::string, std::string> owners;
+    ProfileEntry total;
+    for (auto &e : events) {
+        const std::string owner = ownerName(e.first);
+        owners[e.first] = owner;
+        ProfileEntry &object = objects[owner.empty() ? "(none)" : owner];
+        object.count += e.second.count;
+        object.cycles += e.second.cycles;
+        total.count += e.second.count;
+        total.cycles += e.second.cycles;
+    }
+
+    const double elapsed = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - startTime).count();
+    const double cycles_per_second =
+        elapsed > 0 ? (hostCycles() - startCycles) / elapsed : 0;
+
+    OutputStream *text = simout.create(outputBase + ".txt");
+    std::ostream &os = *text->stream();
+    ccprintf(os, "Host profile at tick %d: %d events, %.3f s in events "
+             "out of %.3f s", curTick(), total.count,
+             cycles_per_second ? total.cycles / cycles_per_second : 0.0,
+             elapsed);
+    if (samplingPeriod > 1)
+        ccprintf(os, ", timing 1 event in %d", samplingPeriod);
+    ccprintf(os, "\n");
+
+    auto print_table = [&](const char *title,
+                           const std::map<std::string, ProfileEntry> &m) {
+        std::vector<std::pair<std::string, ProfileEntry>> sorted(
+            m.begin(), m.end());
+        std::sort(sorted.begin(), sorted.end(),
+                  [](const std::pair<std::string, ProfileEntry> &a,
+                     const std::pair<std::string, ProfileEntry> &b) {
+                      return a.second.cycles > b.second.cycles;
+                  });
+
+        ccprintf(os, "\n%s\n%14s %7s %12s %12s  %s\n", title,
+                 "cycles", "%", "events", "cycles/event", "name");
+        for (auto &e : sorted) {
+            ccprintf(os, "%14d %6.2f%% %12d %12.1f  %s\n",
+                     e.second.cycles,
+                     total.cycles ? 100.0 * e.second.cycles / total.cycles
+                                  : 0.0,
+                     e.second.count,
+                     e.second.count ?
+                         (double)e.second.cycles / e.second.count : 0.0,
+                     e.first);
+        }
+    };
+    print_table("Per SimObject:", objects);
+    print_table("Per event:", events);
+    simout.close(text);
+
+    // Folded stacks, one frame per level of the SimObject hierarchy
+    // followed by the event, weighted by cycles.
+    OutputStream *folded = simout.create(outputBase + ".folded");
+    std::ostream &fs = *folded->stream();
+    for (auto &e : events) {
+        const std::string &owner = owners[e.first];
+        std::string stack = owner.empty() ? "(none)" : owner;
+        std::replace(stack.begin(), stack.end(), '.', ';');
+        std::string event = owner.empty() ?
+            e.first : e.first.substr(std::min(owner.size() + 1,
+                                              e.first.size()));
+        // frames are separated by ';' and the weight by a space
+        std::replace(event.begin(), event.end(), ';', '_');
+        std::replace(event.begin(), event.end(), ' ', '_');
+        fs << stack << ';' << (event.empty() ? "(self)" : event) << ' '
+           << e.second.cycles << '\n';
+    }
+    simout.close(folded);
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef __SIM_EVENT_PROFILER_HH__
+#define __SIM_EVENT_PROFILER_HH__
+
+#include <string>
+
+class Event;
+
+/**
+ * Accounting of the host time spent processing events.
+ *
+ * When enabled, the event queues have the profiler process their
+ * events, and the host cycles spent in each event are charged to the
+ * name of the event. The profile is written out at each stats dump
+ * and at exit, aggregated per event and per SimObject owning the
+ * events, as text and as folded stacks for flame graph tools.
+ */
+class EventProfiler
+{
+  public:
+    /** Whether events are being profiled, checked for every event */
+    static bool enabled;
+
+    /**
+     * Start profiling events.
+     *
+     * @param base Base name of the output files, base.txt and
+     * base.folded in the output directory.
+     * @param period Only time one event out of period, to lower the
+     * overhead of profiling, and scale up its cost.
+     */
+    static void enable(const std::string &base, unsigned period = 1);
+
+    /** Process an event, charging its cost to its name */
+    static void process(Event *event);
+
+    /** Write out the profile */
+    static void dump();
+};
+
+#endif // __SIM_EVENT_PROFILER_HH__
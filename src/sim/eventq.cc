@@ -28,6 +28,7 @@
  * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <string>
@@ -39,6 +40,7 @@
 #include "cpu/smt.hh"
 #include "debug/Checkpoint.hh"
 #include "sim/core.hh"
+#include "sim/event_profiler.hh"
 #include "sim/eventq_impl.hh"
 
 using namespace std;
@@ -55,6 +57,7 @@ uint32_t numMainEventQueues = 0;
 vector<EventQueue *> mainEventQueue;
 __thread EventQueue *_curEventQueue = NULL;
 bool inParallelMode = false;
+EventQueue::Backend mainEventQueueBackend = EventQueue::BinList;
 
 EventQueue *
 getEventQueue(uint32_t index)
@@ -62,7 +65,8 @@ getEventQueue(uint32_t index)
     while (numMainEventQueues <= index) {
         numMainEventQueues++;
         mainEventQueue.push_back(
-            new EventQueue(csprintf("MainEventQueue-%d", index)));
+            new EventQueue(csprintf("MainEventQueue-%d", index),
+                           mainEventQueueBackend));
     }
 
     return mainEventQueue[index];
@@ -106,19 +110,17 @@ Event::insertBefore(Event *event, Event *curr)
     return event;
 }
 
-void
-EventQueue::insert(Event *event)
+Event *
+Event::insertSorted(Event *event, Event *list)
 {
     // Deal with the head case
-    if (!head || *event <= *head) {
-        head = Event::insertBefore(event, head);
-        return;
-    }
+    if (!list || *event <= *list)
+        return insertBefore(event, list);
 
     // Figure out either which 'in bin' list we are on, or where a new list
     // needs to be inserted
-    Event *prev = head;
-    Event *curr = head->nextBin;
+    Event *prev = list;
+    Event *curr = list->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
@@ -126,7 +128,19 @@ EventQueue::insert(Event *event)
 
     // Note: this operation may render all nextBin pointers on the
     // prev 'in bin' list stale (except for the top one)
-    prev->nextBin = Event::insertBefore(event, curr);
+    prev->nextBin = insertBefore(event, curr);
+    return list;
+}
+
+void
+EventQueue::insert(Event *event)
+{
+    if (calendar) {
+        calendar->insert(event);
+        head = calendar->head();
+    } else {
+        head = Event::insertSorted(event, head);
+    }
 }
 
 Event *
@@ -160,24 +174,20 @@ Event::removeItem(Event *event, Event *top)
     return top;
 }
 
-void
-EventQueue::remove(Event *event)
+Event *
+Event::removeSorted(Event *event, Event *list)
 {
-    if (head == NULL)
+    if (list == NULL)
         panic("event not found!");
 
-    assert(event->queue == this);
-
-    // deal with an event on the head's 'in bin' list (event has the same
-    // time as the head)
-    if (*head == *event) {
-        head = Event::removeItem(event, head);
-        return;
-    }
+    // deal with an event on the first 'in bin' list (event has the same
+    // time as the first bin)
+    if (*list == *event)
+        return removeItem(event, list);
 
     // Find the 'in bin' list that this event belongs on
-    Event *prev = head;
-    Event *curr = head->nextBin;
+    Event *prev = list;
+    Event *curr = list->nextBin;
     while (curr && *curr < *event) {
         prev = curr;
         curr = curr->nextBin;
@@ -189,7 +199,21 @@ EventQueue::remove(Event *event)
     // curr points to the top item of the the correct 'in bin' list, when
     // we remove an item, it returns the new top item (which may be
     // unchanged)
-    prev->nextBin = Event::removeItem(event, curr);
+    prev->nextBin = removeItem(event, curr);
+    return list;
+}
+
+void
+EventQueue::remove(Event *event)
+{
+    assert(event->queue == this);
+
+    if (calendar) {
+        calendar->remove(event);
+        head = calendar->head();
+    } else {
+        head = Event::removeSorted(event, head);
+    }
 }
 
 Event *
@@ -197,10 +221,12 @@ EventQueue::serviceOne()
 {
     std::lock_guard<EventQueue> lock(*this);
     Event *event = head;
-    Event *next = head->nextInBin;
     event->flags.clear(Event::Scheduled);
 
-    if (next) {
+    if (calendar) {
+        calendar->remove(event);
+        head = calendar->head();
+    } else if (Event *next = head->nextInBin) {
         // update the next bin pointer since it could be stale
         next->nextBin = head->nextBin;
 
@@ -218,7 +244,10 @@ EventQueue::serviceOne()
         setCurTick(event->when());
         if (DTRACE(Event))
             event->trace("executed");
-        event->process();
+        if (EventProfiler::enabled)
+            EventProfiler::process(event);
+        else
+            event->process();
         if (event->isExitEvent()) {
             assert(!event->flags.isSet(Event::Managed) ||
                    !event->flags.isSet(Event::IsMainQueue)); // would be silly
@@ -293,15 +322,12 @@ EventQueue::dump() const
     if (empty())
         cprintf("<No Events>\n");
     else {
-        Event *nextBin = head;
-        while (nextBin) {
+        for (Event *nextBin : sortedBins()) {
             Event *nextInBin = nextBin;
             while (nextInBin) {
                 nextInBin->dump();
                 nextInBin = nextInBin->nextInBin;
             }
-
-            nextBin = nextBin->nextBin;
         }
     }
 
@@ -313,11 +339,13 @@ EventQueue::debugVerify() const
 {
     std::unordered_map<long, bool> map;
 
+    if (calendar && !calendar->debugVerify())
+        return false;
+
     Tick time = 0;
-    short priority = 0;
+    short priority = Event::Minimum_Pri;
 
-    Event *nextBin = head;
-    while (nextBin) {
+    for (Event *nextBin : sortedBins()) {
         Event *nextInBin = nextBin;
         while (nextInBin) {
             if (nextInBin->when() < time) {
@@ -343,21 +371,55 @@ EventQueue::debugVerify() const
 
             nextInBin = nextInBin->nextInBin;
         }
-
-        nextBin = nextBin->nextBin;
     }
 
     return true;
 }
 
+std::vector<Event *>
+EventQueue::sortedBins() const
+{
+    if (calendar)
+        return calendar->sortedBins();
+
+    std::vector<Event *> bins;
+    for (Event *bin = head; bin; bin = bin->nextBin)
+        bins.push_back(bin);
+    return bins;
+}
+
 Event*
 EventQueue::replaceHead(Event* s)
 {
-    Event* t = head;
-    head = s;
+    if (!calendar) {
+        Event* t = head;
+        head = s;
+        return t;
+    }
+
+    // The calendar hands out its events as a plain bin list so that
+    // the caller can later put them back, possibly into a queue using
+    // the bin list.
+    Event* t = calendar->takeAll();
+    calendar->insertAll(s);
+    head = calendar->head();
     return t;
 }
 
+void
+EventQueue::backend(Backend b)
+{
+    if (b == backend())
+        return;
+
+    Event *events = replaceHead(NULL);
+    if (b == Calendar)
+        calendar.reset(new CalendarQueue());
+    else
+        calendar.reset();
+    replaceHead(events);
+}
+
 void
 dumpMainQueue()
 {
@@ -417,8 +479,9 @@ Event::dump() const
     }
 }
 
-EventQueue::EventQueue(const string &n)
-    : objName(n), head(NULL), _curTick(0)
+EventQueue::EventQueue(const string &n, Backend backend)
+    : objName(n), head(NULL), _curTick(0),
+      calendar(backend == Calendar ? new CalendarQueue() : nullptr)
 {
 }
 
@@ -443,3 +506,226 @@ EventQueue::handleAsyncInsertions()
 
     async_queue_mutex.unlock();
 }
+
+CalendarQueue::CalendarQueue()
+    : buckets(minBuckets, NULL), mask(minBuckets - 1), width(1000),
+      numEvents(0), _head(NULL)
+{
+}
+
+Event *
+CalendarQueue::search(Tick from) const
+{
+    if (empty())
+        return NULL;
+
+    // Walk the buckets for one calendar year starting at the bucket
+    // of 'from'. The first bin of a bucket is the earliest event
+    // overall if it falls within the part of the year covered by the
+    // bucket, since no event is earlier than 'from'.
+    size_t bucket = bucketOf(from);
+    Tick top = from - from % width;
+    for (size_t n = 0; n < buckets.size(); ++n) {
+        top = top + width < top ? MaxTick : top + width;
+        Event *first = buckets[bucket];
+        if (first && first->when() < top)
+            return first;
+        bucket = (bucket + 1) & mask;
+    }
+
+    // Events are sparse compared to the bucket width, fall back to a
+    // direct search of the earliest bin.
+    Event *earliest = NULL;
+    for (auto first : buckets) {
+        if (first && (!earliest || *first < *earliest))
+            earliest = first;
+    }
+    return earliest;
+}
+
+void
+CalendarQueue::insertBin(Event *bin)
+{
+    Event **curr = &buckets[bucketOf(bin->when())];
+    while (*curr && **curr < *bin)
+        curr = &(*curr)->nextBin;
+
+    bin->nextBin = *curr;
+    *curr = bin;
+}
+
+void
+CalendarQueue::resize(size_t nbuckets)
+{
+    std::vector<Event *> bins;
+    bins.reserve(numEvents);
+    for (auto first : buckets) {
+        for (Event *bin = first; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+
+    // Estimate the bucket width from the average separation of the
+    // earliest bins, ignoring separations larger than twice the
+    // average (R. Brown, CACM 1988).
+    const size_t samples = std::min<size_t>(bins.size(), 25);
+    if (samples > 1) {
+        std::partial_sort(bins.begin(), bins.begin() + samples, bins.end(),
+                          [](Event *l, Event *r) { return *l < *r; });
+
+        const Tick avg = (bins[samples - 1]->when() - bins[0]->when()) /
+            (samples - 1);
+        Tick sum = 0;
+        size_t count = 0;
+        for (size_t i = 1; i < samples; ++i) {
+            const Tick sep = bins[i]->when() - bins[i - 1]->when();
+            if (sep <= 2 * avg) {
+                sum += sep;
+                ++count;
+            }
+        }
+
+        if (sum > 0)
+            width = std::max<Tick>(3 * (sum / count), 1);
+    }
+
+    buckets.assign(nbuckets, NULL);
+    mask = nbuckets - 1;
+    for (auto bin : bins)
+        insertBin(bin);
+}
+
+void
+CalendarQueue::insert(Event *event)
+{
+    Event *&first = buckets[bucketOf(event->when())];
+    first = Event::insertSorted(event, first);
+
+    // An event with the same time and priority as the head goes on
+    // top of the head's bin and is serviced first.
+    if (!_head || *event <= *_head)
+        _head = event;
+
+    if (++numEvents > 2 * buckets.size())
+        resize(2 * buckets.size());
+}
+
+void
+CalendarQueue::remove(Event *event)
+{
+    if (empty())
+        panic("event not found!");
+
+    Event *&first = buckets[bucketOf(event->when())];
+    first = Event::removeSorted(event, first);
+    --numEvents;
+
+    if (event == _head) {
+        // The next event in the head's bin, if any, is now on top of
+        // the bin and first in its bucket.
+        if (first && *first == *event)
+            _head = first;
+        else
+            _head = search(event->when());
+    }
+
+    if (buckets.size() > minBuckets && numEvents < buckets.size() / 2)
+        resize(buckets.size() / 2);
+}
+
+Event *
+CalendarQueue::takeAll()
+{
+    Event *bins = NULL;
+    Event **tail = &bins;
+    while (_head) {
+        Event *bin = _head;
+        Event *&first = buckets[bucketOf(bin->when())];
+        assert(first == bin);
+        first = bin->nextBin;
+
+        for (Event *event = bin; event; event = event->nextInBin)
+            --numEvents;
+
+        *tail = bin;
+        tail = &bin->nextBin;
+        _head = search(bin->when());
+    }
+    *tail = NULL;
+
+    assert(empty());
+    return bins;
+}
+
+void
+CalendarQueue::insertAll(Event *bins)
+{
+    assert(empty());
+
+    size_t nbuckets = minBuckets;
+    while (bins) {
+        Event *bin = bins;
+        bins = bins->nextBin;
+
+        insertBin(bin);
+        for (Event *event = bin; event; event = event->nextInBin)
+            ++numEvents;
+        if (!_head)
+            _head = bin;
+    }
+
+    while (numEvents > 2 * nbuckets)
+        nbuckets *= 2;
+    if (nbuckets != buckets.size())
+        resize(nbuckets);
+}
+
+std::vector<Event *>
+CalendarQueue::sortedBins() const
+{
+    std::vector<Event *> bins;
+    for (auto first : buckets) {
+        for (Event *bin = first; bin; bin = bin->nextBin)
+            bins.push_back(bin);
+    }
+
+    std::sort(bins.begin(), bins.end(),
+              [](Event *l, Event *r) { return *l < *r; });
+    return bins;
+}
+
+bool
+CalendarQueue::debugVerify() const
+{
+    size_t count = 0;
+    for (size_t bucket = 0; bucket < buckets.size(); ++bucket) {
+        for (Event *bin = buckets[bucket]; bin; bin = bin->nextBin) {
+            if (bucketOf(bin->when()) != bucket) {
+                cprintf("bin in the wrong bucket!");
+                bin->dump();
+                return false;
+            }
+
+            if (bin->nextBin && !(*bin < *bin->nextBin)) {
+                cprintf("bucket not sorted!");
+                bin->dump();
+                return false;
+            }
+
+            if (*bin < *_head) {
+                cprintf("head is not the earliest event!");
+                bin->dump();
+                return false;
+            }
+
+            for (Event *event = bin; event; event = event->nextInBin)
+                ++count;
+        }
+    }
+
+    if (count != numEvents) {
+        cprintf("event count mismatch!");
+        return false;
+    }
+
+    return true;
+}
@@ -43,6 +43,7 @@
 #include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 
 #include "base/flags.hh"
 #include "base/types.hh"
@@ -50,6 +51,7 @@
 #include "sim/serialize.hh"
 
 class EventQueue;       // forward declaration
+class CalendarQueue;
 class BaseGlobalEvent;
 
 //! Simulation Quantum for multiple eventq simulation.
@@ -245,6 +247,8 @@ class EventBase
 class Event : public EventBase, public Serializable
 {
     friend class EventQueue;
+    friend class CalendarQueue;
+    friend class EventProfiler;
 
   private:
     // The event queue is now a linked list of linked lists.  The
@@ -262,9 +266,15 @@ class Event : public EventBase, public Serializable
     static Event *insertBefore(Event *event, Event *curr);
     static Event *removeItem(Event *event, Event *last);
 
+    //! Insert / remove an event in a sorted list of bins, returning
+    //! the (possibly new) first bin of the list.
+    static Event *insertSorted(Event *event, Event *list);
+    static Event *removeSorted(Event *event, Event *list);
+
     Tick _when;         //!< timestamp when event should be processed
     Priority _priority; //!< event priority
     Flags flags;
+    uint32_t profileId; //!< name of the event in host profiles, if known
 
 #ifndef NDEBUG
     /// Global counter to generate unique IDs for Event instances
@@ -407,7 +417,7 @@ class Event : public EventBase, public Serializable
      */
     Event(Priority p = Default_Pri, Flags f = 0)
         : nextBin(nullptr), nextInBin(nullptr), _when(0), _priority(p),
-          flags(Initialized | f)
+          flags(Initialized | f), profileId(0)
     {
         assert(f.noneSet(~PublicWrite));
 #ifndef NDEBUG
@@ -572,6 +582,71 @@ operator!=(const Event &l, const Event &r)
     return l.when() != r.when() || l.priority() != r.priority();
 }
 
+/**
+ * Calendar queue (R. Brown, CACM 1988) holding the bins of an
+ * EventQueue.
+ *
+ * Bins are hashed on their timestamp into an array of buckets, each
+ * covering a fixed tick width, and every bucket keeps a short sorted
+ * list of bins linked through Event::nextBin. Events with the same
+ * time and priority still share a bin stacked through
+ * Event::nextInBin, so the service order is exactly the one of the
+ * plain bin list. The number of buckets and the bucket width are
+ * adapted as the queue grows and shrinks, which makes insertion and
+ * removal O(1) amortized instead of linear in the number of bins.
+ */
+class CalendarQueue
+{
+  private:
+    /** Sorted bin lists, one per bucket */
+    std::vector<Event *> buckets;
+    /** Number of buckets minus one, the bucket count is a power of 2 */
+    size_t mask;
+    /** Range of ticks covered by each bucket */
+    Tick width;
+    /** Number of events (not bins) in the queue */
+    size_t numEvents;
+    /** Earliest event in the queue, cached for O(1) access */
+    Event *_head;
+
+    /** Smallest number of buckets the queue shrinks to */
+    static const size_t minBuckets = 16;
+
+    size_t bucketOf(Tick when) const { return (when / width) & mask; }
+
+    /** Find the earliest event, knowing none is earlier than from */
+    Event *search(Tick from) const;
+
+    /** Link a complete bin into its bucket */
+    void insertBin(Event *bin);
+
+    /** Rehash all bins into nbuckets buckets with a new width */
+    void resize(size_t nbuckets);
+
+  public:
+    CalendarQueue();
+
+    Event *head() const { return _head; }
+    bool empty() const { return numEvents == 0; }
+
+    void insert(Event *event);
+    void remove(Event *event);
+
+    /**
+     * Remove all events from the calendar and return them as a
+     * sorted list of bins, in the format used by the bin list.
+     */
+    Event *takeAll();
+
+    /** Insert all events from a sorted list of bins */
+    void insertAll(Event *bins);
+
+    /** Get the first event of every bin in service order */
+    std::vector<Event *> sortedBins() const;
+
+    bool debugVerify() const;
+};
+
 /**
  * Queue of events sorted in time order
  *
@@ -609,14 +684,35 @@ operator!=(const Event &l, const Event &r)
  * events must happen at least one simulation quantum into the future,
  * otherwise they risk being scheduled in the past by
  * handleAsyncInsertions().
+ *
+ * Pending events are kept either in a sorted linked list of bins
+ * (the default) or in a calendar queue of the same bins, see
+ * EventQueue::Backend. Both produce the same service order, the
+ * calendar queue is faster when many events are pending.
  */
 class EventQueue
 {
+  public:
+    /**
+     * Data structure used to keep the pending events sorted.
+     *
+     * @ingroup api_eventq
+     */
+    enum Backend {
+        BinList,    //!< Sorted linked list of bins, linear insertion
+        Calendar,   //!< Calendar queue of bins, O(1) amortized
+    };
+
   private:
     std::string objName;
+    //! Earliest pending event. When using the bin list, this is also
+    //! the head of the list.
     Event *head;
     Tick _curTick;
 
+    //! Calendar holding the events, NULL when using the bin list
+    std::unique_ptr<CalendarQueue> calendar;
+
     //! Mutex to protect async queue.
     std::mutex async_queue_mutex;
 
@@ -655,6 +751,9 @@ class EventQueue
     //! owning thread, should call this function instead of insert().
     void asyncInsert(Event *event);
 
+    //! Get the first event of every bin in service order.
+    std::vector<Event *> sortedBins() const;
+
     EventQueue(const EventQueue &);
 
   public:
@@ -735,7 +834,18 @@ class EventQueue
     /**
      * @ingroup api_eventq
      */
-    EventQueue(const std::string &n);
+    EventQueue(const std::string &n, Backend backend = BinList);
+
+    /**
+     * Get/set the data structure keeping the pending events. Changing
+     * it moves all pending events to the new data structure.
+     *
+     * @ingroup api_eventq
+     * @{
+     */
+    Backend backend() const { return calendar ? Calendar : BinList; }
+    void backend(Backend b);
+    /** @}*/ //end of api_eventq group
 
     /**
      * @ingroup api_eventq
@@ -900,6 +1010,9 @@ class EventQueue
     }
 };
 
+//! Data structure used by main event queues allocated from now on.
+extern EventQueue::Backend mainEventQueueBackend;
+
 void dumpMainQueue();
 
 class EventManager
@@ -0,0 +1,148 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Event queue microbenchmark, comparing the bin list and the calendar
+ * queue backends with the classic "hold" model: a fixed number of
+ * events is kept pending, and every serviced event schedules itself
+ * again a random delay later. A fraction of the events also
+ * reschedules another pending event, which exercises removal from
+ * the middle of the queue. Both backends must service the events in
+ * exactly the same order, which is checked with a running hash.
+ */
+
+#include <chrono>
+#include <memory>
+#include <random>
+#include <vector>
+
+#include "base/cprintf.hh"
+#include "sim/eventq_impl.hh"
+
+using namespace std;
+
+class HoldEvent : public Event
+{
+  private:
+    EventQueue &eq;
+    mt19937_64 &rng;
+    vector<unique_ptr<HoldEvent>> &events;
+    uint64_t &hash;
+    const uint64_t id;
+
+    Tick
+    delay()
+    {
+        // Mostly short delays on a few clock periods, with some
+        // simultaneous and some long-latency events.
+        switch (rng() % 8) {
+          case 0:
+            return 0;
+          case 1:
+            return (rng() % 100) * 10000;
+          default:
+            return (rng() % 16) * 500;
+        }
+    }
+
+  public:
+    HoldEvent(EventQueue &_eq, mt19937_64 &_rng,
+              vector<unique_ptr<HoldEvent>> &_events, uint64_t &_hash,
+              uint64_t _id, Priority p)
+        : Event(p), eq(_eq), rng(_rng), events(_events), hash(_hash), id(_id)
+    {}
+
+    void
+    process() override
+    {
+        hash = hash * 1000003 + id;
+
+        eq.schedule(this, eq.getCurTick() + delay());
+
+        if (rng() % 4 == 0) {
+            HoldEvent *other = events[rng() % events.size()].get();
+            eq.reschedule(other, eq.getCurTick() + delay(), true);
+        }
+    }
+
+    const char *description() const override { return "hold"; }
+};
+
+uint64_t
+run(EventQueue::Backend backend, size_t pending, uint64_t count,
+    double &rate)
+{
+    vector<unique_ptr<HoldEvent>> events;
+    EventQueue eq("bench", backend);
+    curEventQueue(&eq);
+
+    mt19937_64 rng(pending);
+    uint64_t hash = 0;
+    for (size_t i = 0; i < pending; ++i) {
+        const Event::Priority pri =
+            Event::Default_Pri + static_cast<int>(rng() % 3) - 1;
+        events.emplace_back(new HoldEvent(eq, rng, events, hash, i, pri));
+        eq.schedule(events.back().get(), (rng() % 1000) * 500);
+    }
+
+    auto start = chrono::steady_clock::now();
+    for (uint64_t i = 0; i < count; ++i)
+        eq.serviceOne();
+    chrono::duration<double> elapsed = chrono::steady_clock::now() - start;
+
+    rate = count / elapsed.count();
+    while (!eq.empty())
+        eq.deschedule(eq.getHead());
+    curEventQueue(NULL);
+
+    return hash;
+}
+
+int
+main()
+{
+    const uint64_t count = 1000000;
+    bool match = true;
+
+    for (size_t pending : { 16, 128, 1024, 8192, 65536 }) {
+        double bins_rate, calendar_rate;
+        uint64_t bins_hash = run(EventQueue::BinList, pending, count,
+                                 bins_rate);
+        uint64_t calendar_hash = run(EventQueue::Calendar, pending, count,
+                                     calendar_rate);
+
+        cprintf("%6d pending: bin list %.0f events/s, "
+                "calendar %.0f events/s (%.2fx)%s\n",
+                pending, bins_rate, calendar_rate,
+                calendar_rate / bins_rate,
+                bins_hash == calendar_hash ? "" : ", ORDER MISMATCH");
+        match = match && bins_hash == calendar_hash;
+    }
+
+    return match ? 0 : 1;
+}
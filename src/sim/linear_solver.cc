@@ -37,6 +37,11 @@
 
 #include "sim/linear_solver.hh"
 
+#include <algorithm>
+#include <cmath>
+
+#include "base/logging.hh"
+
 std::vector <double>
 LinearSystem::solve() const
 {
@@ -83,3 +88,147 @@ LinearSystem::solve() const
 
     return ret;
 }
+
+std::string
+SparseLinearSystem::toStr() const
+{
+    std::ostringstream oss;
+    for (const auto &eq : equations) {
+        bool first = true;
+        for (const auto &coef : eq) {
+            if (!first)
+                oss << " + ";
+            oss << coef.second << "*x" << coef.first;
+            first = false;
+        }
+        oss << " + c = 0\n";
+    }
+    return oss.str();
+}
+
+void
+SparseLinearSystem::CompressedMatrix::append(
+    const std::map<unsigned, double> &row, int skip)
+{
+    if (start.empty())
+        start.push_back(0);
+    for (const auto &coef : row) {
+        if (coef.second != 0.0 && (int)coef.first != skip) {
+            column.push_back(coef.first);
+            value.push_back(coef.second);
+        }
+    }
+    start.push_back(column.size());
+}
+
+void
+SparseLinearSystem::compress()
+{
+    coefficients = CompressedMatrix();
+    diagonal.assign(size(), 0.0);
+    for (unsigned row = 0; row < size(); row++) {
+        const auto &eq = equations[row];
+        auto diag = eq.find(row);
+        panic_if(diag == eq.end() || diag->second == 0.0,
+                 "Equation %d has no diagonal coefficient\n", row);
+        diagonal[row] = diag->second;
+        coefficients.append(eq, row);
+    }
+
+    compressed = true;
+}
+
+void
+SparseLinearSystem::factorize()
+{
+    const unsigned order = size();
+
+    lower = CompressedMatrix();
+    upper = CompressedMatrix();
+    pivots.assign(order, 0.0);
+
+    // Doolittle elimination, one equation at a time: eliminating the
+    // unknowns before the diagonal (in increasing order) from a copy
+    // of the equation leaves its row of U, and the multipliers used
+    // are its row of L. Only the coefficients that are, or become,
+    // non-zero are stored.
+    for (unsigned row = 0; row < order; row++) {
+        std::map<unsigned, double> work(equations[row]);
+        std::map<unsigned, double> l_row;
+        for (auto it = work.begin(); it != work.end() && it->first < row;
+             it = work.erase(it)) {
+            if (it->second == 0.0)
+                continue;
+            const unsigned k = it->first;
+            const double factor = it->second / pivots[k];
+            l_row[k] = factor;
+            for (unsigned i = upper.start[k]; i < upper.start[k + 1]; i++)
+                work[upper.column[i]] -= factor * upper.value[i];
+        }
+
+        auto pivot = work.find(row);
+        panic_if(pivot == work.end() || pivot->second == 0.0,
+                 "Singular linear system\n");
+        pivots[row] = pivot->second;
+        work.erase(pivot);
+
+        lower.append(l_row);
+        upper.append(work);
+    }
+
+    factorized = true;
+}
+
+std::vector<double>
+SparseLinearSystem::solve(const std::vector<double> &cnt)
+{
+    assert(cnt.size() == size());
+    if (!factorized)
+        factorize();
+
+    // Solve L y = -cnt, then U x = y
+    const unsigned order = size();
+    std::vector<double> x(order);
+    for (unsigned row = 0; row < order; row++) {
+        double sum = -cnt[row];
+        for (unsigned i = lower.start[row]; i < lower.start[row + 1]; i++)
+            sum -= lower.value[i] * x[lower.column[i]];
+        x[row] = sum;
+    }
+    for (int row = order - 1; row >= 0; row--) {
+        double sum = x[row];
+        for (unsigned i = upper.start[row]; i < upper.start[row + 1]; i++)
+            sum -= upper.value[i] * x[upper.column[i]];
+        x[row] = sum / pivots[row];
+    }
+
+    return x;
+}
+
+bool
+SparseLinearSystem::solveIterative(const std::vector<double> &cnt,
+                                   std::vector<double> &x, double tolerance,
+                                   unsigned max_iterations)
+{
+    assert(cnt.size() == size() && x.size() == size());
+    if (!compressed)
+        compress();
+
+    for (unsigned iter = 0; iter < max_iterations; iter++) {
+        double max_change = 0.0;
+        for (unsigned row = 0; row < size(); row++) {
+            double sum = -cnt[row];
+            for (unsigned i = coefficients.start[row];
+                 i < coefficients.start[row + 1]; i++) {
+                sum -= coefficients.value[i] * x[coefficients.column[i]];
+            }
+            const double value = sum / diagonal[row];
+            max_change = std::max(max_change, std::abs(value - x[row]));
+            x[row] = value;
+        }
+        if (max_change <= tolerance)
+            return true;
+    }
+
+    return false;
+}
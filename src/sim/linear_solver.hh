@@ -39,6 +39,7 @@
 #define __SIM_LINEAR_SOLVER_HH__
 
 #include <cassert>
+#include <map>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -129,4 +130,97 @@ class LinearSystem {
     std::vector < LinearEquation > matrix;
 };
 
+/**
+ * A system of linear equations with few non-zero coefficients, where
+ * the coefficients of the unknowns rarely change while the constant
+ * terms change at every solve (as in a circuit whose topology is
+ * fixed). The coefficients are factorized once into sparse LU factors,
+ * which are reused until a coefficient changes.
+ *
+ * The factorization does not pivot, which is stable for the
+ * diagonally dominant systems of nodal equations.
+ */
+class SparseLinearSystem {
+  public:
+    SparseLinearSystem(unsigned unknowns)
+        : equations(unknowns), compressed(false), factorized(false)
+    {}
+
+    unsigned size() const { return equations.size(); }
+
+    /**
+     * Add a value to the coefficient of an unknown in an equation.
+     *
+     * @param eq The equation
+     * @param unkw The unknown
+     * @param value Value to add to the coefficient
+     */
+    void
+    addCoefficient(unsigned eq, unsigned unkw, double value)
+    {
+        assert(eq < size() && unkw < size());
+        equations[eq][unkw] += value;
+        compressed = false;
+        factorized = false;
+    }
+
+    std::string toStr() const;
+
+    /**
+     * Solve the system, factorizing its coefficients if they changed
+     * since the last solve.
+     *
+     * @param cnt The constant terms of the equations
+     * @return The values of the unknowns
+     */
+    std::vector<double> solve(const std::vector<double> &cnt);
+
+    /**
+     * Solve the system iteratively (Gauss-Seidel), starting from an
+     * approximate solution such as the one of a previous solve.
+     *
+     * @param cnt The constant terms of the equations
+     * @param x Initial values of the unknowns, updated with the result
+     * @param tolerance Largest change of an unknown in the last
+     *                  iteration for the solution to be accepted
+     * @param max_iterations Number of iterations after which to give up
+     * @return True if the solution converged
+     */
+    bool solveIterative(const std::vector<double> &cnt,
+                        std::vector<double> &x, double tolerance,
+                        unsigned max_iterations);
+
+  private:
+    /** Coefficients of the unknowns, by equation and unknown */
+    std::vector<std::map<unsigned, double>> equations;
+
+    /** Rows of a sparse matrix, stored contiguously */
+    struct CompressedMatrix {
+        std::vector<unsigned> start;
+        std::vector<unsigned> column;
+        std::vector<double> value;
+
+        /** Append a row, leaving out a column and the zeros */
+        void append(const std::map<unsigned, double> &row, int skip = -1);
+    };
+
+    /** Whether the coefficients are up to date in compressed form */
+    bool compressed;
+    /** Whether the LU factors are up to date */
+    bool factorized;
+
+    /** The coefficients off the diagonal, for iterative solves */
+    CompressedMatrix coefficients;
+    std::vector<double> diagonal;
+
+    /** L without its unit diagonal, and U without its diagonal */
+    CompressedMatrix lower;
+    CompressedMatrix upper;
+    /** Diagonal of U */
+    std::vector<double> pivots;
+
+    void compress();
+    void factorize();
+};
+
 #endif
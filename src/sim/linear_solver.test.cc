@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+#include "sim/linear_solver.hh"
+
+/**
+ * Thermal network of a grid of nodes, as for the floorplan of a chip:
+ * each node has a resistor to its neighbours, a capacitor and a
+ * resistor to the ambient temperature, and dissipates some power.
+ */
+class ThermalGrid
+{
+  private:
+    const unsigned width;
+    const unsigned height;
+    const double step = 0.01;
+    const double ambient = 25.0;
+    const double lateral = 1.0 / 0.5;
+    const double vertical = 1.0 / 20.0;
+    const double capacitance = 0.2;
+
+    std::vector<double> power;
+
+    unsigned node(unsigned x, unsigned y) const { return y * width + x; }
+
+    /** Call a function on each branch between two nodes of the grid */
+    template <class F>
+    void
+    forEachBranch(F f) const
+    {
+        for (unsigned y = 0; y < height; y++) {
+            for (unsigned x = 0; x < width; x++) {
+                if (x + 1 < width)
+                    f(node(x, y), node(x + 1, y), lateral);
+                if (y + 1 < height)
+                    f(node(x, y), node(x, y + 1), lateral);
+            }
+        }
+    }
+
+    double toAmbient() const { return vertical + capacitance / step; }
+
+  public:
+    std::vector<double> temps;
+
+    ThermalGrid(unsigned w, unsigned h)
+        : width(w), height(h), power(w * h), temps(w * h, ambient)
+    {
+        // A few hot spots
+        for (unsigned i = 0; i < power.size(); i++)
+            power[i] = (i % 7 == 0) ? 2.0 : 0.1;
+    }
+
+    unsigned size() const { return temps.size(); }
+
+    std::vector<double>
+    constants() const
+    {
+        std::vector<double> cnt(size());
+        for (unsigned i = 0; i < size(); i++) {
+            cnt[i] = power[i] + vertical * ambient +
+                capacitance / step * temps[i];
+        }
+        return cnt;
+    }
+
+    LinearSystem
+    dense() const
+    {
+        LinearSystem ls(size());
+        const std::vector<double> cnt = constants();
+        for (unsigned i = 0; i < size(); i++) {
+            ls[i][i] -= toAmbient();
+            ls[i][ls[i].cnt()] = cnt[i];
+        }
+        forEachBranch([&ls](unsigned a, unsigned b, double g) {
+            ls[a][a] -= g;
+            ls[a][b] += g;
+            ls[b][b] -= g;
+            ls[b][a] += g;
+        });
+        return ls;
+    }
+
+    SparseLinearSystem
+    sparse() const
+    {
+        SparseLinearSystem system(size());
+        for (unsigned i = 0; i < size(); i++)
+            system.addCoefficient(i, i, -toAmbient());
+        forEachBranch([&system](unsigned a, unsigned b, double g) {
+            system.addCoefficient(a, a, -g);
+            system.addCoefficient(a, b, g);
+            system.addCoefficient(b, b, -g);
+            system.addCoefficient(b, a, g);
+        });
+        return system;
+    }
+};
+
+TEST(SparseLinearSystemTest, Small)
+{
+    // 2x + y - 5 = 0, x + 3y - 10 = 0
+    SparseLinearSystem system(2);
+    system.addCoefficient(0, 0, 2);
+    system.addCoefficient(0, 1, 1);
+    system.addCoefficient(1, 0, 1);
+    system.addCoefficient(1, 1, 3);
+
+    std::vector<double> x = system.solve({ -5, -10 });
+    EXPECT_DOUBLE_EQ(1.0, x[0]);
+    EXPECT_DOUBLE_EQ(3.0, x[1]);
+
+    // The factors are updated when a coefficient changes
+    system.addCoefficient(0, 0, 2);
+    x = system.solve({ -5, -10 });
+    EXPECT_NEAR(5.0 / 11.0, x[0], 1e-12);
+    EXPECT_NEAR(35.0 / 11.0, x[1], 1e-12);
+}
+
+TEST(SparseLinearSystemTest, ThermalGridMatchesDense)
+{
+    ThermalGrid dense_grid(12, 10), lu_grid(12, 10), gs_grid(12, 10);
+    SparseLinearSystem lu = lu_grid.sparse();
+    SparseLinearSystem gs = gs_grid.sparse();
+
+    for (int step = 0; step < 50; step++) {
+        dense_grid.temps = dense_grid.dense().solve();
+        lu_grid.temps = lu.solve(lu_grid.constants());
+        ASSERT_TRUE(gs.solveIterative(gs_grid.constants(), gs_grid.temps,
+                                      1e-10, 1000));
+
+        for (unsigned i = 0; i < dense_grid.size(); i++) {
+            ASSERT_NEAR(dense_grid.temps[i], lu_grid.temps[i], 1e-9);
+            ASSERT_NEAR(dense_grid.temps[i], gs_grid.temps[i], 1e-6);
+        }
+    }
+
+    // The grid heated up
+    EXPECT_GT(lu_grid.temps[0], 26.0);
+}
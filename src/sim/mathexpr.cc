@@ -188,3 +188,148 @@ MathExpr::getVariables(const Node *n,
     }
 }
 
+
+unsigned
+MathExprProgram::constant(double value)
+{
+    // NaN can't be used as a key, and is rare enough not to share it
+    if (!std::isnan(value)) {
+        auto it = constMap.find(value);
+        if (it != constMap.end())
+            return it->second;
+        constMap[value] = regs.size();
+    }
+
+    regs.push_back(value);
+    producers.push_back(-1);
+    regVars.push_back(-1);
+    return regs.size() - 1;
+}
+
+unsigned
+MathExprProgram::compile(const MathExpr &expr, const MathExpr::Node *n)
+{
+    if (!n)
+        return constant(0);
+
+    if (n->op == MathExpr::sValue)
+        return constant(n->value);
+
+    if (n->op == MathExpr::sVariable) {
+        auto it = varMap.find(n->variable);
+        if (it != varMap.end())
+            return it->second;
+
+        const unsigned reg = regs.size();
+        varMap[n->variable] = reg;
+        regVars.push_back(varNames.size());
+        varNames.push_back(n->variable);
+        varRegs.push_back(reg);
+        regs.push_back(0);
+        producers.push_back(-1);
+        return reg;
+    }
+
+    auto op = std::find_if(expr.ops.begin(), expr.ops.end(),
+                           [n](const MathExpr::OpSearch &o) {
+                               return o.op == n->op;
+                           });
+    panic_if(op == expr.ops.end(), "Invalid node!\n");
+
+    unsigned l = compile(expr, n->l);
+    unsigned r = compile(expr, n->r);
+
+    // Fold operations on constants
+    if (producers[l] < 0 && regVars[l] < 0 &&
+        producers[r] < 0 && regVars[r] < 0) {
+        return constant(op->fn(regs[l], regs[r]));
+    }
+
+    // Addition and multiplication are commutative, so only one order
+    // of their operands needs to be compiled
+    if ((n->op == MathExpr::bAdd || n->op == MathExpr::bMul) && l > r)
+        std::swap(l, r);
+
+    const auto key = std::make_tuple((int)n->op, l, r);
+    auto it = opMap.find(key);
+    if (it != opMap.end())
+        return it->second;
+
+    const unsigned reg = regs.size();
+    opMap[key] = reg;
+    regs.push_back(0);
+    producers.push_back(code.size());
+    regVars.push_back(-1);
+    code.push_back({ n->op, reg, l, r });
+    return reg;
+}
+
+unsigned
+MathExprProgram::compile(const MathExpr &expr)
+{
+    Expression e;
+    e.result = compile(expr, expr.root);
+
+    // Find the instructions and variables the result depends on. The
+    // operands of an instruction are always compiled before it, so
+    // running these instructions in order computes the result.
+    std::vector<bool> visited(regs.size(), false);
+    std::vector<unsigned> pending(1, e.result);
+    while (!pending.empty()) {
+        const unsigned reg = pending.back();
+        pending.pop_back();
+        if (visited[reg])
+            continue;
+        visited[reg] = true;
+
+        if (regVars[reg] >= 0) {
+            e.inputs.push_back(regVars[reg]);
+        } else if (producers[reg] >= 0) {
+            const Instruction &inst = code[producers[reg]];
+            e.code.push_back(producers[reg]);
+            pending.push_back(inst.l);
+            pending.push_back(inst.r);
+        }
+    }
+    std::sort(e.code.begin(), e.code.end());
+    std::sort(e.inputs.begin(), e.inputs.end());
+
+    exprs.push_back(e);
+    return exprs.size() - 1;
+}
+
+double
+MathExprProgram::eval(unsigned expr)
+{
+    const Expression &e = exprs[expr];
+    for (unsigned i : e.code) {
+        const Instruction &inst = code[i];
+        const double l = regs[inst.l];
+        const double r = regs[inst.r];
+        double result;
+        switch (inst.op) {
+          case MathExpr::bAdd:
+            result = l + r;
+            break;
+          case MathExpr::bSub:
+            result = l - r;
+            break;
+          case MathExpr::bMul:
+            result = l * r;
+            break;
+          case MathExpr::bDiv:
+            result = l / r;
+            break;
+          case MathExpr::bPow:
+            result = std::pow(l, r);
+            break;
+          case MathExpr::uNeg:
+            result = -r;
+            break;
+          default:
+            panic("Invalid instruction!\n");
+        }
+        regs[inst.dest] = result;
+    }
+    return regs[e.result];
+}
@@ -41,10 +41,14 @@
 #include <algorithm>
 #include <array>
 #include <functional>
+#include <map>
 #include <string>
+#include <tuple>
 #include <vector>
 
 class MathExpr {
+    friend class MathExprProgram;
+
   public:
 
     MathExpr(std::string expr);
@@ -142,4 +146,96 @@ class MathExpr {
     void getVariables(const Node *n, std::vector<std::string> &vars) const;
 };
 
+/**
+ * A set of expressions compiled into a flat list of instructions
+ * working on registers, which are evaluated without walking the
+ * expression trees or looking up variables by name.
+ *
+ * Variables and constants live in registers of their own, and each
+ * operation writes its result to a new register. Operations on the
+ * same operands are only compiled once, even across expressions, and
+ * operations on constants are computed when compiling.
+ */
+class MathExprProgram
+{
+  public:
+    /**
+     * Compile an expression into the program.
+     *
+     * @param expr Expression to compile
+     * @return Handle of the expression, to pass to eval()
+     */
+    unsigned compile(const MathExpr &expr);
+
+    /**
+     * Names of the variables of all the compiled expressions. The
+     * variables are identified by their index in this vector.
+     */
+    const std::vector<std::string> &variables() const { return varNames; }
+
+    /** Variables an expression depends on */
+    const std::vector<unsigned> &
+    inputs(unsigned expr) const
+    {
+        return exprs[expr].inputs;
+    }
+
+    /** Set the value of a variable before evaluating expressions */
+    void
+    setVariable(unsigned var, double value)
+    {
+        regs[varRegs[var]] = value;
+    }
+
+    /**
+     * Evaluate an expression, using the values last set for its
+     * inputs.
+     *
+     * @param expr Handle of the expression
+     * @return The value of the expression
+     */
+    double eval(unsigned expr);
+
+  private:
+    struct Instruction
+    {
+        MathExpr::Operator op;
+        unsigned dest;
+        unsigned l;
+        unsigned r;
+    };
+
+    struct Expression
+    {
+        /** Indices of the instructions computing the expression */
+        std::vector<unsigned> code;
+        std::vector<unsigned> inputs;
+        unsigned result;
+    };
+
+    /** Compile a node and return the register holding its value */
+    unsigned compile(const MathExpr &expr, const MathExpr::Node *n);
+
+    unsigned constant(double value);
+
+    std::vector<double> regs;
+
+    /** Instruction writing each register, or -1 for inputs and constants */
+    std::vector<int> producers;
+
+    /** Variable held in each register, or -1 */
+    std::vector<int> regVars;
+
+    std::vector<Instruction> code;
+    std::vector<Expression> exprs;
+
+    std::vector<std::string> varNames;
+    std::vector<unsigned> varRegs;
+
+    /** Registers of the variables, constants and operations compiled */
+    std::map<std::string, unsigned> varMap;
+    std::map<double, unsigned> constMap;
+    std::map<std::tuple<int, unsigned, unsigned>, unsigned> opMap;
+};
+
 #endif
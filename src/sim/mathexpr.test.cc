@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <map>
+#include <string>
+
+#include "sim/mathexpr.hh"
+
+namespace {
+
+const std::map<std::string, double> values = {
+    { "a", 3.0 }, { "b", -2.5 }, { "system.cpu.ipc", 1.25 }, { "temp", 40 },
+};
+
+double
+lookup(const std::string &name)
+{
+    return values.at(name);
+}
+
+/** Evaluate the compiled expressions and check them against the trees */
+void
+checkProgram(const std::vector<std::string> &sources)
+{
+    std::vector<MathExpr> exprs;
+    MathExprProgram program;
+    std::vector<unsigned> handles;
+    for (const auto &source : sources) {
+        exprs.emplace_back(source);
+        handles.push_back(program.compile(exprs.back()));
+    }
+
+    for (int i = 0; i < exprs.size(); ++i) {
+        for (unsigned var : program.inputs(handles[i]))
+            program.setVariable(var, lookup(program.variables()[var]));
+        EXPECT_DOUBLE_EQ(exprs[i].eval(lookup), program.eval(handles[i]))
+            << sources[i];
+    }
+}
+
+} // anonymous namespace
+
+TEST(MathExprProgramTest, Operators)
+{
+    checkProgram({ "a + b", "a - b", "a * b", "a / b", "a ^ 2", "-a",
+                   "a - -b", "2 ^ 3 ^ 2", "(a + b) * (a - b)" });
+}
+
+TEST(MathExprProgramTest, Constants)
+{
+    checkProgram({ "1 + 2 * 3", "-4 / 8", "a * (2 + 3)", "0.5e1 - a" });
+}
+
+TEST(MathExprProgramTest, SharedSubexpressions)
+{
+    // The expressions share operations, which must not change their
+    // values, nor the variables they depend on
+    checkProgram({ "system.cpu.ipc * a + temp ^ 2",
+                   "temp ^ 2 - a * system.cpu.ipc",
+                   "(temp ^ 2) * (temp ^ 2) + b" });
+
+    MathExprProgram program;
+    program.compile(MathExpr("a * temp + b"));
+    const unsigned expr = program.compile(MathExpr("temp * a"));
+    ASSERT_EQ(3, program.variables().size());
+    ASSERT_EQ(2, program.inputs(expr).size());
+    for (unsigned var : program.inputs(expr))
+        EXPECT_NE("b", program.variables()[var]);
+}
@@ -80,6 +80,9 @@ class ThermalReference(SimObject, object):
     temperature = Param.Float(25.0, "Operational temperature in Celsius")
 
 
+# Methods to solve the nodal equations of a thermal model
+class ThermalSolver(Enum): vals = ['dense', 'sparse_lu', 'gauss_seidel']
+
 # Represents a thermal capacitor
 class ThermalModel(ClockedObject):
     type = 'ThermalModel'
@@ -96,6 +99,15 @@ class ThermalModel(ClockedObject):
 
     step = Param.Float(0.01, "Simulation step (in seconds) for thermal simulation")
 
+    solver = Param.ThermalSolver('sparse_lu', "Solver for the nodal "
+        "equations: dense Gaussian elimination at every step, sparse LU "
+        "factorization done once, or Gauss-Seidel iterations starting "
+        "from the previous temperatures")
+    solver_tolerance = Param.Float(1e-6, "Largest temperature change, in "
+        "Kelvin, of the last Gauss-Seidel iteration")
+    solver_max_iterations = Param.Unsigned(1000, "Number of Gauss-Seidel "
+        "iterations after which the sparse LU solver is used instead")
+
     def populate(self):
         if not hasattr(self,"_capacitors"): self._capacitors = []
         if not hasattr(self,"_resistors"): self._resistors = []
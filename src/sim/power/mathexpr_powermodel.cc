@@ -37,6 +37,7 @@
 
 #include "sim/power/mathexpr_powermodel.hh"
 
+#include <algorithm>
 #include <string>
 
 #include "base/statistics.hh"
@@ -46,66 +47,85 @@
 #include "sim/sim_object.hh"
 
 MathExprPowerModel::MathExprPowerModel(const Params *p)
-    : PowerModelState(p), dyn_expr(p->dyn), st_expr(p->st)
+    : PowerModelState(p), dyn_expr(p->dyn), st_expr(p->st),
+      dynProgram(program.compile(dyn_expr)),
+      stProgram(program.compile(st_expr))
 {
 }
 
 void
 MathExprPowerModel::startup()
 {
-    for (auto expr: {dyn_expr, st_expr}) {
-        std::vector<std::string> vars = expr.getVariables();
+    using namespace Stats;
+
+    // Resolve the variables once, so that evaluating the expressions
+    // doesn't need to look them up by name
+    for (const auto &var : program.variables()) {
+        // Automatic variables:
+        if (var == "temp") {
+            variables.push_back({ Variable::Temp, nullptr });
+            continue;
+        } else if (var == "voltage") {
+            variables.push_back({ Variable::Voltage, nullptr });
+            continue;
+        } else if (var == "clock_period") {
+            variables.push_back({ Variable::ClockPeriod, nullptr });
+            continue;
+        }
 
-        for (auto var: vars) {
-            // Automatic variables:
-            if (var == "temp" || var == "voltage" || var == "clock_period") {
-                continue;
-            }
+        auto *info = Stats::resolve(var);
+        fatal_if(!info, "Failed to evaluate %s in expression:\n%s\n%s\n",
+                 var, dyn_expr.toStr(), st_expr.toStr());
 
-            auto *info = Stats::resolve(var);
-            fatal_if(!info, "Failed to evaluate %s in expression:\n%s\n",
-                     var, expr.toStr());
-            statsMap[var] = info;
+        // Only these types of stats are supported right now
+        if (dynamic_cast<const ScalarInfo *>(info)) {
+            variables.push_back({ Variable::Scalar, info });
+        } else if (dynamic_cast<const FormulaInfo *>(info)) {
+            variables.push_back({ Variable::Formula, info });
+        } else {
+            panic("Unknown stat type!\n");
         }
     }
 }
 
 double
-MathExprPowerModel::eval(const MathExpr &expr) const
+MathExprPowerModel::eval(unsigned expr) const
 {
-    return expr.eval(
-        std::bind(&MathExprPowerModel::getStatValue,
-                  this, std::placeholders::_1)
-        );
+    assert(variables.size() == program.variables().size());
+
+    for (unsigned var : program.inputs(expr))
+        program.setVariable(var, value(variables[var]));
+    return program.eval(expr);
 }
 
 double
-MathExprPowerModel::getStatValue(const std::string &name) const
+MathExprPowerModel::value(const Variable &var) const
 {
     using namespace Stats;
 
-    // Automatic variables:
-    if (name == "temp") {
+    switch (var.kind) {
+      case Variable::Temp:
         return _temp;
-    } else if (name == "voltage") {
+      case Variable::Voltage:
         return clocked_object->voltage();
-    } else if (name=="clock_period") {
+      case Variable::ClockPeriod:
         return clocked_object->clockPeriod();
+      case Variable::Scalar:
+        return static_cast<const ScalarInfo *>(var.info)->value();
+      case Variable::Formula:
+        return static_cast<const FormulaInfo *>(var.info)->total();
+      default:
+        panic("Unknown variable!\n");
     }
+}
 
-    const auto it = statsMap.find(name);
-    assert(it != statsMap.cend());
-    const Info *info = it->second;
-
-    // Try to cast the stat, only these are supported right now
-    auto si = dynamic_cast<const ScalarInfo *>(info);
-    if (si)
-        return si->value();
-    auto fi = dynamic_cast<const FormulaInfo *>(info);
-    if (fi)
-        return fi->total();
-
-    panic("Unknown stat type!\n");
+double
+MathExprPowerModel::getStatValue(const std::string &name) const
+{
+    const auto &names = program.variables();
+    const auto it = std::find(names.begin(), names.end(), name);
+    assert(it != names.end());
+    return value(variables[it - names.begin()]);
 }
 
 void
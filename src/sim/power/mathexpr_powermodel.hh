@@ -38,7 +38,7 @@
 #ifndef __SIM_MATHEXPR_POWERMODEL_PM_HH__
 #define __SIM_MATHEXPR_POWERMODEL_PM_HH__
 
-#include <unordered_map>
+#include <vector>
 
 #include "params/MathExprPowerModel.hh"
 #include "sim/mathexpr.hh"
@@ -64,14 +64,14 @@ class MathExprPowerModel : public PowerModelState
      *
      * @return Power (Watts) consumed by this object (dynamic component)
      */
-    double getDynamicPower() const override { return eval(dyn_expr); }
+    double getDynamicPower() const override { return eval(dynProgram); }
 
     /**
      * Get the static power consumption.
      *
      * @return Power (Watts) consumed by this object (static component)
      */
-    double getStaticPower() const override { return eval(st_expr); }
+    double getStaticPower() const override { return eval(stProgram); }
 
     /**
      * Get the value for a variable (maps to a stat)
@@ -86,20 +86,38 @@ class MathExprPowerModel : public PowerModelState
     void regStats() override;
 
   private:
+    /** Where the value of a variable of the expressions comes from */
+    struct Variable
+    {
+        enum Kind { Temp, Voltage, ClockPeriod, Scalar, Formula };
+
+        Kind kind;
+        const Stats::Info *info;
+    };
+
     /**
-     * Evaluate an expression in the context of this object, fatal if
-     * evaluation fails.
+     * Evaluate a compiled expression in the context of this object.
      *
-     * @param expr Expression to evaluate
+     * @param expr Handle of the expression in the program
      * @return Value of expression.
      */
-    double eval(const MathExpr &expr) const;
+    double eval(unsigned expr) const;
+
+    /** Get the current value of a variable */
+    double value(const Variable &var) const;
 
     // Math expressions for dynamic and static power
     MathExpr dyn_expr, st_expr;
 
-    // Map that contains relevant stats for this power model
-    std::unordered_map<std::string, const Stats::Info*> statsMap;
+    /**
+     * Both expressions, compiled together. Evaluating them sets the
+     * variables and registers of the program.
+     */
+    mutable MathExprProgram program;
+    unsigned dynProgram, stProgram;
+
+    /** Sources of the variables, indexed as in the program */
+    std::vector<Variable> variables;
 };
 
 #endif
@@ -116,3 +116,11 @@ ThermalDomain::getEquation(ThermalNode * tn, unsigned n, double step) const
         eq[eq.cnt()] = power;
     return eq;
 }
+
+void
+ThermalDomain::addConstants(std::vector<double> &cnt, double step) const
+{
+    if (!node->isref)
+        cnt[node->id] += subsystem->getDynamicPower() +
+            subsystem->getStaticPower();
+}
@@ -83,6 +83,12 @@ class ThermalDomain : public SimObject, public ThermalEntity
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
 
+    void addCoefficients(SparseLinearSystem &system,
+                         double step) const override {}
+
+    /** Add the power of the domain to the equation of its node */
+    void addConstants(std::vector<double> &cnt, double step) const override;
+
     /**
       *  Emit a temperature update through probe points interface
       */
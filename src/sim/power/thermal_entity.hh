@@ -38,9 +38,12 @@
 #ifndef __SIM_THERMAL_ENTITY_HH__
 #define __SIM_THERMAL_ENTITY_HH__
 
+#include <vector>
+
 #include "sim/sim_object.hh"
 
 class LinearEquation;
+class SparseLinearSystem;
 class ThermalNode;
 
 /**
@@ -54,6 +57,15 @@ class ThermalEntity
     // Get the equation given a node and a step in seconds (assuming N nodes)
     virtual LinearEquation getEquation(ThermalNode *tn, unsigned n,
                                        double step) const = 0;
+
+    // Add the coefficients of the nodal equations of this entity to a
+    // system, these only depend on the topology and the step
+    virtual void addCoefficients(SparseLinearSystem &system,
+                                 double step) const = 0;
+
+    // Add the constant terms of the nodal equations of this entity
+    virtual void addConstants(std::vector<double> &cnt,
+                              double step) const = 0;
 };
 
 
@@ -46,6 +46,50 @@
 #include "sim/power/thermal_domain.hh"
 #include "sim/sim_object.hh"
 
+/**
+ * Add the coefficients of a two-terminal entity of conductance g to
+ * the equations of its nodes, which are g * (Vn2 - Vn1) for node1 and
+ * the opposite for node2.
+ */
+static void
+addBranchCoefficients(SparseLinearSystem &system, const ThermalNode *node1,
+                      const ThermalNode *node2, double g)
+{
+    for (const ThermalNode *n : { node1, node2 }) {
+        if (n->isref)
+            continue;
+
+        const double sign = n == node1 ? 1.0 : -1.0;
+        if (!node1->isref)
+            system.addCoefficient(n->id, node1->id, -sign * g);
+        if (!node2->isref)
+            system.addCoefficient(n->id, node2->id, sign * g);
+    }
+}
+
+/**
+ * Add the terms of a two-terminal entity of conductance g which come
+ * from the nodes of fixed temperature, plus a constant current flowing
+ * from node1 to node2.
+ */
+static void
+addBranchConstants(std::vector<double> &cnt, const ThermalNode *node1,
+                   const ThermalNode *node2, double g, double current)
+{
+    for (const ThermalNode *n : { node1, node2 }) {
+        if (n->isref)
+            continue;
+
+        const double sign = n == node1 ? 1.0 : -1.0;
+        double term = current;
+        if (node1->isref)
+            term -= g * node1->temp;
+        if (node2->isref)
+            term += g * node2->temp;
+        cnt[n->id] += sign * term;
+    }
+}
+
 /**
  * ThermalReference
  */
@@ -79,6 +123,17 @@ ThermalReference::getEquation(ThermalNode * n, unsigned nnodes,
     return LinearEquation(nnodes);
 }
 
+void
+ThermalReference::addCoefficients(SparseLinearSystem &system,
+                                  double step) const
+{
+}
+
+void
+ThermalReference::addConstants(std::vector<double> &cnt, double step) const
+{
+}
+
 /**
  * ThermalResistor
  */
@@ -132,6 +187,19 @@ ThermalResistor::getEquation(ThermalNode * n, unsigned nnodes,
     return eq;
 }
 
+void
+ThermalResistor::addCoefficients(SparseLinearSystem &system,
+                                 double step) const
+{
+    addBranchCoefficients(system, node1, node2, 1.0 / _resistance);
+}
+
+void
+ThermalResistor::addConstants(std::vector<double> &cnt, double step) const
+{
+    addBranchConstants(cnt, node1, node2, 1.0 / _resistance, 0.0);
+}
+
 /**
  * ThermalCapacitor
  */
@@ -188,11 +256,28 @@ ThermalCapacitor::getEquation(ThermalNode * n, unsigned nnodes,
     return eq;
 }
 
+void
+ThermalCapacitor::addCoefficients(SparseLinearSystem &system,
+                                  double step) const
+{
+    addBranchCoefficients(system, node1, node2, _capacitance / step);
+}
+
+void
+ThermalCapacitor::addConstants(std::vector<double> &cnt, double step) const
+{
+    // The temperatures of the previous step act as a current source
+    addBranchConstants(cnt, node1, node2, _capacitance / step,
+                       _capacitance / step * (node1->temp - node2->temp));
+}
+
 /**
  * ThermalModel
  */
 ThermalModel::ThermalModel(const Params *p)
-    : ClockedObject(p), stepEvent([this]{ doStep(); }, name()), _step(p->step)
+    : ClockedObject(p), stepEvent([this]{ doStep(); }, name()), _step(p->step),
+      solver(p->solver), solverTolerance(p->solver_tolerance),
+      solverMaxIterations(p->solver_max_iterations), system(0)
 {
 }
 
@@ -218,20 +303,44 @@ void
 ThermalModel::doStep()
 {
     // Calculate new temperatures!
-    // For each node in the system, create the kirchhoff nodal equation
-    LinearSystem ls(eq_nodes.size());
-    for (unsigned i = 0; i < eq_nodes.size(); i++) {
-        auto n = eq_nodes[i];
-        LinearEquation node_equation (eq_nodes.size());
-        for (auto e : entities) {
-            LinearEquation eq = e->getEquation(n, eq_nodes.size(), _step);
-            node_equation = node_equation + eq;
+    std::vector <double> temps;
+    if (solver == Enums::dense) {
+        // For each node in the system, create the kirchhoff nodal equation
+        LinearSystem ls(eq_nodes.size());
+        for (unsigned i = 0; i < eq_nodes.size(); i++) {
+            auto n = eq_nodes[i];
+            LinearEquation node_equation (eq_nodes.size());
+            for (auto e : entities) {
+                LinearEquation eq = e->getEquation(n, eq_nodes.size(), _step);
+                node_equation = node_equation + eq;
+            }
+            ls[i] = node_equation;
         }
-        ls[i] = node_equation;
+
+        temps = ls.solve();
+    } else {
+        // Only the constant terms of the equations change over time
+        std::vector <double> cnt(eq_nodes.size(), 0.0);
+        for (auto e : entities)
+            e->addConstants(cnt, _step);
+
+        bool solved = false;
+        if (solver == Enums::gauss_seidel) {
+            for (auto n : eq_nodes)
+                temps.push_back(n->temp);
+            solved = system.solveIterative(cnt, temps, solverTolerance,
+                                           solverMaxIterations);
+            if (!solved) {
+                warn_once("%s: Thermal solver did not converge in %d "
+                          "iterations, using LU factorization\n", name(),
+                          solverMaxIterations);
+            }
+        }
+        if (!solved)
+            temps = system.solve(cnt);
     }
 
     // Get temperatures for this iteration
-    std::vector <double> temps = ls.solve();
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->temp = temps[i];
 
@@ -272,6 +381,12 @@ ThermalModel::startup()
     for (unsigned i = 0; i < eq_nodes.size(); i++)
         eq_nodes[i]->id = i;
 
+    // The coefficients of the equations don't change from a step to
+    // the next, set them up once for the sparse solvers
+    system = SparseLinearSystem(eq_nodes.size());
+    for (auto e : entities)
+        e->addCoefficients(system, _step);
+
     // Schedule first thermal update
     schedule(stepEvent, curTick() + SimClock::Int::s * _step);
 }
@@ -45,6 +45,7 @@
 #include "params/ThermalReference.hh"
 #include "params/ThermalResistor.hh"
 #include "sim/clocked_object.hh"
+#include "sim/linear_solver.hh"
 #include "sim/power/thermal_domain.hh"
 #include "sim/power/thermal_entity.hh"
 #include "sim/power/thermal_node.hh"
@@ -72,6 +73,9 @@ class ThermalResistor : public SimObject, public ThermalEntity
 
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
+    void addCoefficients(SparseLinearSystem &system,
+                         double step) const override;
+    void addConstants(std::vector<double> &cnt, double step) const override;
 
   private:
     /* Resistance value in K/W */
@@ -96,6 +100,9 @@ class ThermalCapacitor : public SimObject, public ThermalEntity
 
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
+    void addCoefficients(SparseLinearSystem &system,
+                         double step) const override;
+    void addConstants(std::vector<double> &cnt, double step) const override;
 
     void setNodes(ThermalNode * n1, ThermalNode * n2) {
         node1 = n1;
@@ -125,6 +132,9 @@ class ThermalReference : public SimObject, public ThermalEntity
 
     LinearEquation getEquation(ThermalNode * tn, unsigned n,
                                double step) const override;
+    void addCoefficients(SparseLinearSystem &system,
+                         double step) const override;
+    void addConstants(std::vector<double> &cnt, double step) const override;
 
     void serialize(CheckpointOut &cp) const override;
     void unserialize(CheckpointIn &cp) override;
@@ -184,6 +194,20 @@ class ThermalModel : public ClockedObject
     /** Step in seconds for thermal updates */
     double _step;
 
+    /** How the nodal equations are solved */
+    const Enums::ThermalSolver solver;
+
+    /** Convergence criterion of the iterative solver, in Kelvin */
+    const double solverTolerance;
+
+    const unsigned solverMaxIterations;
+
+    /**
+     * Coefficients of the nodal equations for the sparse solvers. They
+     * only depend on the topology of the model and on the step, and
+     * are set up once.
+     */
+    SparseLinearSystem system;
 };
 
 #endif
@@ -112,6 +112,14 @@ Root::Root(RootParams *p)
     lastTime.setTimer();
 
     simQuantum = p->sim_quantum;
+
+    mainEventQueueBackend = p->eventq_backend == Enums::Calendar ?
+        EventQueue::Calendar : EventQueue::BinList;
+    for (uint32_t i = 0; i < numMainEventQueues; ++i)
+        mainEventQueue[i]->backend(mainEventQueueBackend);
+
+    CheckpointIn::binaryFormat = p->checkpoint_format == Enums::binary;
+    CheckpointIn::backgroundWrite = p->checkpoint_in_background;
 }
 
 void
@@ -45,17 +45,25 @@
 #include <sys/stat.h>
 #include <sys/time.h>
 #include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
 
 #include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <fstream>
 #include <list>
+#include <memory>
 #include <string>
 #include <vector>
 
+#include "base/callback.hh"
 #include "base/inifile.hh"
 #include "base/output.hh"
 #include "base/trace.hh"
 #include "debug/Checkpoint.hh"
+#include "sim/core.hh"
 #include "sim/eventq.hh"
 #include "sim/sim_events.hh"
 #include "sim/sim_exit.hh"
@@ -184,20 +192,120 @@ Serializable::unserializeSection(CheckpointIn &cp, const char *name)
 void
 Serializable::serializeAll(const string &cpt_dir)
 {
+    // Only keep one snapshot of the simulator alive, which bounds the
+    // memory taken by the copies of the pages modified meanwhile.
+    waitBulkWrites();
+
     string dir = CheckpointIn::setDir(cpt_dir);
     if (mkdir(dir.c_str(), 0775) == -1 && errno != EEXIST)
             fatal("couldn't mkdir %s\n", dir);
 
     string cpt_file = dir + CheckpointIn::baseFilename;
-    ofstream outstream(cpt_file.c_str());
+    ofstream outstream(cpt_file.c_str(), ios::binary);
     time_t t = time(NULL);
     if (!outstream.is_open())
         fatal("Unable to open file %s for writing\n", cpt_file.c_str());
-    outstream << "## checkpoint generated: " << ctime(&t);
 
-    globals.serializeSection(outstream, "Globals");
+    // Binary checkpoints are written through the same stream
+    // interface, the writer turns the text it receives into records.
+    unique_ptr<BinaryCheckpointWriter> writer;
+    unique_ptr<ostream> binstream;
+    if (CheckpointIn::binaryFormat) {
+        writer.reset(new BinaryCheckpointWriter(outstream));
+        binstream.reset(new ostream(writer.get()));
+    }
+    CheckpointOut &cp = binstream ? *binstream : outstream;
+
+    cp << "## checkpoint generated: " << ctime(&t);
+
+    globals.serializeSection(cp, "Globals");
+
+    SimObject::serializeAll(cp);
+
+    if (!bulkWrites.empty())
+        startBulkWrites();
+}
+
+namespace {
+
+class BulkWritesCallback : public Callback
+{
+  public:
+    void process() override { Serializable::waitBulkWrites(); }
+};
+
+} // anonymous namespace
+
+vector<function<void()>> Serializable::bulkWrites;
+
+pid_t Serializable::bulkWriter = 0;
+
+void
+Serializable::writeBulk(function<void()> write)
+{
+    if (CheckpointIn::backgroundWrite)
+        bulkWrites.push_back(move(write));
+    else
+        write();
+}
+
+void
+Serializable::startBulkWrites()
+{
+    static bool registered = false;
+    if (!registered) {
+        registerExitCallback(new BulkWritesCallback);
+        registered = true;
+    }
+
+    // Output buffered in the parent would otherwise be written by
+    // both processes.
+    cout.flush();
+    cerr.flush();
+    fflush(NULL);
+
+    const pid_t pid = fork();
+    if (pid < 0) {
+        warn("Can't fork to write the checkpoint in the background: %s\n",
+             strerror(errno));
+        for (auto &write : bulkWrites)
+            write();
+    } else if (pid == 0) {
+        // The child only sees the memory as it was when forked, and
+        // must leave without running the exit handlers of the parent.
+        // The writers call fatal() on errors, which leaves through
+        // exit(). Handlers run in the reverse order of registration,
+        // so this one reports the failure before any of the parent's.
+        std::atexit([]() { _exit(1); });
+        for (auto &write : bulkWrites)
+            write();
+        _exit(0);
+    } else {
+        inform("Writing checkpoint data in the background (pid %d)\n", pid);
+        bulkWriter = pid;
+    }
+    bulkWrites.clear();
+}
+
+void
+Serializable::waitBulkWrites()
+{
+    if (bulkWriter == 0)
+        return;
+
+    int status;
+    pid_t ret;
+    do {
+        ret = waitpid(bulkWriter, &status, 0);
+    } while (ret < 0 && errno == EINTR);
+    const pid_t pid = bulkWriter;
+    bulkWriter = 0;
 
-    SimObject::serializeAll(outstream);
+    // The writer is not a child of simulators forked meanwhile.
+    if (ret < 0 && errno == ECHILD)
+        return;
+    if (ret < 0 || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        fatal("Writing checkpoint data in process %d failed\n", pid);
 }
 
 void
@@ -245,6 +353,10 @@ Serializable::currentSection()
 
 const char *CheckpointIn::baseFilename = "m5.cpt";
 
+bool CheckpointIn::binaryFormat = false;
+
+bool CheckpointIn::backgroundWrite = false;
+
 string CheckpointIn::currentDirectory;
 
 string
@@ -266,38 +378,64 @@ CheckpointIn::dir()
 }
 
 CheckpointIn::CheckpointIn(const string &cpt_dir, SimObjectResolver &resolver)
-    : db(new IniFile), objNameResolver(resolver), _cptDir(setDir(cpt_dir))
+    : db(nullptr), binaryDb(nullptr), objNameResolver(resolver),
+      _cptDir(setDir(cpt_dir))
 {
     string filename = getCptDir() + "/" + CheckpointIn::baseFilename;
-    if (!db->load(filename)) {
-        fatal("Can't load checkpoint file '%s'\n", filename);
+    if (BinaryCheckpoint::isBinary(filename)) {
+        binaryDb = new BinaryCheckpoint;
+        if (!binaryDb->load(filename))
+            fatal("Can't load binary checkpoint file '%s'\n", filename);
+    } else {
+        db = new IniFile;
+        if (!db->load(filename))
+            fatal("Can't load checkpoint file '%s'\n", filename);
     }
 }
 
 CheckpointIn::~CheckpointIn()
 {
     delete db;
+    delete binaryDb;
 }
 
 bool
 CheckpointIn::entryExists(const string &section, const string &entry)
 {
+    if (binaryDb)
+        return binaryDb->find(section, entry);
     return db->entryExists(section, entry);
 }
 
 bool
 CheckpointIn::find(const string &section, const string &entry, string &value)
 {
+    if (binaryDb) {
+        const BinaryCheckpoint::Entry *e = binaryDb->find(section, entry);
+        if (!e)
+            return false;
+        value = e->toString();
+        return true;
+    }
     return db->find(section, entry, value);
 }
 
+const BinaryCheckpoint::Entry *
+CheckpointIn::findNative(const string &section, const string &entry)
+{
+    if (!binaryDb)
+        return nullptr;
+    const BinaryCheckpoint::Entry *e = binaryDb->find(section, entry);
+    return e && e->type != BinaryCheckpoint::Type::String ? e : nullptr;
+}
+
 bool
 CheckpointIn::findObj(const string &section, const string &entry,
                     SimObject *&value)
 {
     string path;
 
-    if (!db->find(section, entry, path))
+    if (!find(section, entry, path))
         return false;
 
     value = objNameResolver.resolveSimObject(path);
@@ -307,6 +445,8 @@ CheckpointIn::findObj(const string &section, const string &entry,
 bool
 CheckpointIn::sectionExists(const string &section)
 {
+    if (binaryDb)
+        return binaryDb->sectionExists(section);
     return db->sectionExists(section);
 }
 
@@ -45,18 +45,22 @@
 #ifndef __SERIALIZE_HH__
 #define __SERIALIZE_HH__
 
+#include <sys/types.h>
 
 #include <algorithm>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <map>
 #include <stack>
 #include <set>
+#include <type_traits>
 #include <vector>
 
 #include "base/bitunion.hh"
 #include "base/logging.hh"
 #include "base/str.hh"
+#include "sim/binary_checkpoint.hh"
 
 class IniFile;
 class SimObject;
@@ -70,6 +74,9 @@ class CheckpointIn
 
     IniFile *db;
 
+    /** Contents of the checkpoint if it is in the binary format */
+    BinaryCheckpoint *binaryDb;
+
     SimObjectResolver &objNameResolver;
 
     const std::string _cptDir;
@@ -94,6 +101,16 @@ class CheckpointIn
     bool sectionExists(const std::string &section);
     /** @}*/ //end of api_checkout group
 
+    /**
+     * Find an entry stored as numbers in a binary checkpoint.
+     *
+     * @return The entry, or nullptr if the checkpoint is not binary,
+     * or the entry does not exist or is stored as text. The value
+     * then has to be parsed from the result of find().
+     */
+    const BinaryCheckpoint::Entry *findNative(const std::string &section,
+                                              const std::string &entry);
+
     // The following static functions have to do with checkpoint
     // creation rather than restoration.  This class makes a handy
     // namespace for them though.  Currently no Checkpoint object is
@@ -131,6 +148,13 @@ class CheckpointIn
 
     // Filename for base checkpoint file within directory.
     static const char *baseFilename;
+
+    // Whether new checkpoints are written in the binary format
+    static bool binaryFormat;
+
+    // Whether the bulk data of new checkpoints is written in the
+    // background, see Serializable::writeBulk()
+    static bool backgroundWrite;
 };
 
 /**
@@ -306,8 +330,38 @@ class Serializable
      */
     static void unserializeGlobals(CheckpointIn &cp);
 
+    /**
+     * Write bulk data of the checkpoint being taken, such as the
+     * contents of a memory, to files of the checkpoint directory.
+     *
+     * If checkpoints are written in the background, the write is
+     * deferred until all the objects are serialized, and is then done
+     * by a child process holding a copy-on-write snapshot of the
+     * simulator while the simulation goes on. Otherwise the data is
+     * written right away.
+     *
+     * @param write Function writing the data, which may not change
+     * the state of the simulator as it may run in another process.
+     */
+    static void writeBulk(std::function<void()> write);
+
+    /**
+     * Wait for the bulk data of the last checkpoint to be written, if
+     * it is being written in the background.
+     */
+    static void waitBulkWrites();
+
   private:
     static std::stack<std::string> path;
+
+    /** Bulk writes deferred until the objects are serialized */
+    static std::vector<std::function<void()>> bulkWrites;
+
+    /** Process writing bulk data in the background, or 0 if none */
+    static pid_t bulkWriter;
+
+    /** Write the deferred bulk data in a child process */
+    static void startBulkWrites();
 };
 
 /**
@@ -446,6 +500,73 @@ parseParam(const std::string &s, std::string &value)
     return true;
 }
 
+/**
+ * Store numbers natively if the checkpoint is binary.
+ *
+ * @return False if the values have to be written as text.
+ */
+template <class T, class Iter>
+typename std::enable_if<std::is_arithmetic<T>::value, bool>::type
+nativeParamOut(CheckpointOut &os, const std::string &name,
+               Iter begin, uint64_t size)
+{
+    auto *writer = dynamic_cast<BinaryCheckpointWriter *>(os.rdbuf());
+    if (!writer)
+        return false;
+    writer->put<T>(name, begin, size);
+    return true;
+}
+
+template <class T, class Iter>
+typename std::enable_if<!std::is_arithmetic<T>::value, bool>::type
+nativeParamOut(CheckpointOut &os, const std::string &name,
+               Iter begin, uint64_t size)
+{
+    return false;
+}
+
+/**
+ * Find numbers stored natively in a binary checkpoint.
+ *
+ * @return The entry, or nullptr if the value has to be parsed from
+ * text.
+ */
+template <class T>
+typename std::enable_if<std::is_arithmetic<T>::value,
+                        const BinaryCheckpoint::Entry *>::type
+nativeParamIn(CheckpointIn &cp, const std::string &section,
+              const std::string &name)
+{
+    return cp.findNative(section, name);
+}
+
+template <class T>
+typename std::enable_if<!std::is_arithmetic<T>::value,
+                        const BinaryCheckpoint::Entry *>::type
+nativeParamIn(CheckpointIn &cp, const std::string &section,
+              const std::string &name)
+{
+    return nullptr;
+}
+
+/**
+ * Get a value of an entry found by nativeParamIn(), which is only
+ * ever the case for numbers.
+ */
+template <class T>
+typename std::enable_if<std::is_arithmetic<T>::value, T>::type
+nativeValue(const BinaryCheckpoint::Entry *entry, uint64_t i)
+{
+    return entry->get<T>(i);
+}
+
+template <class T>
+typename std::enable_if<!std::is_arithmetic<T>::value, T>::type
+nativeValue(const BinaryCheckpoint::Entry *entry, uint64_t i)
+{
+    panic("Only numbers are stored natively in checkpoints.\n");
+}
+
 /**
  * @ingroup api_serialize
  */
@@ -453,6 +574,9 @@ template <class T>
 void
 paramOut(CheckpointOut &os, const std::string &name, const T &param)
 {
+    if (nativeParamOut<T>(os, name, &param, 1))
+        return;
+
     os << name << "=";
     showParam(os, param);
     os << "\n";
@@ -466,6 +590,13 @@ void
 paramIn(CheckpointIn &cp, const std::string &name, T &param)
 {
     const std::string &section(Serializable::currentSection());
+    if (auto entry = nativeParamIn<T>(cp, section, name)) {
+        fatal_if(entry->count != 1, "Can't unserialize '%s:%s'\n",
+                 section, name);
+        param = nativeValue<T>(entry, 0);
+        return;
+    }
+
     std::string str;
     if (!cp.find(section, name, str) || !parseParam(str, param)) {
         fatal("Can't unserialize '%s:%s'\n", section, name);
@@ -481,6 +612,13 @@ optParamIn(CheckpointIn &cp, const std::string &name,
            T &param, bool warn = true)
 {
     const std::string &section(Serializable::currentSection());
+    if (auto entry = nativeParamIn<T>(cp, section, name)) {
+        if (entry->count == 1) {
+            param = nativeValue<T>(entry, 0);
+            return true;
+        }
+    }
+
     std::string str;
     if (!cp.find(section, name, str) || !parseParam(str, param)) {
         if (warn)
@@ -499,6 +637,9 @@ void
 arrayParamOut(CheckpointOut &os, const std::string &name,
               const std::vector<T> &param)
 {
+    if (nativeParamOut<T>(os, name, param.begin(), param.size()))
+        return;
+
     typename std::vector<T>::size_type size = param.size();
     os << name << "=";
     if (size > 0)
@@ -518,6 +659,9 @@ void
 arrayParamOut(CheckpointOut &os, const std::string &name,
               const std::list<T> &param)
 {
+    if (nativeParamOut<T>(os, name, param.begin(), param.size()))
+        return;
+
     typename std::list<T>::const_iterator it = param.begin();
 
     os << name << "=";
@@ -540,6 +684,9 @@ void
 arrayParamOut(CheckpointOut &os, const std::string &name,
               const std::set<T> &param)
 {
+    if (nativeParamOut<T>(os, name, param.begin(), param.size()))
+        return;
+
     typename std::set<T>::const_iterator it = param.begin();
 
     os << name << "=";
@@ -562,6 +709,9 @@ void
 arrayParamOut(CheckpointOut &os, const std::string &name,
               const T *param, unsigned size)
 {
+    if (nativeParamOut<T>(os, name, param, size))
+        return;
+
     os << name << "=";
     if (size > 0)
         showParam(os, param[0]);
@@ -589,6 +739,15 @@ arrayParamIn(CheckpointIn &cp, const std::string &name,
              T *param, unsigned size)
 {
     const std::string &section(Serializable::currentSection());
+    if (auto entry = nativeParamIn<T>(cp, section, name)) {
+        fatal_if(entry->count != size,
+                 "Array size mismatch on %s:%s (Got %u, expected %u)'\n",
+                 section, name, entry->count, size);
+        for (unsigned i = 0; i < size; ++i)
+            param[i] = nativeValue<T>(entry, i);
+        return;
+    }
+
     std::string str;
     if (!cp.find(section, name, str)) {
         fatal("Can't unserialize '%s:%s'\n", section, name);
@@ -636,6 +795,13 @@ void
 arrayParamIn(CheckpointIn &cp, const std::string &name, std::vector<T> &param)
 {
     const std::string &section(Serializable::currentSection());
+    if (auto entry = nativeParamIn<T>(cp, section, name)) {
+        param.resize(entry->count);
+        for (uint64_t i = 0; i < entry->count; ++i)
+            param[i] = nativeValue<T>(entry, i);
+        return;
+    }
+
     std::string str;
     if (!cp.find(section, name, str)) {
         fatal("Can't unserialize '%s:%s'\n", section, name);
@@ -681,6 +847,13 @@ void
 arrayParamIn(CheckpointIn &cp, const std::string &name, std::list<T> &param)
 {
     const std::string &section(Serializable::currentSection());
+    if (auto entry = nativeParamIn<T>(cp, section, name)) {
+        param.clear();
+        for (uint64_t i = 0; i < entry->count; ++i)
+            param.push_back(nativeValue<T>(entry, i));
+        return;
+    }
+
     std::string str;
     if (!cp.find(section, name, str)) {
         fatal("Can't unserialize '%s:%s'\n", section, name);
@@ -714,6 +887,13 @@ void
 arrayParamIn(CheckpointIn &cp, const std::string &name, std::set<T> &param)
 {
     const std::string &section(Serializable::currentSection());
+    if (auto entry = nativeParamIn<T>(cp, section, name)) {
+        param.clear();
+        for (uint64_t i = 0; i < entry->count; ++i)
+            param.insert(nativeValue<T>(entry, i));
+        return;
+    }
+
     std::string str;
     if (!cp.find(section, name, str)) {
         fatal("Can't unserialize '%s:%s'\n", section, name);
@@ -54,6 +54,8 @@
 #include "base/statistics.hh"
 #include "base/time.hh"
 #include "cpu/base.hh"
+#include "mem/packet.hh"
+#include "mem/request.hh"
 #include "sim/global_event.hh"
 
 using namespace std;
@@ -101,6 +103,12 @@ statFinalTick()
     return curTick();
 }
 
+uint64_t
+statPacketSlabs()
+{
+    return PacketAllocator::slabs() + PacketDataAllocator::slabs();
+}
+
 SimTicksReset simTicksReset;
 
 struct Global
@@ -110,6 +118,13 @@ struct Global
     Stats::Formula hostTickRate;
     Stats::Value hostMemory;
     Stats::Value hostSeconds;
+    Stats::Value hostRequests;
+    Stats::Value hostRequestSlabs;
+    Stats::Value hostRequestsLive;
+    Stats::Value hostPackets;
+    Stats::Value hostPacketSlabs;
+    Stats::Value hostPacketsLive;
+    Stats::Value hostPacketDataLive;
 
     Stats::Value simInsts;
     Stats::Value simOps;
@@ -187,6 +202,52 @@ Global::Global()
         .precision(2)
         ;
 
+    hostRequests
+        .functor(RequestAllocator::allocated)
+        .name("host_requests")
+        .desc("Number of memory requests allocated")
+        .prereq(hostRequests)
+        ;
+
+    hostRequestSlabs
+        .functor(RequestAllocator::slabs)
+        .name("host_request_slabs")
+        .desc("Number of host allocations made for memory requests")
+        .prereq(hostRequestSlabs)
+        ;
+
+    hostRequestsLive
+        .functor(RequestAllocator::outstanding)
+        .name("host_requests_live")
+        .desc("Number of memory requests currently allocated")
+        ;
+
+    hostPackets
+        .functor(PacketAllocator::allocated)
+        .name("host_packets")
+        .desc("Number of packets allocated")
+        .prereq(hostPackets)
+        ;
+
+    hostPacketSlabs
+        .functor(statPacketSlabs)
+        .name("host_packet_slabs")
+        .desc("Number of host allocations made for packets and their data")
+        .prereq(hostPacketSlabs)
+        ;
+
+    hostPacketsLive
+        .functor(PacketAllocator::outstanding)
+        .name("host_packets_live")
+        .desc("Number of packets currently allocated")
+        ;
+
+    hostPacketDataLive
+        .functor(PacketDataAllocator::outstanding)
+        .name("host_packet_data_live")
+        .desc("Number of pooled packet payloads currently allocated")
+        ;
+
     hostTickRate
         .name("host_tick_rate")
         .desc("Simulator tick rate (ticks/s)")
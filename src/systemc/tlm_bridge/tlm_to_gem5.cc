@@ -86,7 +86,7 @@ payload2packet(MasterID masterId, tlm::tlm_generic_payload &trans)
     }
 
     Request::Flags flags;
-    auto req = std::make_shared<Request>(
+    RequestPtr req = new Request(
         trans.get_address(), trans.get_data_length(), flags, masterId);
 
     /*
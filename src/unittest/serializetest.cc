@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Round trip of values through the serialization functions and a
+ * binary checkpoint, checking that each value comes back with its type
+ * and that numbers are stored on no more bytes than their type needs.
+ */
+
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "sim/binary_checkpoint.hh"
+#include "sim/serialize.hh"
+#include "sim/sim_object.hh"
+#include "unittest/unittest.hh"
+
+using namespace std;
+
+namespace {
+
+class NoObjects : public SimObjectResolver
+{
+  public:
+    SimObject *resolveSimObject(const string &name) override
+    {
+        return nullptr;
+    }
+};
+
+/** Object with values of most types that get serialized */
+class Values : public Serializable
+{
+  public:
+    uint8_t bytes[5] = {};
+    int16_t half = 0;
+    uint32_t word = 0;
+    uint64_t quad = 0;
+    float single = 0;
+    double ratio = 0;
+    vector<bool> flags;
+    vector<int64_t> deltas;
+    string name;
+
+    /** Half, read back into a wider type */
+    int64_t wideHalf = 0;
+
+    void
+    serialize(CheckpointOut &cp) const override
+    {
+        SERIALIZE_ARRAY(bytes, sizeof(bytes));
+        SERIALIZE_SCALAR(half);
+        SERIALIZE_SCALAR(word);
+        SERIALIZE_SCALAR(quad);
+        SERIALIZE_SCALAR(single);
+        SERIALIZE_SCALAR(ratio);
+        SERIALIZE_CONTAINER(flags);
+        SERIALIZE_CONTAINER(deltas);
+        SERIALIZE_SCALAR(name);
+    }
+
+    void
+    unserialize(CheckpointIn &cp) override
+    {
+        UNSERIALIZE_ARRAY(bytes, sizeof(bytes));
+        UNSERIALIZE_SCALAR(half);
+        UNSERIALIZE_SCALAR(word);
+        UNSERIALIZE_SCALAR(quad);
+        UNSERIALIZE_SCALAR(single);
+        UNSERIALIZE_SCALAR(ratio);
+        UNSERIALIZE_CONTAINER(flags);
+        UNSERIALIZE_CONTAINER(deltas);
+        UNSERIALIZE_SCALAR(name);
+        paramIn(cp, "half", wideHalf);
+    }
+};
+
+} // anonymous namespace
+
+int
+main()
+{
+    char dir[] = "/tmp/serializetest.XXXXXX";
+    if (!mkdtemp(dir)) {
+        cprintf("Can't create a directory for the checkpoint\n");
+        return 1;
+    }
+    const string filename = string(dir) + "/" + CheckpointIn::baseFilename;
+
+    Values out;
+    const uint8_t bytes[] = { 0, 1, 0x7f, 0x80, 0xff };
+    memcpy(out.bytes, bytes, sizeof(bytes));
+    out.half = -2;
+    out.word = 0xdeadbeef;
+    out.quad = 0x123456789abcdef0;
+    out.single = 0.5f;
+    out.ratio = 0.1;
+    out.flags = { true, false };
+    out.deltas = { -1, 1 };
+    out.name = "some text";
+    {
+        ofstream file(filename, ios::binary);
+        BinaryCheckpointWriter writer(file);
+        CheckpointOut os(&writer);
+        out.serializeSection(os, "system.cpu");
+    }
+
+    UnitTest::setCase("Widths");
+    BinaryCheckpoint cpt;
+    EXPECT_TRUE(cpt.load(filename));
+    const BinaryCheckpoint::Entry *entry = cpt.find("system.cpu", "bytes");
+    EXPECT_TRUE(entry && entry->width == 1 &&
+                entry->count == sizeof(bytes));
+    entry = cpt.find("system.cpu", "half");
+    EXPECT_TRUE(entry && entry->width == 2);
+    entry = cpt.find("system.cpu", "word");
+    EXPECT_TRUE(entry && entry->width == 4);
+    entry = cpt.find("system.cpu", "single");
+    EXPECT_TRUE(entry && entry->width == 4);
+    entry = cpt.find("system.cpu", "flags");
+    EXPECT_TRUE(entry && entry->width == 1);
+
+    UnitTest::setCase("Values");
+    Values in;
+    NoObjects resolver;
+    {
+        CheckpointIn cp(dir, resolver);
+        in.unserializeSection(cp, "system.cpu");
+
+        // numbers are also available as text
+        string text;
+        EXPECT_TRUE(cp.find("system.cpu", "bytes", text));
+        EXPECT_EQ("0 1 127 128 255", text);
+    }
+    EXPECT_TRUE(memcmp(bytes, in.bytes, sizeof(bytes)) == 0);
+    EXPECT_EQ(-2, in.half);
+    // values are sign extended when read into wider types
+    EXPECT_EQ(-2, in.wideHalf);
+    EXPECT_EQ(0xdeadbeef, in.word);
+    EXPECT_EQ(0x123456789abcdef0, in.quad);
+    EXPECT_EQ(0.5f, in.single);
+    EXPECT_EQ(0.1, in.ratio);
+    EXPECT_TRUE(in.flags == out.flags);
+    EXPECT_TRUE(in.deltas == out.deltas);
+    EXPECT_EQ("some text", in.name);
+
+    unlink(filename.c_str());
+    rmdir(dir);
+
+    return UnitTest::printResults();
+}
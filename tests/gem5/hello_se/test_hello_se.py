@@ -104,6 +104,26 @@ def verify_config(isa, binary, operating_s, cpu, hosts):
         valid_hosts=hosts,
     )
 
+def verify_partitioned_ruby_config(isa, binary, operating_s, cpu, hosts):
+    url = urlbase + isa + '/' + operating_s + '/' + binary
+    path = joinpath(base_path, isa, operating_s)
+    hello_program = DownloadedProgram(url, path, binary)
+
+    # The ruby system is split across two event queues simulated in
+    # parallel, and the system calls access the memory functionally
+    # while the controllers are simulated by the other thread.
+    gem5_verify_config(
+        name='test-' + binary + '-' + operating_s + '-' + cpu +
+             '-ruby-partitioned',
+        fixtures=(hello_program,),
+        verifiers=verifiers,
+        config=joinpath(config.base_dir, 'configs', 'example','se.py'),
+        config_args=['--cmd', joinpath(path, binary), '--cpu-type', cpu,
+            '--ruby', '--ruby-event-queues', '2'],
+        valid_isas=(isa.upper(),),
+        valid_hosts=hosts,
+    )
+
 # Run statically linked hello worlds
 for isa in static_progs:
     for binary in static_progs[isa]:
@@ -119,3 +139,8 @@ for isa in dynamic_progs:
             for cpu in cpu_types[isa]:
                verify_config(isa, binary, operating_s, cpu,
                        constants.target_host[isa.upper()])
+
+# Run a statically linked hello world on a partitioned ruby system
+for cpu in ('TimingSimpleCPU', 'DerivO3CPU'):
+    verify_partitioned_ruby_config('x86', 'hello64-static', 'linux', cpu,
+            constants.supported_hosts)
@@ -0,0 +1,104 @@
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+'''
+Restore a memory checkpoint, in which the memory only contains zeros,
+into a memory that is backed by a non-zero shared image, and check
+that the restored memory only contains zeros.
+'''
+
+from __future__ import print_function
+
+from multiprocessing import Process
+import argparse
+import os
+import sys
+
+import m5
+from m5.objects import *
+
+parser = argparse.ArgumentParser(
+    description='Checkpoint restore over a shared image')
+parser.add_argument('--format', default='gzip',
+                    help='Format of the restored memory checkpoint')
+
+args = parser.parse_args()
+
+mem_size = 16 * 1024 * 1024
+image_size = 1024 * 1024
+
+system = System(physmem = SimpleMemory(range = AddrRange(mem_size)),
+                membus = SystemXBar(),
+                clk_domain = SrcClockDomain(clock = '1GHz',
+                                            voltage_domain =
+                                            VoltageDomain()))
+system.system_port = system.membus.slave
+system.physmem.port = system.membus.master
+
+root = Root(full_system = False, system = system)
+
+outdir = m5.options.outdir
+image = os.path.join(outdir, 'image.raw')
+saved = os.path.join(outdir, 'saved.cpt')
+restored = os.path.join(outdir, 'restored.cpt')
+
+def _save():
+    system.memory_checkpoint_format = args.format
+    m5.instantiate()
+    m5.simulate(1000)
+    m5.checkpoint(saved)
+    sys.exit(0)
+
+def _restore():
+    system.physmem.shared_image = image
+    system.memory_checkpoint_format = 'raw'
+    m5.instantiate(saved)
+    m5.simulate(1000)
+    m5.checkpoint(restored)
+    sys.exit(0)
+
+with open(image, 'wb') as f:
+    f.write(b'\xaa' * image_size)
+
+for step in (_save, _restore):
+    p = Process(target=step)
+    p.start()
+    p.join()
+    if p.exitcode != 0:
+        print("Test failed: %s exited with %d" % (step.__name__, p.exitcode),
+              file=sys.stderr)
+        sys.exit(1)
+
+with open(os.path.join(restored, 'system.physmem.store0.raw'), 'rb') as f:
+    data = f.read()
+
+if len(data) != mem_size or data.count(b'\0') != mem_size:
+    print("Test failed: restored memory does not only contain zeros",
+          file=sys.stderr)
+    sys.exit(1)
+
+print("Test done.", file=sys.stderr)
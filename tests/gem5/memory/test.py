@@ -68,6 +68,15 @@ gem5_verify_config(
     valid_isas=(constants.null_tag,),
 )
 
+for fmt in ('gzip', 'chunked'):
+    gem5_verify_config(
+        name='checkpoint_image_' + fmt,
+        verifiers=(), # No need for verfiers this will return non-zero on fail
+        config=joinpath(getcwd(), 'checkpoint-image-run.py'),
+        config_args = ['--format', fmt],
+        valid_isas=(constants.null_tag,),
+    )
+
 null_tests = [
     ('garnet_synth_traffic', ['--sim-cycles', '5000000']),
     ('memcheck', ['--maxtick', '2000000000', '--prefetchers']),
@@ -0,0 +1,219 @@
+#!/usr/bin/env python
+#
+# Copyright (c) 2026 The gem5 Authors
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without
+# modification, are permitted provided that the following conditions are
+# met: redistributions of source code must retain the above copyright
+# notice, this list of conditions and the following disclaimer;
+# redistributions in binary form must reproduce the above copyright
+# notice, this list of conditions and the following disclaimer in the
+# documentation and/or other materials provided with the distribution;
+# neither the name of the copyright holders nor the names of its
+# contributors may be used to endorse or promote products derived from
+# this software without specific prior written permission.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+# "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+# LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+# A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+# OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+# SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+# LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+# DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+# THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+# OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Reader for the columnar stat files written by gem5 when using a
+# columnar:// stats URL (see src/base/stats/columnar.hh for the file
+# format).
+#
+# The file can either be imported as a module:
+#
+#   import columnar_stats
+#   stats = columnar_stats.load("m5out/stats.bin")
+#   ticks = stats.ticks
+#   insts = stats.series("system.cpu.committedInsts")
+#
+# or used as a script to list the stats of a file or print some of
+# them as comma separated values:
+#
+#   columnar_stats.py m5out/stats.bin --list
+#   columnar_stats.py m5out/stats.bin 'system.cpu*.ipc' > ipc.csv
+
+from __future__ import print_function
+
+import argparse
+import array
+import fnmatch
+import struct
+import sys
+import zlib
+
+MAGIC = b"gem5stcb"
+VERSION = 1
+
+class Segment(object):
+    """Consecutive dumps of the same set of columns"""
+
+    def __init__(self, columns):
+        self.columns = columns
+        self.index = dict((name, i) for i, name in enumerate(columns))
+        self.ticks = []
+        # Values of all the rows, one row after the other
+        self.values = array.array('d')
+
+    def __len__(self):
+        return len(self.ticks)
+
+    def _addRows(self, data, count):
+        row_size = 8 * (len(self.columns) + 1)
+        if len(data) != row_size * count:
+            raise ValueError("Malformed rows")
+
+        start = len(self.values)
+        view = memoryview(data)
+        for offset in range(0, len(data), row_size):
+            self.ticks.append(struct.unpack_from("<Q", data, offset)[0])
+            row = view[offset + 8:offset + row_size]
+            if hasattr(self.values, "frombytes"):
+                self.values.frombytes(row)
+            else:
+                self.values.fromstring(row.tobytes())
+        if sys.byteorder != "little":
+            values = self.values[start:]
+            values.byteswap()
+            self.values[start:] = values
+
+    def row(self, i):
+        width = len(self.columns)
+        return self.values[i * width:(i + 1) * width]
+
+    def column(self, name):
+        """Values of a column, or None if it isn't in this segment"""
+        i = self.index.get(name)
+        if i is None:
+            return None
+        return self.values[i::len(self.columns)]
+
+class ColumnarStats(object):
+    def __init__(self):
+        self.segments = []
+
+    @property
+    def ticks(self):
+        return [ tick for segment in self.segments for tick in segment.ticks ]
+
+    @property
+    def columns(self):
+        """Names of all the stats, in the order they first appear"""
+        seen = set()
+        names = []
+        for segment in self.segments:
+            for name in segment.columns:
+                if name not in seen:
+                    seen.add(name)
+                    names.append(name)
+        return names
+
+    def series(self, name):
+        """Values of a stat at every dump, NaN where it wasn't dumped"""
+        values = []
+        for segment in self.segments:
+            column = segment.column(name)
+            if column is None:
+                values.extend([ float("nan") ] * len(segment))
+            else:
+                values.extend(column)
+        return values
+
+    def match(self, patterns):
+        """Names of the stats matching any of a list of glob patterns"""
+        return [ name for name in self.columns
+                 if any(fnmatch.fnmatchcase(name, p) for p in patterns) ]
+
+class _Reader(object):
+    def __init__(self, data):
+        self.data = data
+        self.pos = 0
+
+    def done(self):
+        return self.pos >= len(self.data)
+
+    def take(self, size):
+        if self.pos + size > len(self.data):
+            raise ValueError("Truncated file")
+        data = self.data[self.pos:self.pos + size]
+        self.pos += size
+        return data
+
+    def unpack(self, fmt):
+        return struct.unpack(fmt, self.take(struct.calcsize(fmt)))
+
+def load(filename):
+    """Load a columnar stat file"""
+
+    with open(filename, "rb") as f:
+        reader = _Reader(f.read())
+
+    magic, version, flags = reader.unpack("<8sII")
+    if magic != MAGIC:
+        raise ValueError("%s isn't a columnar stat file" % filename)
+    if version != VERSION:
+        raise ValueError("Unsupported columnar stat file version %d" %
+                         version)
+
+    stats = ColumnarStats()
+    segment = None
+    while not reader.done():
+        record = reader.take(1)
+        if record == b"S":
+            count, = reader.unpack("<I")
+            columns = []
+            for i in range(count):
+                size, = reader.unpack("<I")
+                columns.append(reader.take(size).decode())
+            segment = Segment(columns)
+            stats.segments.append(segment)
+        elif record in (b"R", b"Z") and segment is not None:
+            if record == b"R":
+                segment._addRows(reader.take(8 * (len(segment.columns) + 1)),
+                                 1)
+            else:
+                rows, size, raw_size = reader.unpack("<IQQ")
+                data = zlib.decompress(reader.take(size))
+                if len(data) != raw_size:
+                    raise ValueError("Malformed compressed rows")
+                segment._addRows(data, rows)
+        else:
+            raise ValueError("Malformed record in %s" % filename)
+
+    return stats
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Read a gem5 columnar stat file")
+    parser.add_argument("file", help="Columnar stat file")
+    parser.add_argument("stats", nargs="*", default=[ "*" ],
+                        help="Stats to print, as glob patterns")
+    parser.add_argument("-l", "--list", action="store_true",
+                        help="List the stats in the file")
+    args = parser.parse_args()
+
+    stats = load(args.file)
+    names = stats.match(args.stats)
+    if args.list:
+        for name in names:
+            print(name)
+        return
+
+    columns = [ stats.series(name) for name in names ]
+    print(",".join([ "tick" ] + names))
+    for i, tick in enumerate(stats.ticks):
+        print(",".join([ str(tick) ] +
+                       [ repr(column[i]) for column in columns ]))
+
+if __name__ == "__main__":
+    main()
@@ -70,8 +70,8 @@
 
 from __future__ import print_function
 
-from six.moves import configparser
-import glob, types, sys, os
+from six.moves import configparser, cStringIO
+import glob, types, sys, os, re, struct
 import os.path as osp
 
 verbose_print = False
@@ -183,6 +183,107 @@ class Upgrader:
                           "nonexistent tag '{}'".format(tag, dep))
                     sys.exit(1)
 
+# Binary checkpoints (see src/sim/binary_checkpoint.hh) hold the same
+# sections and entries as ini checkpoints, with numbers stored natively.
+# They are converted to text on reading so that upgraders work on both.
+binary_magic = b'gem5cptb'
+binary_string, binary_int, binary_uint, binary_float, binary_bool = range(5)
+# struct formats of the numbers, by type and width
+binary_formats = {
+    binary_int : { 1 : 'b', 2 : 'h', 4 : 'i', 8 : 'q' },
+    binary_uint : { 1 : 'B', 2 : 'H', 4 : 'I', 8 : 'Q' },
+    binary_float : { 4 : 'f', 8 : 'd' },
+}
+
+def is_binary(path):
+    with open(path, 'rb') as f:
+        return f.read(len(binary_magic)) == binary_magic
+
+def read_binary(path):
+    with open(path, 'rb') as f:
+        data = f.read()
+
+    pos = len(binary_magic)
+    def take(size):
+        if pos + size > len(data):
+            print("fatal: truncated binary checkpoint", path)
+            exit(1)
+        return data[pos:pos + size]
+
+    lines = []
+    while pos < len(data):
+        record = take(1)
+        pos += 1
+        if record == b'S':
+            size, = struct.unpack('<I', take(4))
+            pos += 4
+            lines.append('\n[%s]' % take(size).decode())
+            pos += size
+            continue
+
+        kind, width = struct.unpack('<BB', take(2))
+        pos += 2
+        size, = struct.unpack('<I', take(4))
+        pos += 4
+        name = take(size).decode()
+        pos += size
+        count, = struct.unpack('<Q', take(8))
+        pos += 8
+
+        if kind == binary_string:
+            value = take(count).decode()
+            pos += count
+        elif kind == binary_bool:
+            value = ' '.join('true' if b else 'false'
+                             for b in bytearray(take(count)))
+            pos += count
+        else:
+            fmt = binary_formats.get(kind, {}).get(width)
+            if not fmt:
+                print("fatal: bad entry %s in binary checkpoint" % name, path)
+                exit(1)
+            values = struct.unpack('<%d%s' % (count, fmt),
+                                   take(width * count))
+            pos += width * count
+            value = ' '.join(repr(v) if kind == binary_float else str(v)
+                             for v in values)
+        lines.append('%s=%s' % (name, value))
+
+    return '\n'.join(lines) + '\n'
+
+int_re = re.compile(r'^-?[0-9]+$')
+
+def write_binary(cpt, path):
+    def name(s):
+        s = s.encode()
+        return struct.pack('<I', len(s)) + s
+
+    # Only store integers natively if they read back as the same text,
+    # the values are otherwise parsed by gem5 as they are in ini files.
+    def entry(key, value):
+        tokens = value.split()
+        if tokens and all(int_re.match(t) and str(int(t)) == t
+                          for t in tokens):
+            ints = [ int(t) for t in tokens ]
+            if min(ints) >= -2**63 and max(ints) < 2**63:
+                return b'E' + struct.pack('<BB', binary_int, 8) + \
+                    name(key) + \
+                    struct.pack('<Q%dq' % len(ints), len(ints), *ints)
+            if min(ints) >= 0 and max(ints) < 2**64:
+                return b'E' + struct.pack('<BB', binary_uint, 8) + \
+                    name(key) + \
+                    struct.pack('<Q%dQ' % len(ints), len(ints), *ints)
+        value = value.encode()
+        return b'E' + struct.pack('<BB', binary_string, 1) + name(key) + \
+            struct.pack('<Q', len(value)) + value
+
+    with open(path, 'wb') as f:
+        f.write(binary_magic)
+        for sec in cpt.sections():
+            f.write(b'S' + name(sec))
+            for key in cpt.options(sec):
+                f.write(entry(key, cpt.get(sec, key, raw=True)))
+
 def process_file(path, **kwargs):
     if not osp.isfile(path):
         import errno
@@ -200,12 +301,23 @@ def process_file(path, **kwargs):
     cpt.optionxform = str
 
     # Read the current data
-    cpt_file = file(path, 'r')
-    cpt.readfp(cpt_file)
-    cpt_file.close()
+    binary = is_binary(path)
+    if binary:
+        cpt.readfp(cStringIO(read_binary(path)))
+    else:
+        cpt_file = open(path, 'r')
+        cpt.readfp(cpt_file)
+        cpt_file.close()
 
     change = False
 
+    # Convert between the ini and binary formats if asked to
+    cpt_format = kwargs.get('format')
+    if cpt_format and (cpt_format == 'binary') != binary:
+        binary = cpt_format == 'binary'
+        verboseprint("converting to", cpt_format)
+        change = True
+
     # Make sure we know what we're starting from
     if cpt.has_option('root','cpt_ver'):
         cpt_ver = cpt.getint('root','cpt_ver')
@@ -258,7 +370,10 @@ def process_file(path, **kwargs):
 
     # Write the old data back
     verboseprint("...completed")
-    cpt.write(file(path, 'w'))
+    if binary:
+        write_binary(cpt, path)
+    else:
+        cpt.write(open(path, 'w'))
 
 if __name__ == '__main__':
     from optparse import OptionParser, SUPPRESS_HELP
@@ -271,6 +386,10 @@ if __name__ == '__main__':
                       help="Do no backup each checkpoint before modifying it")
     parser.add_option("-v", "--verbose", action="store_true",
                       help="Print out debugging information as")
+    parser.add_option("-f", "--format", type="choice",
+                      choices=["ini", "binary"],
+                      help="Convert each checkpoint to the given format "\
+                           "(ini or binary)")
     parser.add_option("--get-cc-file", action="store_true",
                       # used during build; generate src/sim/tags.cc and exit
                       help=SUPPRESS_HELP)
@@ -0,0 +1,396 @@
+/*
+ * Copyright (c) 2026 The gem5 Authors
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met: redistributions of source code must retain the above copyright
+ * notice, this list of conditions and the following disclaimer;
+ * redistributions in binary form must reproduce the above copyright
+ * notice, this list of conditions and the following disclaimer in the
+ * documentation and/or other materials provided with the distribution;
+ * neither the name of the copyright holders nor the names of its
+ * contributors may be used to endorse or promote products derived from
+ * this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS
+ * "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT
+ * LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR
+ * A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT
+ * OWNER OR CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+ * SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT
+ * LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE,
+ * DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY
+ * THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ * (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+/*
+ * Decoder of the binary trace files written by gem5 with
+ * --debug-binary, outputting the same text the debug messages would
+ * have had. The arguments of each message are formatted with gem5's
+ * own cprintf, with their original types.
+ */
+
+#include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+
+#include "base/cprintf.hh"
+
+using namespace std;
+
+namespace {
+
+const char magic[8] = { 'g', 'e', 'm', '5', 't', 'r', 'c', 'b' };
+const uint32_t version = 1;
+const uint64_t maxTick = ~(uint64_t)0;
+
+/** Argument types, as in Trace::BinaryTraceWriter::ArgType */
+enum ArgType
+{
+    Bool = 0,
+    Char = 1,
+    SignedChar = 2,
+    UnsignedChar = 3,
+    Short = 4,
+    UnsignedShort = 5,
+    Int = 6,
+    UnsignedInt = 7,
+    Long = 8,
+    UnsignedLong = 9,
+    LongLong = 10,
+    UnsignedLongLong = 11,
+    Float = 12,
+    Double = 13,
+    String = 14,
+    Pointer = 15,
+    Text = 16,
+};
+
+/**
+ * Argument that was formatted when it was logged, and is output as
+ * is whatever the conversion.
+ */
+struct Formatted
+{
+    string text;
+};
+
+void
+format_char(ostream &out, const Formatted &data, cp::Format &fmt)
+{
+    out << data.text;
+}
+
+void
+format_integer(ostream &out, const Formatted &data, cp::Format &fmt)
+{
+    out << data.text;
+}
+
+void
+format_float(ostream &out, const Formatted &data, cp::Format &fmt)
+{
+    out << data.text;
+}
+
+void
+format_string(ostream &out, const Formatted &data, cp::Format &fmt)
+{
+    out << data.text;
+}
+
+bool showTicks = true;
+bool showFlags = false;
+
+/** Stream of records of a thread, which may span several chunks */
+struct ThreadStream
+{
+    string pending;
+    unordered_map<uint32_t, string> strings;
+};
+
+/** Cursor over the pending bytes of a thread */
+class Cursor
+{
+  private:
+    const string &bytes;
+    size_t pos;
+
+  public:
+    Cursor(const string &_bytes) : bytes(_bytes), pos(0) {}
+
+    size_t offset() const { return pos; }
+
+    template <class T>
+    bool
+    read(T &value)
+    {
+        if (bytes.size() - pos < sizeof(value))
+            return false;
+        // the files are little endian, as are the hosts gem5 runs on
+        memcpy(&value, bytes.data() + pos, sizeof(value));
+        pos += sizeof(value);
+        return true;
+    }
+
+    bool
+    read(string &s, uint32_t size)
+    {
+        if (bytes.size() - pos < size)
+            return false;
+        s.assign(bytes, pos, size);
+        pos += size;
+        return true;
+    }
+
+    bool
+    readString(string &s)
+    {
+        uint32_t size;
+        return read(size) && read(s, size);
+    }
+};
+
+/** Output a message the way Trace::OstreamLogger does */
+void
+logMessage(uint64_t when, const string &name, const string &flag,
+           const string &message)
+{
+    if (showTicks && when != maxTick)
+        ccprintf(cout, "%7d: ", when);
+    if (showFlags && !flag.empty())
+        cout << flag << ": ";
+    if (!name.empty())
+        cout << name << ": ";
+    cout << message;
+}
+
+/** Output a data dump the way Trace::Logger::dump does */
+void
+dump(uint64_t when, const string &name, const string &flag,
+     const string &data)
+{
+    const int len = data.size();
+    int c, i, j;
+
+    for (i = 0; i < len; i += 16) {
+        ostringstream line;
+
+        ccprintf(line, "%08x  ", i);
+        c = len - i;
+        if (c > 16) c = 16;
+
+        for (j = 0; j < c; j++) {
+            ccprintf(line, "%02x ", data[i + j] & 0xff);
+            if ((j & 0xf) == 7 && j > 0)
+                ccprintf(line, " ");
+        }
+
+        for (; j < 16; j++)
+            ccprintf(line, "   ");
+        ccprintf(line, "  ");
+
+        for (j = 0; j < c; j++) {
+            int ch = data[i + j] & 0x7f;
+            ccprintf(line, "%c", (char)(isprint(ch) ? ch : ' '));
+        }
+
+        ccprintf(line, "\n");
+        logMessage(when, name, flag, line.str());
+
+        if (c < 16)
+            break;
+    }
+}
+
+/** Read an argument of a message and pass it on to cprintf */
+bool
+addArg(Cursor &cursor, cp::Print &print)
+{
+    uint8_t type;
+    if (!cursor.read(type))
+        return false;
+
+    if (type == String || type == Text) {
+        string s;
+        if (!cursor.readString(s))
+            return false;
+        if (type == Text)
+            print.add_arg(Formatted{s});
+        else
+            print.add_arg(s);
+        return true;
+    }
+
+    uint64_t value;
+    if (!cursor.read(value))
+        return false;
+
+    double d;
+    memcpy(&d, &value, sizeof(d));
+
+    switch (type) {
+      case Bool: print.add_arg((bool)value); break;
+      case Char: print.add_arg((char)value); break;
+      case SignedChar: print.add_arg((signed char)value); break;
+      case UnsignedChar: print.add_arg((unsigned char)value); break;
+      case Short: print.add_arg((short)value); break;
+      case UnsignedShort: print.add_arg((unsigned short)value); break;
+      case Int: print.add_arg((int)value); break;
+      case UnsignedInt: print.add_arg((unsigned int)value); break;
+      case Long: print.add_arg((long)value); break;
+      case UnsignedLong: print.add_arg((unsigned long)value); break;
+      case LongLong: print.add_arg((long long)value); break;
+      case UnsignedLongLong:
+        print.add_arg((unsigned long long)value);
+        break;
+      case Float: print.add_arg((float)d); break;
+      case Double: print.add_arg(d); break;
+      case Pointer: print.add_arg((const void *)(uintptr_t)value); break;
+      default:
+        cerr << "unknown argument type " << (int)type << endl;
+        exit(1);
+    }
+    return true;
+}
+
+/**
+ * Decode the records of a thread, leaving any incomplete one until
+ * more bytes are available.
+ */
+void
+decode(ThreadStream &thread)
+{
+    size_t done = 0;
+    Cursor cursor(thread.pending);
+
+    while (true) {
+        uint8_t record;
+        if (!cursor.read(record))
+            break;
+
+        if (record == 'N') {
+            uint32_t id;
+            string s;
+            if (!cursor.read(id) || !cursor.readString(s))
+                break;
+            thread.strings[id] = s;
+        } else if (record == 'M' || record == 'D') {
+            uint64_t when;
+            uint32_t flag, name, fmt_or_size;
+            if (!cursor.read(when) || !cursor.read(flag) ||
+                !cursor.read(name) || !cursor.read(fmt_or_size)) {
+                break;
+            }
+
+            if (record == 'D') {
+                string data;
+                if (!cursor.read(data, fmt_or_size))
+                    break;
+                dump(when, thread.strings[name], thread.strings[flag],
+                     data);
+            } else {
+                uint8_t nargs;
+                if (!cursor.read(nargs))
+                    break;
+                ostringstream message;
+                cp::Print print(message, thread.strings[fmt_or_size]);
+                bool complete = true;
+                for (int i = 0; i < nargs && complete; ++i)
+                    complete = addArg(cursor, print);
+                if (!complete)
+                    break;
+                print.end_args();
+                logMessage(when, thread.strings[name],
+                           thread.strings[flag], message.str());
+            }
+        } else if (record == 'T') {
+            string text;
+            if (!cursor.readString(text))
+                break;
+            cout << text;
+        } else {
+            cerr << "unknown record type " << (int)record << endl;
+            exit(1);
+        }
+        done = cursor.offset();
+    }
+
+    thread.pending.erase(0, done);
+}
+
+} // anonymous namespace
+
+int
+usage(const char *prog)
+{
+    cerr << "usage: " << prog << " [--flags] [--no-ticks] TRACE\n"
+         << "  --flags     output the flag of each message, as "
+            "with the FmtFlag debug flag\n"
+         << "  --no-ticks  don't output the ticks, as with the "
+            "FmtTicksOff debug flag\n";
+    return 2;
+}
+
+int
+main(int argc, char *argv[])
+{
+    const char *filename = nullptr;
+    for (int i = 1; i < argc; ++i) {
+        if (!strcmp(argv[i], "--flags"))
+            showFlags = true;
+        else if (!strcmp(argv[i], "--no-ticks"))
+            showTicks = false;
+        else if (argv[i][0] != '-' && !filename)
+            filename = argv[i];
+        else
+            return usage(argv[0]);
+    }
+
+    if (!filename)
+        return usage(argv[0]);
+
+    ifstream file(filename, ios::binary);
+    char file_magic[sizeof(magic)];
+    uint32_t file_version;
+    if (!file.read(file_magic, sizeof(file_magic)) ||
+        memcmp(file_magic, magic, sizeof(magic)) != 0 ||
+        !file.read((char *)&file_version, sizeof(file_version))) {
+        cerr << filename << ": not a binary trace" << endl;
+        return 1;
+    }
+    if (file_version != version) {
+        cerr << filename << ": unsupported version " << file_version << endl;
+        return 1;
+    }
+
+    map<uint32_t, ThreadStream> threads;
+    uint32_t header[2];
+    while (file.read((char *)header, sizeof(header))) {
+        ThreadStream &thread = threads[header[0]];
+        const size_t old_size = thread.pending.size();
+        thread.pending.resize(old_size + header[1]);
+        if (!file.read(&thread.pending[old_size], header[1])) {
+            cerr << filename << ": truncated chunk" << endl;
+            return 1;
+        }
+        decode(thread);
+    }
+
+    for (auto &thread : threads) {
+        if (!thread.second.pending.empty())
+            cerr << "thread " << thread.first << ": incomplete record at "
+                 "the end of the trace" << endl;
+    }
+
+    return 0;
+}